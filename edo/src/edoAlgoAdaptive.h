@@ -28,10 +28,21 @@ Authors:
 #ifndef _edoAlgoAdaptive_h
 #define _edoAlgoAdaptive_h
 
+#include <algorithm>
+#include <vector>
+
 #include <eo>
 
 #include <utils/eoRNG.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#if __cplusplus >= 201103L
+#include <exception>
+#endif
+
 #include "edoAlgo.h"
 #include "edoEstimator.h"
 #include "edoModifierMass.h"
@@ -49,6 +60,18 @@ Authors:
  * If you no operator needs to update the distribution, then it is simpler to use an
  * edoAlgoStateless .
  *
+ * The new solutions are drawn all at once with the batched operator of the
+ * sampler (which repairs them too, see edoSampler), into a population that is
+ * kept from one generation to the next. If a block size is given, they are
+ * drawn and evaluated block by block instead: while a block is evaluated by
+ * the calling thread, the next one is sampled by another thread, with its
+ * own random generator (see eo::threadRng), which pays off when the
+ * evaluation is costly but does not use the threads itself (external
+ * processes, see eoExternalPopEval, or a sequential eoPopLoopEval). The
+ * evaluator is then called on each block, it must not need the whole
+ * offspring at once. Without OpenMP or C++11, the blocks are sampled and
+ * evaluated in turn.
+ *
  * @ingroup Algorithms
  */
 template < typename D >
@@ -77,6 +100,7 @@ public:
       \param replacor Replace old solutions by new ones
       \param pop_continuator Stopping criterion based on the population features
       \param distribution_continuator Stopping criterion based on the distribution features
+      \param block_size Number of solutions sampled while the previous ones are evaluated, 0 for no pipeline
     */
     edoAlgoAdaptive(
         D & distrib,
@@ -86,7 +110,8 @@ public:
         edoSampler< D > & sampler,
         eoReplacement< EOType > & replacor,
         eoContinue< EOType > & pop_continuator,
-        edoContinue< D > & distribution_continuator
+        edoContinue< D > & distribution_continuator,
+        unsigned int block_size = 0
     ) :
         _distrib(distrib),
         _evaluator(evaluator),
@@ -96,7 +121,8 @@ public:
         _replacor(replacor),
         _pop_continuator(pop_continuator),
         _dummy_continue(),
-        _distribution_continuator(distribution_continuator)
+        _distribution_continuator(distribution_continuator),
+        _block_size(block_size)
     {}
 
 
@@ -111,6 +137,7 @@ public:
       \param sampler Generate feasible solutions using the distribution
       \param replacor Replace old solutions by new ones
       \param pop_continuator Stopping criterion based on the population features
+      \param block_size Number of solutions sampled while the previous ones are evaluated, 0 for no pipeline
     */
     edoAlgoAdaptive (
         D & distrib,
@@ -119,7 +146,8 @@ public:
         edoEstimator< D > & estimator,
         edoSampler< D > & sampler,
         eoReplacement< EOType > & replacor,
-        eoContinue< EOType > & pop_continuator
+        eoContinue< EOType > & pop_continuator,
+        unsigned int block_size = 0
     ) :
         _distrib( distrib ),
         _evaluator(evaluator),
@@ -129,7 +157,8 @@ public:
         _replacor(replacor),
         _pop_continuator(pop_continuator),
         _dummy_continue(),
-        _distribution_continuator( _dummy_continue )
+        _distribution_continuator( _dummy_continue ),
+        _block_size(block_size)
     {}
 
     /** Call the algorithm
@@ -160,17 +189,16 @@ public:
             // (2) Estimation of the distribution parameters
             _distrib = _estimator(selected_pop);
 
-            // (3) sampling
+            // (3) sampling and (4) evaluation of the new solutions
             // The sampler produces feasible solutions (@see edoSampler that
             // encapsulate an edoBounder)
-            current_pop.clear();
-            for( unsigned int i = 0; i < pop.size(); ++i ) {
-                current_pop.push_back( _sampler(_distrib) );
+            if( _block_size == 0 || _block_size >= pop.size() ) {
+                _sampler( _distrib, pop.size(), current_pop );
+                _evaluator( pop, current_pop );
+            } else {
+                sample_and_evaluate( pop, current_pop );
             }
 
-            // (4) Evaluate new solutions
-            _evaluator( pop, current_pop );
-
             // (5) Replace old solutions by new ones
             _replacor(pop, current_pop); // e.g. copy current_pop in pop
 
@@ -180,6 +208,68 @@ public:
 
 protected:
 
+    /** Samples and evaluates the offspring block by block, the sampling of
+     * the next block overlapping the evaluation of the current one
+     */
+    void sample_and_evaluate( eoPop< EOType > & pop, eoPop< EOType > & offspring )
+    {
+        unsigned int n = pop.size();
+        offspring.resize( n );
+
+        // the first block is sampled by the calling thread, which also
+        // updates the caches of the sampler for the new distribution
+        _sampler( _distrib, std::min( _block_size, n ), _next_block );
+
+#if defined(_OPENMP) && __cplusplus >= 201103L
+        // the sampling thread draws from its own stream
+        eo::rngPool.reserve( 2 );
+#endif
+
+        for( unsigned int start = 0; start < n; start += _block.size() ) {
+            _block.swap( _next_block );
+            unsigned int next_start = start + _block.size();
+            unsigned int next_size = std::min( _block_size, n - next_start );
+
+#if defined(_OPENMP) && __cplusplus >= 201103L
+            // an exception can not leave the parallel region, it is thrown again after it
+            std::exception_ptr errors[2];
+#pragma omp parallel num_threads(2) if(next_size > 0)
+            {
+                int thread = omp_get_thread_num();
+                int threads = omp_get_num_threads();
+                if( thread == 0 ) {
+                    try {
+                        _evaluator( pop, _block );
+                    } catch( ... ) {
+                        errors[0] = std::current_exception();
+                    }
+                }
+                if( thread == threads - 1 && next_size > 0 ) {
+                    try {
+                        _sampler( _distrib, next_size, _next_block );
+                    } catch( ... ) {
+                        errors[1] = std::current_exception();
+                    }
+                }
+            }
+            for( unsigned int e = 0; e < 2; ++e ) {
+                if( errors[e] ) {
+                    std::rethrow_exception( errors[e] );
+                }
+            }
+#else
+            _evaluator( pop, _block );
+            if( next_size > 0 ) {
+                _sampler( _distrib, next_size, _next_block );
+            }
+#endif
+
+            for( unsigned int i = 0; i < _block.size(); ++i ) {
+                eoPop< EOType >::transfer( offspring[start + i], _block[i] );
+            }
+        }
+    }
+
     //! The distribution that you want to update
     D & _distrib;
 
@@ -207,6 +297,13 @@ protected:
     //! A D continuator
     edoContinue<D> & _distribution_continuator;
 
+    //! Number of solutions sampled and evaluated at once, 0 for the whole population
+    unsigned int _block_size;
+
+    //! The block being evaluated, and the next one, kept between generations
+    eoPop<EOType> _block;
+    eoPop<EOType> _next_block;
+
 };
 
 #endif // !_edoAlgoAdaptive_h
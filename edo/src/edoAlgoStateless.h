@@ -61,6 +61,7 @@ public:
       \param replacor Replace old solutions by new ones
       \param pop_continuator Stopping criterion based on the population features
       \param distribution_continuator Stopping criterion based on the distribution features
+      \param block_size Number of solutions sampled while the previous ones are evaluated, 0 for no pipeline (see edoAlgoAdaptive)
     */
     edoAlgoStateless(
         eoPopEvalFunc < EOType > & evaluator,
@@ -69,9 +70,10 @@ public:
         edoSampler< D > & sampler,
         eoReplacement< EOType > & replacor,
         eoContinue< EOType > & pop_continuator,
-        edoContinue< D > & distribution_continuator
+        edoContinue< D > & distribution_continuator,
+        unsigned int block_size = 0
     ) :
-        edoAlgoAdaptive<D>( *(new D), evaluator, selector, estimator, sampler, replacor, pop_continuator, distribution_continuator)
+        edoAlgoAdaptive<D>( *(new D), evaluator, selector, estimator, sampler, replacor, pop_continuator, distribution_continuator, block_size)
     {}
 
     /** Constructor without an edoContinue
@@ -82,6 +84,7 @@ public:
       \param sampler Generate feasible solutions using the distribution
       \param replacor Replace old solutions by new ones
       \param pop_continuator Stopping criterion based on the population features
+      \param block_size Number of solutions sampled while the previous ones are evaluated, 0 for no pipeline (see edoAlgoAdaptive)
     */
     edoAlgoStateless (
         eoPopEvalFunc < EOType > & evaluator,
@@ -89,9 +92,10 @@ public:
         edoEstimator< D > & estimator,
         edoSampler< D > & sampler,
         eoReplacement< EOType > & replacor,
-        eoContinue< EOType > & pop_continuator
+        eoContinue< EOType > & pop_continuator,
+        unsigned int block_size = 0
     ) :
-        edoAlgoAdaptive<D>( *(new D), evaluator, selector, estimator, sampler, replacor, pop_continuator)
+        edoAlgoAdaptive<D>( *(new D), evaluator, selector, estimator, sampler, replacor, pop_continuator, block_size)
     {}
 
     ~edoAlgoStateless()
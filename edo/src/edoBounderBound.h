@@ -61,6 +61,8 @@ public:
             }
         }
     }
+
+    bool stochastic() const { return false; }
 };
 
 #endif // !_edoBounderBound_h
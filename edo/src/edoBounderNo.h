@@ -39,6 +39,8 @@ class edoBounderNo : public edoBounder< EOT >
 {
 public:
     void operator()( EOT& ) {}
+
+    bool stochastic() const { return false; }
 };
 
 #endif // !_edoBounderNo_h
@@ -58,8 +58,8 @@ public:
         for (unsigned int d = 0; d < size; ++d) {
 
             if ( sol[d] < this->min()[d] || sol[d] > this->max()[d]) {
-                // use EO's global "rng"
-                sol[d] = rng.uniform( this->min()[d], this->max()[d] );
+                // use the generator of the calling thread, see eo::threadRng
+                sol[d] = eo::threadRng().uniform( this->min()[d], this->max()[d] );
             }
         } // for d in size
         
@@ -71,6 +71,25 @@ namespace ublas = boost::numeric::ublas;
 template < typename EOT >
 class edoNormalMulti : public edoDistrib< EOT >
 {
+public:
+    /** Identifier of the parameters of the distribution.
+     *
+     * Every newly built distribution gets a new version, while copies share
+     * the version of their source. As the parameters cannot be changed
+     * otherwise, samplers may use it to cache what they compute from the
+     * covariance matrix.
+     */
+    unsigned long version() const {return _version;}
+
+private:
+    static unsigned long next_version()
+    {
+        static unsigned long last = 0;
+        return ++last;
+    }
+
+    unsigned long _version;
+
 #ifdef WITH_BOOST
 
 
@@ -78,6 +97,7 @@ public:
     typedef typename EOT::AtomType AtomType;
 
     edoNormalMulti( unsigned int dim = 1 ) :
+        _version( next_version() ),
             _mean( const ublas::vector<AtomType>(0,dim)        ),
         _varcovar( const ublas::identity_matrix<AtomType>(dim) )
     {
@@ -91,7 +111,7 @@ public:
      const ublas::vector< AtomType >& mean,
      const ublas::symmetric_matrix< AtomType, ublas::lower >& varcovar
      )
-        : _mean(mean), _varcovar(varcovar)
+        : _version( next_version() ), _mean(mean), _varcovar(varcovar)
     {
         assert(_mean.size() > 0);
         assert(_mean.size() == _varcovar.size1());
@@ -122,6 +142,7 @@ public:
     typedef Eigen::Matrix< AtomType, Eigen::Dynamic, Eigen::Dynamic> Matrix;
 
     edoNormalMulti( unsigned int dim = 1 ) :
+        _version( next_version() ),
             _mean( Vector::Zero(dim) ),
         _varcovar( Matrix::Identity(dim,dim) )
     {
@@ -134,7 +155,7 @@ public:
         const Vector & mean,
         const Matrix & varcovar
     )
-        : _mean(mean), _varcovar(varcovar)
+        : _version( next_version() ), _mean(mean), _varcovar(varcovar)
     {
         assert(_mean.innerSize() > 0);
         assert(_mean.innerSize() == _varcovar.innerSize());
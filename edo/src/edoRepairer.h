@@ -50,6 +50,15 @@ class edoRepairer : public eoUF< EOT&, void >
 public:
     // virtual void operator()( EOT& ) = 0 (provided by eoUF< A1, R >)
     virtual void operator()( EOT& ) {}
+
+    /** Tells if the repairer draws random numbers
+     *
+     * The samplers then repair each solution as soon as it is drawn, so that
+     * the random stream does not depend on whether the solutions are sampled
+     * one by one or by batches (@see edoSampler). As a repairer can use the
+     * random generators without saying so, this is the default.
+     */
+    virtual bool stochastic() const { return true; }
 };
 
 #endif // !_edoRepairer_h
@@ -41,6 +41,9 @@ class edoRepairerApply : public edoRepairer<EOT>
 public:
     edoRepairerApply( F function ) : _function(function) {}
 
+    //! The function applied is expected to be a deterministic one (floor, fmod, ...)
+    virtual bool stochastic() const { return false; }
+
 protected:
     F * _function;
 };
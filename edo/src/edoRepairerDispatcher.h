@@ -179,6 +179,17 @@ public:
 
         sol.invalidate();
     }
+
+    //! Stochastic as soon as one of the repairers is
+    virtual bool stochastic() const
+    {
+        for( typename edoRepairerDispatcher<EOT>::const_iterator ipair = this->begin(); ipair != this->end(); ++ipair ) {
+            if( ipair->second->stochastic() ) {
+                return true;
+            }
+        }
+        return false;
+    }
 };
 
 #endif // !_edoRepairerDispatcher_h
@@ -28,6 +28,8 @@ Authors:
 #ifndef _edoSampler_h
 #define _edoSampler_h
 
+#include <vector>
+
 #include <eoFunctor.h>
 
 #include "edoRepairer.h"
@@ -85,10 +87,66 @@ public:
         return solution;
     }
 
+    /** Sample and repair n solutions at once
+     *
+     * The previous content of solutions is lost. The solutions are the ones
+     * that n calls to operator()(D&) would give: if the repairer draws random
+     * numbers (see edoRepairer::stochastic), each solution is repaired as
+     * soon as it is sampled, without the batched sample.
+     */
+    void operator()( D& distrib, unsigned int n, std::vector< EOType >& solutions )
+    {
+        assert( distrib.size() > 0 );
+
+        if( _repairer.stochastic() ) {
+            solutions.resize( n );
+            for( unsigned int i = 0; i < n; ++i ) {
+                solutions[i] = sample( distrib );
+                _repairer( solutions[i] );
+            }
+            return;
+        }
+
+        sample( distrib, n, solutions );
+        assert( solutions.size() == n );
+
+        for( unsigned int i = 0; i < n; ++i ) {
+            _repairer( solutions[i] );
+        }
+    }
+
 protected:
 
     virtual EOType sample( D& ) = 0;
 
+    /** Draw n solutions at once
+     *
+     * Samplers that can share computations between solutions should
+     * overload this; the default simply calls sample(D&) n times.
+     */
+    virtual void sample( D& distrib, unsigned int n, std::vector< EOType >& solutions )
+    {
+        solutions.clear();
+        solutions.reserve( n );
+        for( unsigned int i = 0; i < n; ++i ) {
+            solutions.push_back( sample( distrib ) );
+        }
+    }
+
+    /** Make n solutions of the given size, for a batched sample to fill in
+     *
+     * The solutions already in the vector (e.g. a population sampled at the
+     * previous generation) keep their storage, and are invalidated.
+     */
+    void fill_solutions( unsigned int n, unsigned int size, std::vector< EOType >& solutions )
+    {
+        solutions.resize( n );
+        for( unsigned int i = 0; i < n; ++i ) {
+            solutions[i].resize( size );
+            solutions[i].invalidate();
+        }
+    }
+
 private:
     edoBounderNo<EOType> _dummy_repairer;
 
@@ -63,8 +63,9 @@ public:
 
         // T = vector of size elements drawn in N(0,1)
         Vector T( N );
+        eoRng& gen = eo::threadRng();
         for ( unsigned int i = 0; i < N; ++i ) {
-            T( i ) = rng.normal();
+            T( i ) = gen.normal();
         }
         assert(T.innerSize() == N );
         assert(T.outerSize() == 1);
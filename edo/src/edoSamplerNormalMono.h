@@ -60,11 +60,12 @@ public:
         EOT solution;
         
         // Sampling all dimensions
+        eoRng& gen = eo::threadRng();
         for (unsigned int i = 0; i < size; ++i) {
             AtomType mean = distrib.mean()[i];
             AtomType variance = distrib.variance()[i];
             // should use the standard deviation, which have the same scale than the mean
-            AtomType random = rng.normal(mean, sqrt(variance) );
+            AtomType random = gen.normal(mean, sqrt(variance) );
 
             solution.push_back(random);
         }
@@ -53,6 +53,12 @@ namespace ublas = boost::numeric::ublas;
  *   - compute the Cholesky decomposition L of V (i.e. such as V=LL*)
  *   - return X = M + LT
  *
+ * The decomposition is only computed when the sampler meets a new
+ * distribution (see edoNormalMulti::version), and not for every sample.
+ * When several solutions are sampled at once, the draws are gathered in a
+ * matrix and multiplied by L in a single matrix product; the result is the
+ * same as sampling them one by one.
+ *
  * Exists in two implementations, using either
  * <a href="http://www.boost.org/doc/libs/1_50_0/libs/numeric/ublas/doc/index.htm">Boost::uBLAS</a> (if compiled WITH_BOOST)
  * or <a href="http://eigen.tuxfamily.org">Eigen3</a> (WITH_EIGEN).
@@ -69,9 +75,10 @@ class edoSamplerNormalMulti : public edoSampler< D >
 
 public:
     typedef typename EOT::AtomType AtomType;
+    typedef typename cholesky::CholeskyBase<AtomType>::FactorMat FactorMat;
 
     edoSamplerNormalMulti( edoRepairer<EOT> & repairer ) 
-        : edoSampler< D >( repairer)
+        : edoSampler< D >( repairer), _version(0)
     {}
 
 
@@ -81,12 +88,13 @@ public:
         assert(size > 0);
 
         // L = cholesky decomposition of varcovar
-        const typename cholesky::CholeskyBase<AtomType>::FactorMat& L = _cholesky( distrib.varcovar() );
+        const FactorMat& L = factor( distrib );
 
         // T = vector of size elements drawn in N(0,1)
         ublas::vector< AtomType > T( size );
+        eoRng& gen = eo::threadRng();
         for ( unsigned int i = 0; i < size; ++i ) {
-            T( i ) = rng.normal();
+            T( i ) = gen.normal();
         }
 
         // LT = L * T
@@ -101,9 +109,51 @@ public:
         return solution;
     }
 
+    void sample( D& distrib, unsigned int n, std::vector< EOT >& solutions )
+    {
+        unsigned int size = distrib.size();
+        assert(size > 0);
+
+        const FactorMat& L = factor( distrib );
+
+        // T = size*n matrix drawn in N(0,1), one column per solution
+        ublas::matrix< AtomType > T( size, n );
+        eoRng& gen = eo::threadRng();
+        for ( unsigned int j = 0; j < n; ++j ) {
+            for ( unsigned int i = 0; i < size; ++i ) {
+                T( i, j ) = gen.normal();
+            }
+        }
+
+        // LT = L * T
+        ublas::matrix< AtomType > LT = ublas::prod( L, T );
+
+        // solution j = means + column j of LT
+        ublas::vector< AtomType > mean = distrib.mean();
+        this->fill_solutions( n, size, solutions );
+        for ( unsigned int j = 0; j < n; ++j ) {
+            for ( unsigned int i = 0; i < size; ++i ) {
+                solutions[j][i] = mean( i ) + LT( i, j );
+            }
+        }
+    }
+
 protected:
+    //! Cholesky decomposition of the covariance matrix of distrib, computed once per distribution
+    const FactorMat& factor( D& distrib )
+    {
+        if( distrib.version() != _version ) {
+            _cholesky.factorize( distrib.varcovar() );
+            _version = distrib.version();
+        }
+        return _cholesky.decomposition();
+    }
+
     cholesky::CholeskyLLT<AtomType> _cholesky;
 
+    //! Version of the distribution that has been factorized, 0 if none
+    unsigned long _version;
+
 #else
 #ifdef WITH_EIGEN
 
@@ -114,7 +164,7 @@ public:
     typedef typename D::Matrix Matrix;
 
     edoSamplerNormalMulti( edoRepairer<EOT> & repairer ) 
-        : edoSampler< D >( repairer)
+        : edoSampler< D >( repairer), _version(0)
     {}
 
 
@@ -124,33 +174,13 @@ public:
         assert(size > 0);
 
         // LsD = cholesky decomposition of varcovar
-
-        // Computes L and mD such as V = L mD L^T
-        Eigen::LDLT<Matrix> cholesky( distrib.varcovar() );
-        Matrix L = cholesky.matrixL();
-        assert(L.innerSize() == size);
-        assert(L.outerSize() == size);
-
-        Matrix mD = cholesky.vectorD().asDiagonal();
-        assert(mD.innerSize() == size);
-        assert(mD.outerSize() == size);
-
-        // now compute the final symetric matrix: LsD = L mD^1/2
-        // remember that V = ( L mD^1/2) ( L mD^1/2)^T
-        // fortunately, the square root of a diagonal matrix is the square 
-        // root of all its elements
-        Matrix sqrtD = mD.cwiseSqrt();
-        assert(sqrtD.innerSize() == size);
-        assert(sqrtD.outerSize() == size);
-
-        Matrix LsD = L * sqrtD;
-        assert(LsD.innerSize() == size);
-        assert(LsD.outerSize() == size);
+        const Matrix& LsD = factor( distrib );
 
         // T = vector of size elements drawn in N(0,1)
         Vector T( size );
+        eoRng& gen = eo::threadRng();
         for ( unsigned int i = 0; i < size; ++i ) {
-            T( i ) = rng.normal();
+            T( i ) = gen.normal();
         }
         assert(T.innerSize() == size);
         assert(T.outerSize() == 1);
@@ -178,6 +208,75 @@ public:
 
         return solution;
     }
+
+    void sample( D& distrib, unsigned int n, std::vector< EOT >& solutions )
+    {
+        unsigned int size = distrib.size();
+        assert(size > 0);
+
+        const Matrix& LsD = factor( distrib );
+
+        // T = size*n matrix drawn in N(0,1), one column per solution
+        Matrix T( size, n );
+        eoRng& gen = eo::threadRng();
+        for ( unsigned int j = 0; j < n; ++j ) {
+            for ( unsigned int i = 0; i < size; ++i ) {
+                T( i, j ) = gen.normal();
+            }
+        }
+
+        // X = means + (L mD^1/2) * T, in a single matrix product
+        Matrix X = LsD * T;
+        X.colwise() += distrib.mean();
+        assert(X.innerSize() == size);
+        assert(X.outerSize() == n);
+
+        this->fill_solutions( n, size, solutions );
+        for ( unsigned int j = 0; j < n; ++j ) {
+            for ( unsigned int i = 0; i < size; ++i ) {
+                solutions[j][i] = X( i, j );
+            }
+        }
+    }
+
+protected:
+    /** Computes LsD such as V = LsD LsD^T, once per distribution
+     */
+    const Matrix& factor( D& distrib )
+    {
+        if( distrib.version() == _version ) {
+            return _LsD;
+        }
+
+        unsigned int size = distrib.size();
+
+        // Computes L and mD such as V = L mD L^T
+        Eigen::LDLT<Matrix> cholesky( distrib.varcovar() );
+        Matrix L = cholesky.matrixL();
+        assert(L.innerSize() == size);
+        assert(L.outerSize() == size);
+
+        // now compute the final symetric matrix: LsD = L mD^1/2
+        // remember that V = ( L mD^1/2) ( L mD^1/2)^T
+        // fortunately, the square root of a diagonal matrix is the square 
+        // root of all its elements
+        Vector sqrtD = cholesky.vectorD().cwiseSqrt();
+        assert(sqrtD.innerSize() == size);
+
+        _LsD = L * sqrtD.asDiagonal();
+        assert(_LsD.innerSize() == size);
+        assert(_LsD.outerSize() == size);
+
+        _version = distrib.version();
+        return _LsD;
+    }
+
+    //! Cached decomposition of the covariance matrix
+    Matrix _LsD;
+
+    //! Version of the distribution that has been factorized, 0 if none
+    unsigned long _version;
+
 #endif // WITH_EIGEN
 #endif // WITH_BOOST
 }; // class edoNormalMulti
@@ -64,11 +64,12 @@ public:
         EOT solution;
 
         // Sampling all dimensions
+        eoRng& gen = eo::threadRng();
         for (unsigned int i = 0; i < size; ++i)
         {
             double min = distrib.min()[i];
             double max = distrib.max()[i];
-            double random = rng.uniform(min, max);
+            double random = gen.uniform(min, max);
 
             assert( ( min == random && random == max ) || ( min <= random && random < max) ); // random in [ min, max [
 
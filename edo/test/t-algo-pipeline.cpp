@@ -0,0 +1,187 @@
+/*
+The Evolving Distribution Objects framework (EDO) is a template-based,
+ANSI-C++ evolutionary computation library which helps you to write your
+own estimation of distribution algorithms.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Runs an EDA whose new solutions are sampled and evaluated block by block,
+// the sampling of a block overlapping the evaluation of the previous one,
+// checks that every solution is evaluated once and correctly, that a budget
+// of evaluations still stops the algorithm, and times the pipeline against
+// sampling the whole population before evaluating it, with an evaluation
+// that waits as for an external process.
+
+#include <iostream>
+#include <vector>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <eo>
+#include <es.h>
+#include <edo>
+#include <eoEvalFuncCounterBounder.h>
+
+typedef eoReal< eoMinimizingFitness > EOT;
+typedef edoNormalMulti< EOT > Distrib;
+
+class Sphere : public eoEvalFunc< EOT >
+{
+public:
+    void operator()( EOT& x )
+    {
+        x.fitness( value( x ) );
+    }
+
+    static double value( const EOT& x )
+    {
+        double sum = 0;
+        for( unsigned int i = 0; i < x.size(); ++i ) {
+            sum += x[i] * x[i];
+        }
+        return sum;
+    }
+};
+
+// evaluates the offspring, waiting for each solution, and records the sizes of the blocks
+class WaitingEval : public eoPopEvalFunc< EOT >
+{
+public:
+    WaitingEval( eoEvalFunc< EOT >& eval, unsigned int wait ) : _eval( eval ), _wait( wait ) {}
+
+    void operator()( eoPop< EOT >& /*parents*/, eoPop< EOT >& offspring )
+    {
+        blocks.push_back( offspring.size() );
+        for( unsigned int i = 0; i < offspring.size(); ++i ) {
+            if( _wait > 0 ) {
+                usleep( _wait );
+            }
+            _eval( offspring[i] );
+        }
+    }
+
+    std::vector< unsigned int > blocks;
+
+private:
+    eoEvalFunc< EOT >& _eval;
+    unsigned int _wait;
+};
+
+double seconds()
+{
+    struct timeval t;
+    gettimeofday( &t, 0 );
+    return t.tv_sec + 1e-6 * t.tv_usec;
+}
+
+// runs the EDA from a new population, returns the final population
+eoPop< EOT > run( eoEvalFunc< EOT >& eval, unsigned int dim, unsigned int size, unsigned int generations,
+                  unsigned int block_size, unsigned int wait, double& time, std::vector< unsigned int >& blocks )
+{
+    eo::rng.reseed( 42 );
+
+    eoUniformGenerator< double > gen( -5, 5 );
+    eoInitFixedLength< EOT > init( dim, gen );
+    eoPop< EOT > pop( size, init );
+    apply< EOT >( eval, pop );
+
+    eoDetSelect< EOT > selector( 0.5 );
+    edoEstimatorNormalMulti< EOT > estimator;
+    edoBounderNo< EOT > bounder;
+    edoSamplerNormalMulti< EOT > sampler( bounder );
+    eoPlusReplacement< EOT > replacor;
+    eoGenContinue< EOT > continuator( generations );
+    WaitingEval pop_eval( eval, wait );
+
+    edoAlgoStateless< Distrib > algo( pop_eval, selector, estimator, sampler, replacor, continuator, block_size );
+
+    double start = seconds();
+    algo( pop );
+    time = seconds() - start;
+
+    blocks = pop_eval.blocks;
+    return pop;
+}
+
+bool check( const eoPop< EOT >& pop, unsigned int size, const std::string& what )
+{
+    if( pop.size() != size ) {
+        std::cerr << what << ": " << pop.size() << " solutions instead of " << size << std::endl;
+        return false;
+    }
+    for( unsigned int i = 0; i < pop.size(); ++i ) {
+        if( pop[i].invalid() || pop[i].fitness() != Sphere::value( pop[i] ) ) {
+            std::cerr << what << ": wrong fitness for solution " << i << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    const unsigned int dim = 10;
+    const unsigned int size = 50;
+    const unsigned int generations = 20;
+
+    Sphere sphere;
+    double time;
+    std::vector< unsigned int > blocks;
+
+    // the whole population at once
+    eoEvalFuncCounter< EOT > whole_count( sphere );
+    eoPop< EOT > whole = run( whole_count, dim, size, generations, 0, 0, time, blocks );
+    if( !check( whole, size, "whole population" ) || blocks.size() != generations ) {
+        return 1;
+    }
+
+    // blocks of 7 solutions, the last one of 1
+    eoEvalFuncCounter< EOT > block_count( sphere );
+    eoPop< EOT > pipelined = run( block_count, dim, size, generations, 7, 0, time, blocks );
+    if( !check( pipelined, size, "blocks" ) ) {
+        return 1;
+    }
+    if( block_count.value() != whole_count.value() || blocks.size() != 8 * generations
+        || blocks[0] != 7 || blocks[7] != 1 ) {
+        std::cerr << "Wrong blocks: " << block_count.value() << " evaluations in " << blocks.size() << " blocks" << std::endl;
+        return 1;
+    }
+
+    // both searches converge
+    if( double( pipelined.best_element().fitness() ) > 0.1 || double( whole.best_element().fitness() ) > 0.1 ) {
+        std::cerr << "No convergence: " << pipelined.best_element().fitness()
+                  << " with blocks, " << whole.best_element().fitness() << " without" << std::endl;
+        return 1;
+    }
+
+    // a budget of evaluations stops the pipeline in the middle of a generation
+    eoEvalFuncCounterBounder< EOT > budget( sphere, size + 3 * size / 2 );
+    try {
+        run( budget, dim, size, generations, 7, 0, time, blocks );
+        std::cerr << "The budget of evaluations was not enforced" << std::endl;
+        return 1;
+    } catch( eoEvalFuncCounterBounderException& ) {
+    }
+
+    // timing, with an evaluation waiting 20 microseconds for each solution
+    double whole_time, pipelined_time;
+    run( sphere, 200, 400, 5, 0, 20, whole_time, blocks );
+    run( sphere, 200, 400, 5, 50, 20, pipelined_time, blocks );
+    std::cout << "5 generations of 400 solutions in dimension 200: " << whole_time << "s sampling the whole population, "
+              << pipelined_time << "s sampling blocks of 50 during the evaluations" << std::endl;
+
+    return 0;
+}
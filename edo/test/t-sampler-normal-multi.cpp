@@ -0,0 +1,122 @@
+/*
+The Evolving Distribution Objects framework (EDO) is a template-based,
+ANSI-C++ evolutionary computation library which helps you to write your
+own estimation of distribution algorithms.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Checks that sampling a batch of solutions from a multi-normal law gives
+// the same solutions as sampling them one by one, with a deterministic or a
+// stochastic repairer, and that the cached decomposition follows the
+// distribution changes.
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <eo>
+#include <es.h>
+#include <edo>
+
+typedef eoReal< eoMinimizingFitness > EOT;
+typedef edoNormalMulti< EOT > Distrib;
+typedef EOT::AtomType AtomType;
+
+#ifdef WITH_BOOST
+    typedef ublas::vector< AtomType > Vector;
+    typedef ublas::symmetric_matrix< AtomType, ublas::lower > Matrix;
+#else
+#ifdef WITH_EIGEN
+    typedef edoNormalMulti<EOT>::Vector Vector;
+    typedef edoNormalMulti<EOT>::Matrix Matrix;
+#endif
+#endif
+
+Distrib make_distrib( unsigned int dim, AtomType covar )
+{
+    Vector mean( dim );
+    Matrix varcovar( dim, dim );
+    for( unsigned int i = 0; i < dim; ++i ) {
+        mean( i ) = i;
+        for( unsigned int j = 0; j <= i; ++j ) {
+            varcovar( i, j ) = ( i == j ) ? 1.0 : covar;
+#ifdef WITH_EIGEN
+            varcovar( j, i ) = varcovar( i, j );
+#endif
+        }
+    }
+    return Distrib( mean, varcovar );
+}
+
+bool same( const std::vector<EOT>& a, const std::vector<EOT>& b )
+{
+    if( a.size() != b.size() ) return false;
+    for( unsigned int i = 0; i < a.size(); ++i ) {
+        for( unsigned int j = 0; j < a[i].size(); ++j ) {
+            if( std::fabs( a[i][j] - b[i][j] ) > 1e-9 ) return false;
+        }
+    }
+    return true;
+}
+
+bool same_batch( edoSampler< Distrib >& sampler, unsigned int dim, unsigned int n )
+{
+    Distrib distrib = make_distrib( dim, 0.5 );
+
+    for( unsigned int k = 0; k < 2; ++k ) {
+        eo::rng.reseed( 42 );
+        std::vector< EOT > one_by_one;
+        for( unsigned int i = 0; i < n; ++i ) {
+            one_by_one.push_back( sampler( distrib ) );
+        }
+
+        eo::rng.reseed( 42 );
+        std::vector< EOT > batch;
+        sampler( distrib, n, batch );
+
+        if( !same( one_by_one, batch ) ) {
+            return false;
+        }
+
+        // a new distribution must be factorized again
+        distrib = make_distrib( dim, 0.1 );
+    }
+    return true;
+}
+
+int main()
+{
+    const unsigned int dim = 10;
+    const unsigned int n = 50;
+
+    edoBounderNo< EOT > bounder;
+    edoSamplerNormalMulti< EOT > sampler( bounder );
+    if( !same_batch( sampler, dim, n ) ) {
+        std::cerr << "Batch and single samples differ" << std::endl;
+        return 1;
+    }
+
+    // the means are 0 to dim-1: most of the solutions are redrawn uniformly
+    // by the repairer, which takes numbers from the same random stream
+    edoBounderUniform< EOT > uniform( EOT( dim, -1 ), EOT( dim, 1 ) );
+    edoSamplerNormalMulti< EOT > bounded( uniform );
+    if( !same_batch( bounded, dim, n ) ) {
+        std::cerr << "Batch and single samples differ with a stochastic repairer" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -171,21 +171,15 @@ class RegFitness: public eoEvalFunc< eoParseTree<FitnessType, Node> >
 		void operator()(EoType &_eo)
 		{
 
-				vector< double > input(1); // the input variable(s)
-				double output(0.);
-				double target;
-				FitnessType fitness;
-
+				// all the fitness cases at once, with the compiled tree
+				vector< double > outputs(inputs.size());
+				_eo.compiled().apply(&outputs[0], inputs.size(), inputs);
 
-				float x=0;
+				FitnessType fitness;
 				double fit=0;
-				for(x=-1; x <= 1; x+=0.1)
+				for(unsigned i=0; i < inputs.size(); ++i)
 				{
-					input[0] = x;
-					target = sextic_polynomial(x);
-					_eo.apply(output,input);
-
-					fit += pow(target - output, 2);
+					fit += pow(targets[i] - outputs[i], 2);
 				}
 
 				fitness[NORMAL] = fit;
@@ -207,6 +201,14 @@ class RegFitness: public eoEvalFunc< eoParseTree<FitnessType, Node> >
 		RegFitness(eoValueParam<unsigned> &_generationCounter, vector< Node > &initSequence, Parameters &_parameter) : eoEvalFunc<EoType>(), generationCounter(_generationCounter), parameter(_parameter)
 		{
 			init(initSequence);
+
+			// the fitness cases: one input variable (X)
+			for(float x=-1; x <= 1; x+=0.1)
+			{
+				inputs.push_back(vector< double >(1, x));
+				targets.push_back(sextic_polynomial(x));
+			}
+
 			best[NORMAL] = 1000;
 			tree= "not found";
 		};
@@ -222,6 +224,8 @@ class RegFitness: public eoEvalFunc< eoParseTree<FitnessType, Node> >
 		Parameters &parameter; // the parameters
 		FitnessType best;	// the best found fitness
 		string tree;
+		vector< vector< double > > inputs; // the values of the variables for each fitness case
+		vector< double > targets;
 };
 
 #endif
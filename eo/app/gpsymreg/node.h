@@ -22,6 +22,7 @@
 
 
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <cmath> // for finite(double) function
@@ -166,6 +167,27 @@ class Node
 
 		}
 
+		// evaluation on a batch of cases, each case being a vector holding the values of the variables
+		template<class Cases>
+		void operator()(double* result, const double* const* args, size_t n, const Cases& cases) const
+		{
+			switch(op.type)
+			{
+				case Variable:  for (size_t k = 0; k < n; ++k)
+							result[k] = cases[k][op.id%cases[k].size()];
+						break;
+				case UFunction: for (size_t k = 0; k < n; ++k)
+							result[k] = op.uFunction(args[0][k]);
+						break;
+				case BFunction:
+				case BOperator:	for (size_t k = 0; k < n; ++k)
+							result[k] = op.bFunction(args[0][k], args[1][k]);
+						break;
+				case Const:	std::fill(result, result + n, op.constant);
+						break;
+			}
+		}
+
 		template<class Children>
 		void operator()(string& result, Children args) const
 		{
@@ -23,4 +23,79 @@ double exp(arg_ptr args) {
     return ::exp(**args);
 }
 
+double pow(arg_ptr args) {
+    return ::pow(*args[0], *args[1]);
+}
+
+double ifltz(arg_ptr args) {
+    return *args[0] < 0.0 ? *args[1] : *args[2];
+}
+
+/* Block versions: args[i] points to the n values of the i-th argument, one per record.
+ * The loops only touch contiguous arrays, so that the compiler can vectorize them */
+
+void block_plus(const double* const* args, double* out, unsigned n) {
+    const double* a = args[0];
+    const double* b = args[1];
+    for (unsigned i = 0; i < n; ++i) out[i] = a[i] + b[i];
+}
+
+void block_mult(const double* const* args, double* out, unsigned n) {
+    const double* a = args[0];
+    const double* b = args[1];
+    for (unsigned i = 0; i < n; ++i) out[i] = a[i] * b[i];
+}
+
+void block_min(const double* const* args, double* out, unsigned n) {
+    const double* a = args[0];
+    for (unsigned i = 0; i < n; ++i) out[i] = -a[i];
+}
+
+void block_inv(const double* const* args, double* out, unsigned n) {
+    const double* a = args[0];
+    for (unsigned i = 0; i < n; ++i) out[i] = 1 / a[i];
+}
+
+void block_pow(const double* const* args, double* out, unsigned n) {
+    const double* a = args[0];
+    const double* b = args[1];
+    for (unsigned i = 0; i < n; ++i) out[i] = ::pow(a[i], b[i]);
+}
+
+void block_ifltz(const double* const* args, double* out, unsigned n) {
+    const double* a = args[0];
+    const double* b = args[1];
+    const double* c = args[2];
+    for (unsigned i = 0; i < n; ++i) out[i] = a[i] < 0.0 ? b[i] : c[i];
+}
+
+#define MULTI_UNARY(name) \
+double name(arg_ptr args) { return ::name(**args); } \
+void block_##name(const double* const* args, double* out, unsigned n) { \
+    const double* a = args[0]; \
+    for (unsigned i = 0; i < n; ++i) out[i] = ::name(a[i]); \
+}
+
+void block_exp(const double* const* args, double* out, unsigned n) {
+    const double* a = args[0];
+    for (unsigned i = 0; i < n; ++i) out[i] = ::exp(a[i]);
+}
+
+MULTI_UNARY(sin)
+MULTI_UNARY(cos)
+MULTI_UNARY(tan)
+MULTI_UNARY(asin)
+MULTI_UNARY(acos)
+MULTI_UNARY(atan)
+MULTI_UNARY(sinh)
+MULTI_UNARY(cosh)
+MULTI_UNARY(tanh)
+MULTI_UNARY(asinh)
+MULTI_UNARY(acosh)
+MULTI_UNARY(atanh)
+MULTI_UNARY(log)
+MULTI_UNARY(sqrt)
+
+#undef MULTI_UNARY
+
 } // namespace
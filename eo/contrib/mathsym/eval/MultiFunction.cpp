@@ -1,4 +1,5 @@
-#include <vector.h>
+#include <vector>
+#include <algorithm>
 
 
 #include "MultiFunction.h"
@@ -15,6 +16,7 @@ typedef data_ptrs::const_iterator arg_ptr;
 #include "MultiFuncs.cpp"
 
 typedef double (*fptr)( arg_ptr );
+typedef void (*block_fptr)( const double* const*, double*, unsigned );
 
 string print_function( fptr f) {
     if (f == multi_function::plus) return "+";
@@ -34,6 +36,16 @@ struct Function {
     double operator()() const { return function(args); }
 };
 
+/* A function evaluated on a block of records: args points to the rows of its arguments */
+struct BlockFunction {
+
+    block_fptr function;
+    const double* const* args;
+    double* out;
+
+    void operator()(unsigned n) const { function(args, out, n); }
+};
+
 static vector<Function> token_2_function;
 
 Sym make_binary(Sym sym) {
@@ -56,17 +68,14 @@ class Compiler {
     
     typedef pair<func_type, unsigned> entry;
 
-#if USE_TR1
-	    typedef std::tr1::unordered_map<Sym, entry, HashSym> HashMap;
-#else
-	    typedef hash_map<Sym, entry, HashSym> HashMap;
-#endif	    
+    typedef std::unordered_map<Sym, entry, HashSym> HashMap;
    
     HashMap map;
    
     vector<double> constants;
     vector<unsigned> variables;
     vector< fptr > functions;
+    vector< block_fptr > block_functions;
     vector< vector<entry> > function_args;
     
     unsigned total_args;
@@ -98,6 +107,7 @@ class Compiler {
 	    } // else 
 		
 	    fptr f;
+	    block_fptr bf;
 	    vector<entry> vec;
 	    const SymVec& args = sym.args();
 	    
@@ -114,6 +124,7 @@ class Compiler {
 			    vec.push_back(do_add(args[0]));
 			    vec.push_back(do_add(args[1]));
 			    f = multi_function::plus;
+			    bf = multi_function::block_plus;
 			    //cout << "Adding + " << vec[0].second << ' ' << vec[1].second << endl;
 			    break;
 
@@ -134,6 +145,7 @@ class Compiler {
 			    vec.push_back(do_add(args[0]));
 			    vec.push_back(do_add(args[1]));
 			    f = multi_function::mult;
+			    bf = multi_function::block_mult;
 			    //cout << "Adding * " << vec[0].second << ' ' << vec[1].second << endl;
 			    break;
 			    
@@ -151,23 +163,47 @@ class Compiler {
 		    }
 		default :
 		    {
-			if (args.size() != 1) {
+			unsigned arity = 1;
+			if (token == pow_token) arity = 2;
+			if (token == ifltz_token) arity = 3;
+
+			if (args.size() != arity) {
 			    cerr << "Unknown function " << sym << " encountered" << endl;
 			    exit(1);
 			}
 			
-			vec.push_back(do_add(args[0]));
+			for (unsigned i = 0; i < arity; ++i) {
+			    vec.push_back(do_add(args[i]));
+			}
 
+#define MULTI_CASE(name) case name##_token: f = multi_function::name; bf = multi_function::block_##name; break;
 			switch (token) {
-			    case min_token: f = multi_function::min; break;
-			    case inv_token: f = multi_function::inv; break;
-			    case exp_token :f = multi_function::exp; break;
+			    MULTI_CASE(min)
+			    MULTI_CASE(inv)
+			    MULTI_CASE(pow)
+			    MULTI_CASE(ifltz)
+			    MULTI_CASE(sin)
+			    MULTI_CASE(cos)
+			    MULTI_CASE(tan)
+			    MULTI_CASE(asin)
+			    MULTI_CASE(acos)
+			    MULTI_CASE(atan)
+			    MULTI_CASE(sinh)
+			    MULTI_CASE(cosh)
+			    MULTI_CASE(tanh)
+			    MULTI_CASE(asinh)
+			    MULTI_CASE(acosh)
+			    MULTI_CASE(atanh)
+			    MULTI_CASE(exp)
+			    MULTI_CASE(log)
+			    MULTI_CASE(sqrt)
 			    default :
 				{
 				    cerr << "Unimplemented token encountered " << sym << endl;
 				    exit(1);
 				}
 			}
+#undef MULTI_CASE
 			
 			//cout << "Adding " << print_function(f) << ' ' << vec[0].second << endl;
 			
@@ -179,6 +215,7 @@ class Compiler {
 	    total_args += vec.size();
 	    function_args.push_back(vec);
 	    functions.push_back(f);
+	    block_functions.push_back(bf);
 	    
 	    entry e = make_pair(function, functions.size()-1);
 	    map.insert( make_pair(sym, e) );
@@ -212,6 +249,14 @@ class MultiFunctionImpl {
     
     vector<unsigned> output_idx;
     
+    // column oriented evaluation: every entry of data gets a row of block_size values,
+    // one per record, so that each distinct subtree is computed once for a whole block
+    enum { block_size = 64 };
+    
+    vector<double> block_data;
+    vector<BlockFunction> block_funcs;
+    vector<const double*> block_args;
+
     MultiFunctionImpl() {}
 
     void clear() {
@@ -220,6 +265,9 @@ class MultiFunctionImpl {
 	funcs.clear();
 	args.clear();
 	output_idx.clear();
+	block_data.clear();
+	block_funcs.clear();
+	block_args.clear();
 	constant_offset = 0;
     }
     
@@ -243,6 +291,35 @@ class MultiFunctionImpl {
     void eval(const vector<double>& x, vector<double>& y) {
 	eval(&x[0], &y[0]);
     }
+
+    double* row(unsigned i) { return &block_data[i * block_size]; }
+    
+    void eval(const double* const* x, unsigned n, double* y) {
+	
+	for (unsigned start = 0; start < n; start += block_size) {
+	    
+	    unsigned m = std::min<unsigned>(block_size, n - start);
+	    const double* const* records = x + start;
+	    
+	    // gather the variables into their rows
+	    for (unsigned v = 0; v < input_idx.size(); ++v) {
+		double* r = row(constant_offset + v);
+		unsigned idx = input_idx[v];
+		for (unsigned k = 0; k < m; ++k) {
+		    r[k] = records[k][idx];
+		}
+	    }
+
+	    for (unsigned i = 0; i < block_funcs.size(); ++i) {
+		block_funcs[i](m);
+	    }
+
+	    for (unsigned i = 0; i < output_idx.size(); ++i) {
+		const double* r = row(output_idx[i]);
+		std::copy(r, r + m, y + i * n + start);
+	    }
+	}
+    }
     
     void setup(const vector<Sym>& pop) {
 	
@@ -263,9 +340,14 @@ class MultiFunctionImpl {
 	funcs.resize(compiler.functions.size());
 	args.resize(compiler.total_args);
 	
+	block_data.resize(n * block_size);
+	block_funcs.resize(compiler.functions.size());
+	block_args.resize(compiler.total_args);
+	
 	// constants
 	for (unsigned i = 0; i < constant_offset; ++i) {
 	    data[i] = compiler.constants[i];
+	    std::fill(row(i), row(i) + block_size, data[i]);
 	    //cout << i << ' ' << data[i] << endl;
 	}
 	
@@ -299,14 +381,22 @@ class MultiFunctionImpl {
 		}
 
 		args[which_arg + j] = data.begin() + idx;
+		block_args[which_arg + j] = row(idx);
 		//cout << ' ' << idx << "(" << e.second << ")";
 	    }
 	    
 	    //cout << endl;
 
 	    f.args = args.begin() + which_arg;
+	    
+	    BlockFunction bf;
+	    bf.function = compiler.block_functions[i];
+	    bf.args = block_args.empty() ? 0 : &block_args[which_arg];
+	    bf.out = row(i + var_offset);
+	    
 	    which_arg += compiler.function_args[i].size();
 	    funcs[i] = f;    
+	    block_funcs[i] = bf;
 	}
 
 	// output indices
@@ -339,3 +429,7 @@ void MultiFunction::operator()(const std::vector<double>& x, std::vector<double>
 void MultiFunction::operator()(const double* x, double* y) {
     pimpl->eval(x,y);
 }
+
+void MultiFunction::operator()(const double* const* x, unsigned n, double* y) {
+    pimpl->eval(x, n, y);
+}
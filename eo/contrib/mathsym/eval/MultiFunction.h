@@ -20,6 +20,10 @@ class MultiFunction {
     void operator()(const std::vector<double>& x, std::vector<double>& y);
     void operator()(const double* x, double* y);
     
+    /* Evaluates the functions on n records at once: x[r] points to the inputs of record r,
+     * and y[i * n + r] receives the value of function i on record r */
+    void operator()(const double* const* x, unsigned n, double* y);
+    
 };
 
 #endif
@@ -19,11 +19,122 @@
 #include "Sym.h"
 #include "FunDef.h"
 #include "sym_compile.h"
+#include "sym_jit.h"
 
 #include <sstream>
+#include <map>
+#include <unordered_map>
 
 using namespace std;
 
+#ifdef SYM_JIT
+
+/* Native code, see sym_jit.cpp. The single functions are kept by sym, so that a sym
+ * that comes back (a clone, or a survivor from a previous generation) is not compiled
+ * again. The syms that only the cache still holds are dropped, with the modules whose
+ * functions are all gone, once the cache has doubled since the last time, so that the
+ * cache does not keep the dead dags alive. The cache is cleared at the start of a call
+ * when its code grows too large. */
+
+struct CachedFunction {
+    single_function function;
+    JitModule* module;
+};
+
+typedef std::unordered_map<Sym, CachedFunction, HashSym> FunctionCache;
+
+typedef std::map<JitModule*, unsigned> ModuleUsers; // number of cached functions in each module
+
+static FunctionCache function_cache;
+static ModuleUsers cached_modules;
+static unsigned cached_code_size = 0;
+static const unsigned max_cached_code_size = 64 * 1024 * 1024;
+static const unsigned min_cache_sweep = 1024;
+static unsigned next_cache_sweep = min_cache_sweep;
+
+static JitModule* multi_module = 0;
+
+void clear_compile_cache() {
+    function_cache.clear();
+    for (ModuleUsers::iterator it = cached_modules.begin(); it != cached_modules.end(); ++it) {
+	jit_release(it->first);
+    }
+    cached_modules.clear();
+    cached_code_size = 0;
+    next_cache_sweep = min_cache_sweep;
+}
+
+static void sweep_compile_cache() {
+    for (FunctionCache::iterator it = function_cache.begin(); it != function_cache.end();) {
+	if (it->first.refcount() > 1) {
+	    ++it;
+	    continue;
+	}
+
+	ModuleUsers::iterator users = cached_modules.find(it->second.module);
+	if (--users->second == 0) {
+	    cached_code_size -= jit_code_size(users->first);
+	    jit_release(users->first);
+	    cached_modules.erase(users);
+	}
+	function_cache.erase(it++);
+    }
+    next_cache_sweep = std::max<unsigned>(min_cache_sweep, 2 * function_cache.size());
+}
+
+multi_function compile(const std::vector<Sym>& syms) {
+    jit_release(multi_module);
+    multi_function result;
+    multi_module = jit_compile(syms, result);
+    return result;
+}
+
+single_function compile(Sym sym) {
+    vector<Sym> syms(1, sym);
+    vector<single_function> functions;
+    compile(syms, functions);
+    return functions[0];
+}
+
+void compile(const std::vector<Sym>& syms, std::vector<single_function>& functions) {
+    if (cached_code_size > max_cached_code_size) {
+	clear_compile_cache();
+    } else if (function_cache.size() >= next_cache_sweep) {
+	sweep_compile_cache();
+    }
+    
+    // only the syms that were never seen are compiled
+    vector<Sym> missing;
+    for (unsigned i = 0; i < syms.size(); ++i) {
+	if (function_cache.find(syms[i]) == function_cache.end()) {
+	    CachedFunction none = { 0, 0 };
+	    function_cache[syms[i]] = none;
+	    missing.push_back(syms[i]);
+	}
+    }
+
+    if (!missing.empty()) {
+	vector<single_function> compiled;
+	JitModule* module = jit_compile(missing, compiled);
+	cached_modules[module] = missing.size();
+	cached_code_size += jit_code_size(module);
+	
+	for (unsigned i = 0; i < missing.size(); ++i) {
+	    CachedFunction cached = { compiled[i], module };
+	    function_cache[missing[i]] = cached;
+	}
+    }
+
+    functions.resize(syms.size());
+    for (unsigned i = 0; i < syms.size(); ++i) {
+	functions[i] = function_cache[syms[i]].function;
+    }
+}
+
+#else // tiny cc
+
+void clear_compile_cache() {}
+
 extern "C" {
     void  symc_init();
     int  symc_compile(const char* func_str);
@@ -40,11 +151,7 @@ string make_prototypes() {
 
 // contains variable names, like 'a0', 'a1', etc. or regular code
 
-#if USE_TR1 
-typedef std::tr1::unordered_map<Sym, string, HashSym> HashMap;
-#else
-typedef hash_map<Sym, string, HashSym> HashMap;
-#endif
+typedef std::unordered_map<Sym, string, HashSym> HashMap;
 
 // prints 'num' in reverse notation. Does not matter as it's a unique id
 string make_var(unsigned num) {
@@ -215,5 +322,5 @@ void compile(const std::vector<Sym>& syms, std::vector<single_function>& functio
 
 }
 
-
+#endif
 
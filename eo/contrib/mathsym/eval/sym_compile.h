@@ -27,10 +27,17 @@ typedef double (*multi_function)(const double[], double[]);
 /* 
  * Important, after every call of the functions below, the function pointers of the previous
  * call are invalidated. Sorry, but that's the way the cookie crumbles (in tcc)
+ * 
+ * On x86-64 the syms are compiled directly to machine code (see sym_jit.h) and tcc is not
+ * used. The single functions are then cached by sym, so that a sym is only compiled once
+ * as long as it is alive.
  * */
 
 single_function compile(Sym sym);
 multi_function  compile(const std::vector<Sym>& sym);
 void compile(const std::vector<Sym>& sym, std::vector<single_function>& functions);
 
+/* frees the cached functions */
+void clear_compile_cache();
+
 #endif
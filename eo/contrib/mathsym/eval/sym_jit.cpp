@@ -0,0 +1,353 @@
+/*
+ *             Copyright (C) 2005 Maarten Keijzer
+ *
+ *          This program is free software; you can redistribute it and/or modify
+ *          it under the terms of version 2 of the GNU General Public License as
+ *          published by the Free Software Foundation.
+ *
+ *          This program is distributed in the hope that it will be useful,
+ *          but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *          GNU General Public License for more details.
+ *
+ *          You should have received a copy of the GNU General Public License
+ *          along with this program; if not, write to the Free Software
+ *          Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Sym.h"
+#include "FunDef.h"
+#include "sym_jit.h"
+
+#ifdef SYM_JIT
+
+#include <sys/mman.h>
+#include <string.h>
+#include <stdint.h>
+#include <cmath>
+#include <iostream>
+#include <unordered_map>
+
+using namespace std;
+
+class JitModule {
+    public:
+    void* code;
+    size_t size;
+    unsigned code_size;
+};
+
+namespace {
+
+typedef double (*unary_fun)(double);
+typedef double (*binary_fun)(double, double);
+
+double jit_ifltz(double a, double b, double c) { return a < 0.0 ? b : c; }
+
+/* functions of the language without a dedicated code generator, such as user defined ones */
+double jit_generic(const FunDef* fun, const double* args, unsigned n) {
+    vector<double> vals(args, args + n);
+    static const vector<double> no_inputs;
+    return fun->eval(vals, no_inputs);
+}
+
+unary_fun get_unary(token_t token) {
+    switch (token) {
+	case sin_token : return ::sin;
+	case cos_token : return ::cos;
+	case tan_token : return ::tan;
+	case asin_token : return ::asin;
+	case acos_token : return ::acos;
+	case atan_token : return ::atan;
+	case sinh_token : return ::sinh;
+	case cosh_token : return ::cosh;
+	case tanh_token : return ::tanh;
+	case asinh_token : return ::asinh;
+	case acosh_token : return ::acosh;
+	case atanh_token : return ::atanh;
+	case exp_token : return ::exp;
+	case log_token : return ::log;
+    }
+    return 0;
+}
+
+// register numbers
+enum { xmm0 = 0, xmm1 = 1, xmm2 = 2, rbx = 3, rsp = 4, r13 = 13 };
+
+// SSE2 opcodes, after the 0F escape
+enum { op_load = 0x10, op_store = 0x11, op_sqrt = 0x51, op_add = 0x58, op_mul = 0x59, op_div = 0x5E };
+
+/* Writes the instructions. rbx holds the inputs (x), r13 the outputs (y), and the slots of
+ * the nodes are in the stack frame, addressed from rsp, so that the functions are reentrant */
+class Emitter {
+    public:
+    vector<unsigned char> code;
+    unsigned pages_patch; // where the size of the frame of the current function must be written
+    unsigned rest_patch;
+
+    void byte(unsigned b) { code.push_back((unsigned char) b); }
+
+    void imm32(uint32_t v) { for (unsigned i = 0; i < 4; ++i) byte((v >> (8*i)) & 0xFF); }
+    void imm64(uint64_t v) { for (unsigned i = 0; i < 8; ++i) byte((v >> (8*i)) & 0xFF); }
+
+    /* sd instruction (F2 prefix) between an xmm register and [base + disp] */
+    void sse_mem(unsigned op, unsigned xmm, unsigned base, unsigned disp) {
+	byte(0xF2);
+	if (base >= 8) byte(0x41); // REX.B
+	byte(0x0F);
+	byte(op);
+	byte(0x80 | (xmm << 3) | (base & 7)); // mod = 10: disp32
+	if ((base & 7) == 4) byte(0x24);      // rsp needs a SIB byte
+	imm32(disp);
+    }
+
+    void load(unsigned xmm, unsigned base, unsigned disp)  { sse_mem(op_load, xmm, base, disp); }
+    void store(unsigned xmm, unsigned base, unsigned disp) { sse_mem(op_store, xmm, base, disp); }
+
+    /* xmm <- the bits of a double, through rax */
+    void load_constant(unsigned xmm, double value) {
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	byte(0x48); byte(0xB8); imm64(bits);                    // mov rax, imm64
+	byte(0x66); byte(0x48); byte(0x0F); byte(0x6E); byte(0xC0 | (xmm << 3)); // movq xmm, rax
+    }
+
+    void call(const void* fun) {
+	byte(0x48); byte(0xB8); imm64((uint64_t) fun); // mov rax, imm64
+	byte(0xFF); byte(0xD0);                        // call rax
+    }
+
+    /* The frame is only known once the function is written, see epilogue. It is
+     * reserved a page at a time, touching each page, so that a large frame can not
+     * jump over the guard page of the stack of a thread */
+    void prologue() {
+	byte(0x53);                           // push rbx
+	byte(0x41); byte(0x55);               // push r13
+	byte(0x48); byte(0x89); byte(0xFB);   // mov rbx, rdi
+	byte(0x49); byte(0x89); byte(0xF5);   // mov r13, rsi
+	byte(0xB8); pages_patch = code.size(); imm32(0);     // mov eax, pages
+	byte(0x85); byte(0xC0);                              // loop: test eax, eax
+	byte(0x74); byte(0x10);                              // jz done
+	byte(0x48); byte(0x81); byte(0xEC); imm32(4096);     // sub rsp, 4096
+	byte(0x48); byte(0x83); byte(0x0C); byte(0x24); byte(0x00); // or qword [rsp], 0
+	byte(0xFF); byte(0xC8);                              // dec eax
+	byte(0xEB); byte(0xEC);                              // jmp loop
+	byte(0x48); byte(0x81); byte(0xEC); rest_patch = code.size(); imm32(0); // done: sub rsp, rest
+    }
+
+    /* n_slots slots of 8 bytes, and the stack aligned on 16 bytes for the calls */
+    void epilogue(unsigned n_slots) {
+	uint32_t frame = 8 * n_slots;
+	if (frame % 16 == 0) frame += 8; // the return address and the two pushes take 24 bytes
+	uint32_t pages = frame / 4096;
+	uint32_t rest = frame % 4096;
+	memcpy(&code[pages_patch], &pages, sizeof(pages));
+	memcpy(&code[rest_patch], &rest, sizeof(rest));
+
+	byte(0x48); byte(0x81); byte(0xC4); imm32(frame); // add rsp, frame
+	byte(0x41); byte(0x5D); // pop r13
+	byte(0x5B);             // pop rbx
+	byte(0xC3);             // ret
+    }
+};
+
+typedef std::unordered_map<Sym, unsigned, HashSym> SlotMap;
+
+/* Generates the code of the nodes of one function, each node stored in its own slot */
+class FunctionWriter {
+    Emitter& e;
+    SlotMap slots;
+    unsigned n_slots;
+
+    unsigned new_slot() { return n_slots++; }
+
+    // computes the node into xmm0
+    void write_node(const Sym& sym, const vector<unsigned>& args) {
+	token_t token = sym.token();
+
+	if (is_constant(token)) {
+	    e.load_constant(xmm0, get_constant_value(token));
+	    return;
+	}
+
+	if (is_variable(token)) {
+	    e.load(xmm0, rbx, 8 * get_variable_index(token));
+	    return;
+	}
+
+	switch (token) {
+	    case sum_token:
+	    case prod_token:
+		{
+		    if (args.empty()) {
+			e.load_constant(xmm0, token == sum_token ? 0.0 : 1.0);
+			return;
+		    }
+		    e.load(xmm0, rsp, 8 * args[0]);
+		    for (unsigned i = 1; i < args.size(); ++i) {
+			e.sse_mem(token == sum_token ? op_add : op_mul, xmm0, rsp, 8 * args[i]);
+		    }
+		    return;
+		}
+	    case min_token:
+		{
+		    e.load(xmm0, rsp, 8 * args[0]);
+		    e.load_constant(xmm1, -0.0);
+		    e.byte(0x66); e.byte(0x0F); e.byte(0x57); e.byte(0xC1); // xorpd xmm0, xmm1
+		    return;
+		}
+	    case inv_token:
+		{
+		    e.load_constant(xmm0, 1.0);
+		    e.sse_mem(op_div, xmm0, rsp, 8 * args[0]);
+		    return;
+		}
+	    case sqr_token:
+		{
+		    e.load(xmm0, rsp, 8 * args[0]);
+		    e.byte(0xF2); e.byte(0x0F); e.byte(op_mul); e.byte(0xC0); // mulsd xmm0, xmm0
+		    return;
+		}
+	    case sqrt_token:
+		{
+		    e.sse_mem(op_sqrt, xmm0, rsp, 8 * args[0]);
+		    return;
+		}
+	    case pow_token:
+		{
+		    e.load(xmm0, rsp, 8 * args[0]);
+		    e.load(xmm1, rsp, 8 * args[1]);
+		    e.call((const void*) (binary_fun) ::pow);
+		    return;
+		}
+	    case ifltz_token:
+		{
+		    e.load(xmm0, rsp, 8 * args[0]);
+		    e.load(xmm1, rsp, 8 * args[1]);
+		    e.load(xmm2, rsp, 8 * args[2]);
+		    e.call((const void*) jit_ifltz);
+		    return;
+		}
+	}
+
+	unary_fun f = get_unary(token);
+	if (f != 0 && args.size() == 1) {
+	    e.load(xmm0, rsp, 8 * args[0]);
+	    e.call((const void*) f);
+	    return;
+	}
+
+	// anything else: copy the arguments next to each other and let the FunDef evaluate them
+	unsigned first = n_slots;
+	n_slots += args.size();
+	for (unsigned i = 0; i < args.size(); ++i) {
+	    e.load(xmm0, rsp, 8 * args[i]);
+	    e.store(xmm0, rsp, 8 * (first + i));
+	}
+	e.byte(0x48); e.byte(0xBF); e.imm64((uint64_t) &get_element(token)); // mov rdi, imm64
+	e.byte(0x48); e.byte(0x8D); e.byte(0xB4); e.byte(0x24); e.imm32(8 * first); // lea rsi, [rsp + disp32]
+	e.byte(0xBA); e.imm32(args.size()); // mov edx, imm32
+	e.call((const void*) jit_generic);
+    }
+
+    public:
+
+    FunctionWriter(Emitter& e_) : e(e_), n_slots(0) {}
+
+    unsigned size() const { return n_slots; }
+
+    /* writes the code for the node and the nodes below, returns the slot of the node */
+    unsigned write(const Sym& sym) {
+	SlotMap::iterator it = slots.find(sym);
+	if (it != slots.end()) return it->second;
+
+	const SymVec& args = sym.args();
+	vector<unsigned> arg_slots(args.size());
+	for (unsigned i = 0; i < args.size(); ++i) {
+	    arg_slots[i] = write(args[i]);
+	}
+
+	write_node(sym, arg_slots);
+	unsigned slot = new_slot();
+	e.store(xmm0, rsp, 8 * slot);
+	slots[sym] = slot;
+	return slot;
+    }
+};
+
+/* Copies the code into executable memory */
+JitModule* make_module(Emitter& e) {
+    JitModule* module = new JitModule;
+    module->code_size = e.code.size();
+    size_t page = 4096;
+    module->size = ((e.code.size() + page - 1) / page) * page;
+    module->code = mmap(0, module->size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (module->code == MAP_FAILED) {
+	cerr << "Could not allocate memory for compiled functions" << endl;
+	exit(1);
+    }
+
+    memcpy(module->code, &e.code[0], e.code.size());
+    mprotect(module->code, module->size, PROT_READ | PROT_EXEC);
+
+    return module;
+}
+
+} // namespace
+
+JitModule* jit_compile(const std::vector<Sym>& syms, std::vector<single_function>& functions) {
+    Emitter e;
+    vector<unsigned> entries(syms.size());
+
+    for (unsigned i = 0; i < syms.size(); ++i) {
+	entries[i] = e.code.size();
+	e.prologue();
+
+	FunctionWriter writer(e);
+	unsigned slot = writer.write(expand_all(syms[i]));
+	e.load(xmm0, rsp, 8 * slot);
+
+	e.epilogue(writer.size());
+    }
+
+    JitModule* module = make_module(e);
+
+    functions.resize(syms.size());
+    for (unsigned i = 0; i < syms.size(); ++i) {
+	functions[i] = (single_function) ((char*) module->code + entries[i]);
+    }
+
+    return module;
+}
+
+JitModule* jit_compile(const std::vector<Sym>& syms, multi_function& function) {
+    Emitter e;
+    e.prologue();
+
+    FunctionWriter writer(e);
+    for (unsigned i = 0; i < syms.size(); ++i) {
+	unsigned slot = writer.write(expand_all(syms[i]));
+	e.load(xmm0, rsp, 8 * slot);
+	e.store(xmm0, r13, 8 * i);
+    }
+
+    e.epilogue(writer.size());
+
+    JitModule* module = make_module(e);
+    function = (multi_function) module->code;
+    return module;
+}
+
+void jit_release(JitModule* module) {
+    if (module == 0) return;
+    munmap(module->code, module->size);
+    delete module;
+}
+
+unsigned jit_code_size(const JitModule* module) {
+    return module->code_size;
+}
+
+#endif
+
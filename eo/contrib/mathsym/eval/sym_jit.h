@@ -0,0 +1,57 @@
+/*
+ *             Copyright (C) 2005 Maarten Keijzer
+ *
+ *          This program is free software; you can redistribute it and/or modify
+ *          it under the terms of version 2 of the GNU General Public License as
+ *          published by the Free Software Foundation.
+ *
+ *          This program is distributed in the hope that it will be useful,
+ *          but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *          GNU General Public License for more details.
+ *
+ *          You should have received a copy of the GNU General Public License
+ *          along with this program; if not, write to the Free Software
+ *          Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SYM_JIT_H_
+#define SYM_JIT_H_
+
+#include <vector>
+#include "sym_compile.h"
+
+/*
+ * Direct generation of x86-64 (SSE2) machine code for syms, used by sym_compile
+ * instead of tiny cc when SYM_JIT is defined.
+ *
+ * Every node of the dag of a sym is computed once into a slot of the stack frame,
+ * so that a function can be called from several threads at once.
+ * The functions of the language that have no SSE2 instruction are called through
+ * their C library implementation.
+ * */
+
+#if defined(__x86_64__) && !defined(SYM_NO_JIT)
+#define SYM_JIT 1
+#endif
+
+#ifdef SYM_JIT
+
+class JitModule;
+
+/* compiles every sym into its own function, all in one module */
+JitModule* jit_compile(const std::vector<Sym>& syms, std::vector<single_function>& functions);
+
+/* compiles all syms into a single function, sharing the common subtrees */
+JitModule* jit_compile(const std::vector<Sym>& syms, multi_function& function);
+
+/* frees the code of the functions of a module */
+void jit_release(JitModule* module);
+
+/* size of the machine code of a module */
+unsigned jit_code_size(const JitModule* module);
+
+#endif
+
+#endif
+
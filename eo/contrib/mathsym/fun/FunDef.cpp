@@ -118,13 +118,8 @@ struct HashDouble{
     }
 };
 
-#if USE_TR1
-typedef std::tr1::unordered_map<double, token_t> DoubleSet;
-typedef std::tr1::unordered_map<Sym, token_t>    LambdaSet;
-#else
-typedef hash_map<double, token_t, HashDouble> DoubleSet;
-typedef hash_map<Sym, token_t, HashSym> LambdaSet;
-#endif
+typedef std::unordered_map<double, token_t, HashDouble> DoubleSet;
+typedef std::unordered_map<Sym, token_t, HashSym> LambdaSet;
 
 static DoubleSet doubleSet; // for quick checking if a constant already exists
 static vector<double> token_value;
@@ -430,7 +425,7 @@ token_t new_lambda(Sym sym, int arity) {
 }
 
 /* Compression */
-typedef hash_map<Sym, unsigned, HashSym> OccMap;
+typedef std::unordered_map<Sym, unsigned, HashSym> OccMap;
 
 void count_occurances(Sym sym, OccMap& occ) {
     occ[sym]++;
@@ -41,7 +41,7 @@ class FunDef {
     virtual Interval eval(const std::vector<Interval>& args, const std::vector<Interval>& inputs) const = 0; 
     
     // prints 'c' like code
-    virtual std::string c_print(const std::vector<std::string>&   names, const std::vector<std::string>& names) const = 0;
+    virtual std::string c_print(const std::vector<std::string>&   args, const std::vector<std::string>& names) const = 0;
 
     virtual unsigned min_arity() const = 0;
     virtual bool has_varargs() const { return false; } // sum, prod, min, max are variable arity
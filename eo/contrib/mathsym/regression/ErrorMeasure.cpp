@@ -16,6 +16,7 @@
  */
 
 
+#include <algorithm>
 #include <vector>
 #include <valarray>
 
@@ -105,9 +106,12 @@ class ErrorMeasureImpl {
 	   
 	    if (pop.size() == 0) return vector<ErrorMeasure::result>();
 	    
-	    multi_function all = compile(pop);
-	    //MultiFunction all(pop);
-	    std::vector<double> y(pop.size());
+	    MultiFunction all(pop);
+	    
+	    // the records are evaluated a block at a time, yb[j * n + r] being the output of function j on record r
+	    const unsigned block = 256;
+	    std::vector<const double*> records(block);
+	    std::vector<double> yb(pop.size() * block);
 	    
 	    Scaling noScaling = Scaling(new NoScaling);
 	    
@@ -121,15 +125,22 @@ class ErrorMeasureImpl {
 	    
 		Var vart;
 
-		for (unsigned i = 0; i < t.size(); ++i) {
-		    vart.update(t[i]);
+		for (unsigned start = 0; start < t.size(); start += block) {
+		    unsigned n = std::min<unsigned>(block, t.size() - start);
+		    
+		    for (unsigned r = 0; r < n; ++r) {
+			records[r] = &data.get_inputs(start + r)[0];
+			vart.update(t[start + r]);
+		    }
 		    
-		    all(&data.get_inputs(i)[0], &y[0]); // evalutate
-		    //all(data.get_inputs(i), y); // evalutate
+		    all(&records[0], n, &yb[0]); // evalutate
 
 		    for (unsigned j = 0; j < pop.size(); ++j) {
-			var[j].update(y[j]);
-			cov[j].update(y[j], t[i]);
+			const double* yj = &yb[j * n];
+			for (unsigned r = 0; r < n; ++r) {
+			    var[j].update(yj[r]);
+			    cov[j].update(yj[r], t[start + r]);
+			}
 		    }
 		}
 		
@@ -163,8 +174,9 @@ class ErrorMeasureImpl {
 			cout << "var i " << var[i].get_var() << endl;
 			cout << "cov   " << cov[i].get_cov() << endl;
 			
+			std::vector<double> y(pop.size());
 			for (unsigned j = 0; j < t.size(); ++j) {
-			    all(&data.get_inputs(i)[0], &y[0]); // evalutate
+			    all(&data.get_inputs(j)[0], &y[0]); // evalutate
 			    //all(data.get_inputs(j), y); // evalutate
 			    
 			    cout << y[i] << ' ' << ::eval(pop[i], data.get_inputs(j)) << endl;
@@ -180,19 +192,30 @@ class ErrorMeasureImpl {
 	    
 	    std::vector<double> err(pop.size()); 
 	    
-	    for (unsigned i = 0; i < train_cases(); ++i) {
+	    for (unsigned start = 0; start < train_cases(); start += block) {
+		unsigned n = std::min<unsigned>(block, train_cases() - start);
+		
+		for (unsigned r = 0; r < n; ++r) {
+		    records[r] = &data.get_inputs(start + r)[0];
+		}
+		
 		// evaluate
-		all(&data.get_inputs(i)[0], &y[0]);
-		//all(data.get_inputs(i), y);
+		all(&records[0], n, &yb[0]);
 
 		for (unsigned j = 0; j < pop.size(); ++j) {
-		    double diff = y[j] - t[i];
-		    if (measure == ErrorMeasure::mean_squared) { // branch prediction will probably solve this inefficiency
-			err[j] += diff * diff;
+		    const double* yj = &yb[j * n];
+		    double e = 0.0;
+		    if (measure == ErrorMeasure::mean_squared) {
+			for (unsigned r = 0; r < n; ++r) {
+			    double diff = yj[r] - t[start + r];
+			    e += diff * diff;
+			}
 		    } else {
-			err[j] += fabs(diff);
+			for (unsigned r = 0; r < n; ++r) {
+			    e += fabs(yj[r] - t[start + r]);
+			}
 		    }
-		    
+		    err[j] += e;
 		}
 		
 	    }
@@ -244,11 +267,7 @@ class ErrorMeasureImpl {
 	vector<ErrorMeasure::result> calc_error(const vector<Sym>& pop) {
 
 	    // first declone
-#if USE_TR1
-	    typedef std::tr1::unordered_map<Sym, unsigned, HashSym> HashMap;
-#else
-	    typedef hash_map<Sym, unsigned, HashSym> HashMap;
-#endif	    
+	    typedef std::unordered_map<Sym, unsigned, HashSym> HashMap;
 	    HashMap clone_map;
 	    vector<Sym> decloned; 
 	    decloned.reserve(pop.size());
@@ -15,8 +15,8 @@
  *          Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
-#ifndef _SHARED_PTR_H
-#define _SHARED_PTR_H
+#ifndef SYM_SHARED_PTR_H_
+#define SYM_SHARED_PTR_H_
 
 
 template <class T> class weak_ptr;
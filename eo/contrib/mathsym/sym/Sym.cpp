@@ -16,6 +16,7 @@
  */
 
 #include <sstream>
+#include <sched.h>
 #include <vector>
 
 #include "Sym.h"
@@ -26,96 +27,35 @@ typedef UniqueNodeStats* (*NodeStatFunc)(Sym&);
 
 UniqueNodeStats* (*Sym::factory)(const Sym&) = 0;
 
-SymMap Sym::dag(100000); // reserve space for so many nodes
-std::vector<unsigned> Sym::token_count;
-	
-
-size_t get_size(const SymVec& vec) {
-    size_t sz = 0;
-    for (unsigned i = 0; i < vec.size(); ++i) {
-	sz += vec[i].size();
-    }
-    return sz;
-}
-
-size_t get_depth(const SymVec& vec) {
-    size_t dp = 1;
-    for (unsigned i = 0; i < vec.size(); ++i) {
-	dp = std::max(dp, vec[i].depth());
+void Sym::init_node(bool created) {
+    if (created) { 
+	// call the factory function if available
+	if (factory) node->uniqueNodeStats = factory(*this);
+	__atomic_store_n(&node->ready, 1, __ATOMIC_RELEASE);
+    } else {
+	while (!__atomic_load_n(&node->ready, __ATOMIC_ACQUIRE)) sched_yield(); // another thread is still creating it
     }
-    return dp;
 }
 
-Sym::Sym(token_t tok, const SymVec& args_) : node(dag.end())
+Sym::Sym(token_t tok, const SymVec& args_) : node(0)
 {
-    detail::SymKey key(tok, detail::SymArgs(args_));
-    detail::SymValue val;
-
-    node = dag.insert(pair<const detail::SymKey, detail::SymValue>(key, val)).first; 
-    
-    if (__unchecked_refcount() == 0) { // new node, set some stats 
-	node->second.size  = 1 + get_size(args_);
-	node->second.depth = 1 + get_depth(args_);
-	
-	// token count
-	if (tok >= token_count.size()) {
-	    token_count.resize(tok+1);
-	}
-	
-	incref();
-	node->first.fixate();	
-	// call the factory function if available
-	if (factory) node->second.uniqueNodeStats = factory(*this);
-    
-    }
-    else incref();
+    bool created;
+    node = dag().acquire(tok, args_, created);
+    init_node(created);
 }
 
-Sym::Sym(token_t tok, const Sym& a) : node(dag.end()) { 
-    SymVec args_; args_.push_back(a); 
-    detail::SymKey key(tok, detail::SymArgs(args_));
-    detail::SymValue val;
-
-    node = dag.insert(pair<const detail::SymKey, detail::SymValue>(key, val)).first; 
-    
-    if (__unchecked_refcount() == 0) { // new node, set some stats 
-	node->second.size = 1 + get_size(args_);
-	node->second.depth = 1 + get_depth(args_);
-	
-	// token count
-	if (tok >= token_count.size()) {
-	    token_count.resize(tok+1);
-	}
-	
-	incref();
-	node->first.fixate();
-	// call the factory function if available
-	if (factory) node->second.uniqueNodeStats = factory(*this);
-    }
-    else incref();
+Sym::Sym(token_t tok, const Sym& a) : node(0) { 
+    SymVec args_(1, a); 
+    bool created;
+    node = dag().acquire(tok, args_, created);
+    init_node(created);
 }
 
-Sym::Sym(token_t tok) : node(dag.end()) {
-    detail::SymKey key(tok);
-    detail::SymValue val;
-    node = dag.insert(pair<const detail::SymKey, detail::SymValue>(key, val)).first; 
-    
-    if (__unchecked_refcount() == 0) { // new node, set some stats 
-	node->second.size = 1;
-	node->second.depth = 1;
-	
-	// token count
-	if (tok >= token_count.size()) {
-	    token_count.resize(tok+1);
-	}
-	
-	incref();
-
-	// call the factory function if available
-	if (factory) node->second.uniqueNodeStats = factory(*this);
-	
-    }
-    else incref();
+Sym::Sym(token_t tok) : node(0) {
+    static const SymVec no_args;
+    bool created;
+    node = dag().acquire(tok, no_args, created);
+    init_node(created);
 }
 
 std::pair<Sym,bool> insert_subtree_impl(const Sym& cur, size_t w, const Sym& nw) {
@@ -19,13 +19,7 @@
 #define SYMNODE_H_
 
 #include <cassert>
-
-#if __GNUC__ >= 3
-#include <backward/hash_map.h>
-#elif __GNUC__ < 3
-#include <hash_map.h>
-using std::hash_map;
-#endif
+#include <unordered_map>
 
 /* Empty 'extra statistics' structure, derive from this to keep other characteristics of nodes */
 struct UniqueNodeStats { virtual ~UniqueNodeStats(){} };
@@ -33,119 +27,109 @@ struct UniqueNodeStats { virtual ~UniqueNodeStats(){} };
 #include "SymImpl.h"
 #include "token.h"
 
-#if __GNUC__ == 4
-#define USE_TR1 1
-#else
-#define USE_TR1 0
-#endif
-// TR1 is buggy at times
-#undef USE_TR1
-#define USE_TR1 0
-
-#if USE_TR1
-#include <tr1/unordered_map>
-typedef std::tr1::unordered_map<detail::SymKey, detail::SymValue, detail::SymKey::Hash> SymMap;
-#else
-typedef hash_map<detail::SymKey, detail::SymValue, detail::SymKey::Hash> SymMap;
-#endif
-
+/* The table of nodes, the maps keyed on syms in the other modules are std::unordered_map with HashSym */
+typedef detail::SymTable SymMap;
 typedef SymMap::iterator SymIterator;
 
 /* Sym is the tree, for which all the nodes are stored in a hash table. 
- * This makes checking for equality O(1) */
+ * This makes checking for equality O(1) 
+ *
+ * Syms can be created, copied and destroyed from several threads at once: 
+ * the table is split in shards with their own lock and the reference counts are atomic. 
+ * */
 class Sym
 {
     public:
 	
-	Sym() : node(dag.end()) {}
+	Sym() : node(0) {}
 	explicit Sym(token_t token, const SymVec& args);
 	explicit Sym(token_t token, const Sym& args);
 	explicit Sym(token_t var);
 	
-	explicit Sym(SymIterator it) : node(it) { incref(); }
+	explicit Sym(detail::SymNode* n) : node(n) { incref(); }
 	
 	Sym(const Sym& oth) : node(oth.node) { incref(); }
 	~Sym() { decref(); }
 	
 	const Sym& operator=(const Sym& oth) {
 	    if (oth.node == node) return *this;
-	    decref();
+	    detail::SymNode* old = node; // released last, it can hold oth
 	    node = oth.node;
 	    incref();
+	    if (old) dag().release(old);
 	    return *this;
 	}
 
 	/* Unique Stats are user defined */
-	UniqueNodeStats* extra_stats() const { return empty()? 0 : node->second.uniqueNodeStats; }
+	UniqueNodeStats* extra_stats() const { return empty()? 0 : node->uniqueNodeStats; }
 	
-	int hashcode() const { return node->first.get_hash_code(); } //detail::SymKey::Hash hash; return hash(node->first); }
+	int hashcode() const { return node->hash_code; } 
 	
-	// Friends, need to touch the node
-	friend struct detail::SymKey::Hash;
-	friend struct detail::SymKey;
-	
-	unsigned refcount() const { return empty()? 0: node->second.refcount; }
+	unsigned refcount() const { return empty()? 0: __atomic_load_n(&node->refcount, __ATOMIC_RELAXED); }
 
 	bool operator==(const Sym& other) const {
 	    return node == other.node;
 	}
 	bool operator!=(const Sym& other) const { return !(*this == other); }
 
-	bool empty() const { return node == dag.end(); }
+	bool empty() const { return node == 0; }
 
 	/* Support for traversing trees */
-	unsigned arity() const { return node->first.arity(); }
-	token_t    token() const { return node->first.token; }
+	unsigned arity() const { return node->args.size(); }
+	token_t    token() const { return node->token; }
 	
-	const SymVec& args() const { return node->first.vec(); }
+	const SymVec& args() const { return node->args; }
 	
 	/* size() - depth */
-	unsigned size() const { return empty()? 0 : node->second.size; }
-	unsigned depth() const { return empty()? 0 : node->second.depth; }
+	unsigned size() const { return empty()? 0 : node->size; }
+	unsigned depth() const { return empty()? 0 : node->depth; }
 	
-	SymMap::iterator iterator() const { return node; }
+	SymIterator iterator() const { return dag().find(node); }
 
 	/* Statics accessing some static members */
-	static SymMap& get_dag() { return dag; }
+	static SymMap& get_dag() { return dag(); }
+	
+	/* Load, distinct nodes and memory of the table, for monitoring */
+	static SymTableStats get_dag_stats() { return dag().stats(); }
 	
 	/* This function can be set to create some UniqueNodeStats derivative that can contain extra stats for a node,
 	 * it can for instance be used to create ERC's and what not. */
 	static void set_factory_function(UniqueNodeStats* (*f)(const Sym&)) { factory=f; } 
 	static void clear_factory_function() { factory = 0; }
 	
-	static const std::vector<unsigned>& token_refcount() { return token_count; }
+	/* The number of distinct live nodes for each token, a copy as other threads can change it */
+	static std::vector<unsigned> token_refcount() { return dag().token_counts(); }
 	
-	unsigned address() const { return reinterpret_cast<unsigned>(&*node); }
+	size_t address() const { return reinterpret_cast<size_t>(node); }
 	
     private :
 	
 	// implements getting subtrees
 	Sym private_get(size_t w) const; 
 	
-	unsigned __unchecked_refcount() const { return node->second.refcount; }
-	
+	// sets the extra stats of a new node, or waits until the thread that created it has
+	void init_node(bool created);
+
 	void incref() {
 	    if (!empty()) {
-		++(node->second.refcount);
-		++token_count[token()];
+		dag().incref(node);
 	    }
 	}
 	void decref() {
 	    if (!empty()) {
-		--token_count[token()];
-		if (--(node->second.refcount) == 0) {
-		    dag.erase(node);
-		}
+		dag().release(node);
 	    }
 	}
 
-	// The one and only data member, an iterator into the static map below
-	SymIterator node;
-	
-	// A static hash_map that contains all live nodes.. 
-	static SymMap dag;
+	// The one and only data member, a node of the static table below
+	detail::SymNode* node;
 	
-	static std::vector<unsigned> token_count;
+	// The static table that contains all live nodes. Created on first use and never destroyed,
+	// so that syms in static storage can be created and released before and after main
+	static SymMap& dag() {
+	    static SymMap* table = new SymMap(100000); // reserve space for so many nodes
+	    return *table;
+	}
 	
 	// Factory function for creating extra node stats, default will be 0
 	static UniqueNodeStats* (*factory)(const Sym&);
@@ -171,7 +155,7 @@ inline Sym next(const Sym& sym) {
     SymIterator it = sym.iterator();
     ++it;
     if (it == Sym::get_dag().end()) it = Sym::get_dag().begin();
-    return Sym(it);
+    return *it;
 }
 
 #endif
@@ -14,55 +14,40 @@
  *          along with this program; if not, write to the Free Software
  *          Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
+#include <sched.h>
+#include <string.h>
+
 #include "Sym.h"
 
 using namespace std;
 namespace detail {
-    
-class SymArgsImpl {
-    public:
-    std::vector<Sym> owned_args;
-};
 
-size_t SymArgs::len() const { 
-    return vec().size(); 
-}
-
-SymArgs::SymArgs() : pimpl( new SymArgsImpl ) {
-    args_ptr = &pimpl->owned_args;
+size_t get_size(const SymVec& vec) {
+    size_t sz = 0;
+    for (unsigned i = 0; i < vec.size(); ++i) {
+	sz += vec[i].size();
+    }
+    return sz;
 }
 
-SymArgs::SymArgs(const std::vector<Sym>& v) : pimpl(0) {
-    args_ptr = &v;
+size_t get_depth(const SymVec& vec) {
+    size_t dp = 1;
+    for (unsigned i = 0; i < vec.size(); ++i) {
+	dp = std::max<size_t>(dp, vec[i].depth());
+    }
+    return dp;
 }
 
-SymArgs::~SymArgs() { 
-    delete pimpl; 
-}
+SymNode::SymNode(token_t _token, const SymVec& _args, unsigned _hash_code) 
+    : token(_token), args(_args), hash_code(_hash_code), refcount(1), 
+    size(1 + get_size(_args)), depth(_args.empty()? 1 : 1 + get_depth(_args)), uniqueNodeStats(0), ready(0) {}
 
-SymArgs::SymArgs(const SymArgs& args) : pimpl(0), args_ptr(args.args_ptr) {
-    if (args.pimpl && args.args_ptr == &args.pimpl->owned_args) {
-	pimpl = new SymArgsImpl(*args.pimpl);
-	args_ptr = &pimpl->owned_args; 
-    } 
-}
+SymNode::~SymNode() { delete uniqueNodeStats; }
 
-SymArgs& SymArgs::operator=(const SymArgs& args) {
-    if (args.pimpl && args.args_ptr == &args.pimpl->owned_args) {
-	pimpl = new SymArgsImpl(*args.pimpl);
-	args_ptr = &pimpl->owned_args;
-    } else {
-	args_ptr = args.args_ptr;
+void SymLock::lock() {
+    while (__atomic_exchange_n(&locked, 1, __ATOMIC_ACQUIRE)) {
+	while (__atomic_load_n(&locked, __ATOMIC_RELAXED)) sched_yield();
     }
-
-    return *this;
-}
-
-void SymArgs::fixate() const {
-    assert(pimpl == 0);
-    pimpl = new SymArgsImpl;
-    pimpl->owned_args = *args_ptr;
-    args_ptr = &pimpl->owned_args;
 }
 
 // For Tackett's hashcode
@@ -72,21 +57,22 @@ void SymArgs::fixate() const {
 const int nprimes = 4;
 const unsigned long primes[] = {3221225473ul, 201326611ul, 1610612741ul, 805306457ul};
     
-int SymKey::calc_hash() const {
+unsigned calc_hash(token_t token, const SymVec& v) {
     unsigned long hash = unsigned(token);
     hash *= PRIMET;
     
-    const std::vector<Sym>& v = args.vec();
     for (unsigned i = 0; i < v.size(); ++i) {
 	hash += ( (v[i].address() >> 3) * primes[i%nprimes]) % HASHMOD;
     }
-
-    return hash;// % HASHMOD;
-}
-
-bool SymKey::operator==(const SymKey& other) const {
-    if (token != other.token) return false;
-    return args.vec() == other.args.vec();
+    
+    // final mix (from murmur3), the high bits select the shard and the low bits the slot
+    unsigned h = unsigned(hash ^ (hash >> 32));
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
 }
 
 /* Just to store this info somewhere:
@@ -100,10 +86,226 @@ bool SymKey::operator==(const SymKey& other) const {
  *  }
  */     
 
-SymValue::SymValue() : refcount(0), size(0), depth(0), uniqueNodeStats(0)  {}
+SymNode* const tombstone = reinterpret_cast<SymNode*>(1);
+
+inline bool live(const SymNode* node) { return node > tombstone; }
+
+SymTable::SymTable(size_t reserve) : max_token(0) {
+    memset(token_chunks, 0, sizeof(token_chunks));
+    
+    size_t capacity = 16;
+    while (capacity * n_shards < 2 * reserve) capacity *= 2;
+    
+    for (unsigned i = 0; i < n_shards; ++i) {
+	rehash(shards[i], capacity);
+    }
+}
+
+SymTable::~SymTable() {
+    // nodes still alive at exit are left alone, static syms elsewhere can refer to them
+    for (unsigned i = 0; i < n_shards; ++i) {
+	delete [] shards[i].slots;
+    }
+    for (unsigned i = 0; i < max_token_chunks; ++i) {
+	delete [] token_chunks[i];
+    }
+}
 
-SymValue::~SymValue() { delete uniqueNodeStats; }
+void SymTable::rehash(SymShard& shard, size_t capacity) {
+    SymNode** slots = new SymNode*[capacity];
+    memset(slots, 0, capacity * sizeof(SymNode*));
 
+    for (size_t i = 0; i < shard.capacity; ++i) {
+	SymNode* node = shard.slots[i];
+	if (!live(node)) continue;
+	
+	size_t j = node->hash_code & (capacity-1);
+	while (slots[j]) j = (j+1) & (capacity-1);
+	slots[j] = node;
+    }
+    
+    delete [] shard.slots;
+    shard.slots = slots;
+    shard.capacity = capacity;
+    shard.tombstones = 0;
+}
 
+SymNode* SymTable::acquire(token_t token, const SymVec& args, bool& created) {
+    unsigned hash = calc_hash(token, args);
+    SymShard& shard = shard_of(hash);
+    
+    shard.mutex.lock();
+    
+    size_t mask = shard.capacity - 1;
+    size_t free_slot = shard.capacity;
+    size_t i = hash & mask;
+    
+    for (;;) {
+	SymNode* node = shard.slots[i];
+	
+	if (node == 0) break;
+	
+	if (node == tombstone) {
+	    if (free_slot == shard.capacity) free_slot = i;
+	} else if (node->hash_code == hash && node->token == token && node->args == args) {
+	    // the lock keeps the node from being erased before the reference is taken
+	    incref(node); 
+	    shard.mutex.unlock();
+	    created = false;
+	    return node;
+	}
+	
+	i = (i+1) & mask;
+    }
+    
+    if (free_slot == shard.capacity) { // takes an empty slot
+	if (4 * (shard.nodes + shard.tombstones + 1) > 3 * shard.capacity) {
+	    // grows if more than half of the slots are live, otherwise only clears the tombstones
+	    rehash(shard, 2 * shard.nodes >= shard.capacity ? 2 * shard.capacity : shard.capacity);
+	    mask = shard.capacity - 1;
+	    i = hash & mask;
+	    while (shard.slots[i]) i = (i+1) & mask;
+	}
+	free_slot = i;
+    } else {
+	--shard.tombstones;
+    }
+    
+    SymNode* node = new SymNode(token, args, hash);
+    shard.slots[free_slot] = node;
+    ++shard.nodes;
+    
+    shard.mutex.unlock();
+    
+    count_token(token, 1);
+    created = true;
+    return node;
+}
+
+void SymTable::release(SymNode* node) {
+    // not the last reference: no need to lock
+    for (;;) {
+	unsigned count = __atomic_load_n(&node->refcount, __ATOMIC_RELAXED);
+	if (count <= 1) break;
+	if (__atomic_compare_exchange_n(&node->refcount, &count, count-1, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) return;
+    }
+    
+    SymShard& shard = shard_of(node->hash_code);
+    shard.mutex.lock();
+    
+    if (__atomic_sub_fetch(&node->refcount, 1, __ATOMIC_ACQ_REL) != 0) { // taken again in the meantime
+	shard.mutex.unlock();
+	return;
+    }
+    
+    size_t mask = shard.capacity - 1;
+    size_t i = node->hash_code & mask;
+    while (shard.slots[i] != node) i = (i+1) & mask;
+    
+    shard.slots[i] = tombstone;
+    --shard.nodes;
+    ++shard.tombstones;
+    
+    shard.mutex.unlock();
+    
+    count_token(node->token, -1);
+    delete node; // releases the arguments, outside of the lock as they can be in this shard as well
+}
+
+void SymTable::count_token(token_t token, int delta) {
+    unsigned chunk = token >> token_chunk_bits;
+    unsigned* counts = __atomic_load_n(&token_chunks[chunk], __ATOMIC_ACQUIRE);
+    
+    if (counts == 0) {
+	token_lock.lock();
+	counts = token_chunks[chunk];
+	if (counts == 0) {
+	    counts = new unsigned[1 << token_chunk_bits];
+	    memset(counts, 0, sizeof(unsigned) << token_chunk_bits);
+	    __atomic_store_n(&token_chunks[chunk], counts, __ATOMIC_RELEASE);
+	}
+	token_lock.unlock();
+    }
+    
+    unsigned mx = __atomic_load_n(&max_token, __ATOMIC_RELAXED);
+    while (token >= mx && !__atomic_compare_exchange_n(&max_token, &mx, token+1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+
+    __atomic_fetch_add(&counts[token & ((1 << token_chunk_bits) - 1)], delta, __ATOMIC_RELAXED);
+}
+
+vector<unsigned> SymTable::token_counts() const {
+    vector<unsigned> counts(__atomic_load_n(&max_token, __ATOMIC_RELAXED));
+    for (unsigned i = 0; i < counts.size(); ++i) {
+	unsigned* chunk = __atomic_load_n(&token_chunks[i >> token_chunk_bits], __ATOMIC_ACQUIRE);
+	if (chunk) counts[i] = __atomic_load_n(&chunk[i & ((1 << token_chunk_bits) - 1)], __ATOMIC_RELAXED);
+    }
+    return counts;
+}
+
+size_t SymTable::size() const {
+    size_t sz = 0;
+    for (unsigned i = 0; i < n_shards; ++i) {
+	SymShard& shard = const_cast<SymShard&>(shards[i]);
+	shard.mutex.lock();
+	sz += shard.nodes;
+	shard.mutex.unlock();
+    }
+    return sz;
+}
+
+SymTableStats SymTable::stats() const {
+    SymTableStats result;
+    result.nodes = 0;
+    result.slots = 0;
+    result.tombstones = 0;
+    result.memory = sizeof(SymTable);
+   
+    for (unsigned i = 0; i < n_shards; ++i) {
+	SymShard& shard = const_cast<SymShard&>(shards[i]);
+	shard.mutex.lock();
+	
+	result.nodes += shard.nodes;
+	result.slots += shard.capacity;
+	result.tombstones += shard.tombstones;
+	result.memory += shard.capacity * sizeof(SymNode*);
+	
+	for (size_t j = 0; j < shard.capacity; ++j) {
+	    if (live(shard.slots[j])) {
+		result.memory += sizeof(SymNode) + shard.slots[j]->args.capacity() * sizeof(Sym);
+	    }
+	}
+	
+	shard.mutex.unlock();
+    }
+    
+    return result;
+}
+
+SymTable::iterator SymTable::find(const SymNode* node) const {
+    if (node == 0) return end();
+    
+    unsigned sh = node->hash_code >> 26;
+    const SymShard& shard = shards[sh];
+    size_t mask = shard.capacity - 1;
+    size_t i = node->hash_code & mask;
+    while (shard.slots[i] != node) i = (i+1) & mask;
+    
+    return iterator(this, sh, i);
+}
+
+Sym SymTable::iterator::operator*() const {
+    return Sym(table->shards[shard].slots[slot]);
+}
+
+void SymTable::iterator::skip() {
+    while (shard < n_shards) {
+	const SymShard& sh = table->shards[shard];
+	while (slot < sh.capacity && !live(sh.slots[slot])) ++slot;
+	if (slot < sh.capacity) return;
+	++shard;
+	slot = 0;
+    }
+    slot = 0; // end
+}
 
 } // namespace detail
@@ -18,94 +18,154 @@
 #define __SYM_IMPL_H__
 
 #include <vector>
+#include <cstddef>
 
 #include "token.h"
 
 class Sym;
 
-#if __GNUC__ > 4 
-#include <ext/pool_allocator.h>
-typedef std::vector<Sym, __gnu_cxx::__pool_alloc<Sym> > std::vector<Sym>;
-//typedef std::vector<Sym> SymVec;
-#else
 typedef std::vector<Sym> SymVec;
-#endif
 
 
+/* Statistics of the table of nodes, for monitoring */
+struct SymTableStats 
+{
+    size_t nodes;      // distinct live subtrees
+    size_t slots;      // slots in all shards
+    size_t tombstones; // slots of erased nodes, reused by the next insertions
+    size_t memory;     // bytes taken by the slots, the nodes and their arguments
+    
+    double load() const { return slots? double(nodes + tombstones) / slots : 0.0; }
+};
+
 namespace detail {
 
-class SymArgsImpl;
-class SymArgs {
+/* A node of the table: the function with its arguments, and some stats. A node does not move
+ * once created, so that a Sym is just a pointer to it */
+struct SymNode
+{
+    SymNode(token_t _token, const std::vector<Sym>& _args, unsigned _hash_code);
+    ~SymNode();
     
-    mutable SymArgsImpl* pimpl; // contains circular reference to vector<Sym>
-    mutable const std::vector<Sym>* args_ptr;
+    token_t token;     // identifies the function
+    std::vector<Sym> args;
+    unsigned hash_code;
+   
+    // for reference counting, only changed atomically
+    unsigned refcount;
     
-    public:
+    // some simple stats
+    unsigned size;
+    unsigned depth;
+    UniqueNodeStats* uniqueNodeStats;
+    
+    // set when the extra stats have been computed by the thread that created the node
+    int ready;
+    
+    private:
+    SymNode(const SymNode&);
+    SymNode& operator=(const SymNode&);
+};
 
-    SymArgs();
-    SymArgs(const std::vector<Sym>& v);
-    ~SymArgs();
+/* Spin lock for the shards, which are only held for a lookup or an insertion */
+class SymLock 
+{
+    int locked;
+    public:
+    SymLock() : locked(0) {}
+    void lock();
+    void unlock() { __atomic_store_n(&locked, 0, __ATOMIC_RELEASE); }
+};
 
-    SymArgs(const SymArgs& args);
-    SymArgs& operator=(const SymArgs& other);
+/* One part of the table: open addressing with linear probing over a power of two of slots */
+struct SymShard 
+{
+    SymShard() : slots(0), capacity(0), nodes(0), tombstones(0) {}
+    
+    SymLock   mutex;
+    SymNode** slots;     // 0 for empty, tombstone for erased
+    size_t    capacity;
+    size_t    nodes;
+    size_t    tombstones;
 
-    size_t len() const;
-    const std::vector<Sym>& vec() const { return *args_ptr; }
-    void fixate() const;
+    char padding[64]; // keeps the locks of the shards on different cache lines
 };
 
-class SymKey
+/* The table with all the nodes, hash-consing them: an insertion of a node that exists returns the existing one.
+ * The shard of a node is selected by its hash code, so that threads creating and destroying 
+ * different nodes seldom wait for each other */
+class SymTable 
 {
     public:
-	SymKey(token_t _token) : args(), token(_token), hash_code(calc_hash()) {}
-	SymKey(token_t _token, const detail::SymArgs& _args) : args(_args), token(_token), hash_code(calc_hash()) {}
 	
-	bool operator==(const SymKey& other) const;
+	enum { n_shards = 64 };
+	
+	/* reserves space for so many nodes */
+	SymTable(size_t reserve = 0);
+	~SymTable();
+	
+	/* finds the node or inserts a new one, returns it with a reference taken. */
+	SymNode* acquire(token_t token, const std::vector<Sym>& args, bool& created);
+	
+	void incref(SymNode* node) { __atomic_fetch_add(&node->refcount, 1, __ATOMIC_RELAXED); }
 	
-	struct Hash
+	/* drops a reference, the last one erases the node */
+	void release(SymNode* node);
+	
+	/* number of distinct live nodes */
+	size_t size() const;
+	
+	SymTableStats stats() const;
+	
+	/* number of live nodes with each token */
+	std::vector<unsigned> token_counts() const;
+	
+	/* Iteration over the nodes, only valid while no other thread changes the table */
+	class iterator 
 	{
-	    int operator()(const SymKey& k) const { return k.calc_hash(); }; 
+	    public:
+		iterator() : table(0), shard(n_shards), slot(0) {}
+		iterator(const SymTable* t, unsigned sh, size_t sl) : table(t), shard(sh), slot(sl) { skip(); }
+		
+		Sym operator*() const;
+		iterator& operator++() { ++slot; skip(); return *this; }
+		
+		bool operator==(const iterator& other) const { return shard == other.shard && slot == other.slot; }
+		bool operator!=(const iterator& other) const { return !(*this == other); }
+		
+	    private:
+		void skip(); // advances to a live node or to the end
+		
+		const SymTable* table;
+		unsigned shard;
+		size_t slot;
 	};
 	
-	unsigned arity() const { return args.len(); }
-	const std::vector<Sym>& vec() const { return args.vec(); }
+	iterator begin() const { return iterator(this, 0, 0); }
+	iterator end() const { return iterator(); }
+	iterator find(const SymNode* node) const;
 	
-	// fixates (i.e. claims memory) for the embedded vector of Syms
-	void fixate() const { args.fixate(); }
+    private:
 	
-	int get_hash_code() const { return hash_code; }
+	SymShard& shard_of(unsigned hash) { return shards[hash >> 26]; } // 2^6 shards 
 	
-	detail::SymArgs args;
-	token_t token;     // identifies the function
-
-    private:
-	int calc_hash() const;
-	int hash_code;
-};
-
-struct SymValue
-{
-    friend class Sym;
-     
-    SymValue();
-    ~SymValue(); 
-    
-    unsigned getRefCount() const { return refcount; }
-    unsigned getSize() const     { return size; }
-    unsigned getDepth() const    { return depth; }
-    
-     
-    
-    // for reference counting
-    unsigned refcount;
-    
-    // some simple stats
-    unsigned size;
-    unsigned depth;
-    UniqueNodeStats* uniqueNodeStats;
-    
+	void rehash(SymShard& shard, size_t capacity);
+	
+	void count_token(token_t token, int delta);
+	
+	SymShard shards[n_shards];
+	
+	// counts of live nodes per token, allocated by chunks that never move
+	enum { token_chunk_bits = 12, max_token_chunks = 4096 };
+	unsigned* token_chunks[max_token_chunks];
+	unsigned max_token;
+	SymLock token_lock;
+	
+	SymTable(const SymTable&);
+	SymTable& operator=(const SymTable&);
 };
 
+unsigned calc_hash(token_t token, const std::vector<Sym>& args);
 
 } // namespace detail
 
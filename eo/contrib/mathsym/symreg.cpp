@@ -100,6 +100,15 @@ class DagSizeStat : public eoStat<EoType, unsigned> {
 	}
 };
 
+class DagLoadStat : public eoStat<EoType, double> {
+    public:
+	DagLoadStat() : eoStat<EoType, double>(0.0, "Load of the table of subtrees") {}
+
+	void operator()(const eoPop<EoType>& _pop) {
+	    value() = Sym::get_dag_stats().load();
+	}
+};
+
 int main(int argc, char* argv[]) {
    
     eoParser parser(argc, argv);
@@ -312,11 +321,13 @@ int main(int argc, char* argv[]) {
     eoBestIndividualStat printer;
     AverageSizeStat avgSize;
     DagSizeStat dagSize;
+    DagLoadStat dagLoad;
     SumSizeStat sumSize;
     
     checkpoint.add(printer);
     checkpoint.add(avgSize);
     checkpoint.add(dagSize);
+    checkpoint.add(dagLoad);
     checkpoint.add(sumSize);
     
     eoStdoutMonitor genmon;
@@ -324,6 +335,7 @@ int main(int argc, char* argv[]) {
     genmon.add(printer);
     genmon.add(avgSize);
     genmon.add(dagSize);
+    genmon.add(dagLoad);
     genmon.add(sumSize);
     genmon.add(term); // add generation counter
     
@@ -177,7 +177,7 @@ void test_xover() {
     SymMap& dag = Sym::get_dag();
 
     for (SymMap::iterator it = dag.begin(); it != dag.end(); ++it) {
-	Sym s(it);
+	Sym s = *it;
 	cout << s << ' ' << s.refcount() << endl;
     }
     
@@ -0,0 +1,135 @@
+/*
+ *             Copyright (C) 2005 Maarten Keijzer
+ *
+ *          This program is free software; you can redistribute it and/or modify
+ *          it under the terms of version 2 of the GNU General Public License as
+ *          published by the Free Software Foundation.
+ *
+ *          This program is distributed in the hope that it will be useful,
+ *          but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *          GNU General Public License for more details.
+ *
+ *          You should have received a copy of the GNU General Public License
+ *          along with this program; if not, write to the Free Software
+ *          Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <iostream>
+
+#include "Sym.h"
+
+using namespace std;
+
+/* Several threads create, copy and destroy trees over the same nodes */
+
+const unsigned n_threads = 4;
+const unsigned pool_size = 200;
+
+// token 0 and 1 are terminals, 2 and 3 binary functions
+Sym random_tree(unsigned& seed, unsigned depth) {
+    if (depth == 0 || rand_r(&seed) % 3 == 0) return Sym(token_t(rand_r(&seed) % 2));
+
+    SymVec args(2);
+    args[0] = random_tree(seed, depth-1);
+    args[1] = random_tree(seed, depth-1);
+    return Sym(token_t(2 + rand_r(&seed) % 2), args);
+}
+
+// the same tree in every thread
+Sym fixed_tree(unsigned depth) {
+    if (depth == 0) return Sym(token_t(0));
+    SymVec args(2);
+    args[0] = fixed_tree(depth-1);
+    args[1] = Sym(token_t(1));
+    return Sym(token_t(2 + depth % 2), args);
+}
+
+// created before main and released after it, the table must outlive it
+Sym static_tree(token_t(4), Sym(token_t(5)));
+
+struct Work {
+    unsigned seed;
+    Sym fixed;
+};
+
+void* run(void* arg) {
+    Work* work = static_cast<Work*>(arg);
+    vector<Sym> pool(pool_size);
+
+    for (unsigned i = 0; i < 20000; ++i) {
+	unsigned w = rand_r(&work->seed) % pool_size;
+	switch (rand_r(&work->seed) % 3) {
+	    case 0 : pool[w] = random_tree(work->seed, 6); break;
+	    case 1 : pool[w] = pool[rand_r(&work->seed) % pool_size]; break;
+	    case 2 : if (!pool[w].empty() && pool[w].arity()) pool[w] = pool[w].args()[0]; break;
+	}
+    }
+
+    work->fixed = fixed_tree(10);
+    return 0;
+}
+
+int main() {
+    SymMap& dag = Sym::get_dag();
+    size_t before = dag.size();
+
+    vector<Work> work(n_threads);
+    vector<pthread_t> threads(n_threads);
+
+    for (unsigned t = 0; t < n_threads; ++t) {
+	work[t].seed = 42 + t;
+	pthread_create(&threads[t], 0, run, &work[t]);
+    }
+    for (unsigned t = 0; t < n_threads; ++t) {
+	pthread_join(threads[t], 0);
+    }
+
+    for (unsigned t = 1; t < n_threads; ++t) {
+	if (work[t].fixed != work[0].fixed) {
+	    cout << "Threads created different nodes for the same tree" << endl;
+	    return 1;
+	}
+    }
+
+    if (work[0].fixed.refcount() != n_threads) {
+	cout << "Wrong reference count " << work[0].fixed.refcount() << endl;
+	return 1;
+    }
+
+    // only the fixed tree is still alive: one node per level and the two terminals
+    if (dag.size() != before + 12) {
+	cout << "Table holds " << dag.size() - before << " nodes instead of 12" << endl;
+	return 1;
+    }
+
+    unsigned n = 0;
+    for (SymIterator it = dag.begin(); it != dag.end(); ++it) ++n;
+
+    SymTableStats stats = Sym::get_dag_stats();
+    cout << "nodes " << stats.nodes << " slots " << stats.slots << " load " << stats.load() << " memory " << stats.memory << endl;
+
+    if (n != dag.size() || stats.nodes != n || stats.load() > 0.75) {
+	cout << "Inconsistent table" << endl;
+	return 1;
+    }
+
+    vector<unsigned> counts = Sym::token_refcount();
+    if (counts.size() < 4 || counts[0] != 1 || counts[1] != 1 || counts[2] + counts[3] != 10) {
+	cout << "Wrong token counts" << endl;
+	return 1;
+    }
+
+    for (unsigned t = 0; t < n_threads; ++t) work[t].fixed = Sym();
+
+    if (dag.size() != before) {
+	cout << "Nodes left in the table" << endl;
+	return 1;
+    }
+
+    cout << "table ok" << endl;
+    return 0;
+}
+
@@ -0,0 +1,104 @@
+/*
+ *             Copyright (C) 2005 Maarten Keijzer
+ *
+ *          This program is free software; you can redistribute it and/or modify
+ *          it under the terms of version 2 of the GNU General Public License as
+ *          published by the Free Software Foundation.
+ *
+ *          This program is distributed in the hope that it will be useful,
+ *          but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *          MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *          GNU General Public License for more details.
+ *
+ *          You should have received a copy of the GNU General Public License
+ *          along with this program; if not, write to the Free Software
+ *          Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <iostream>
+
+#include <FunDef.h>
+#include <sym_compile.h>
+#include <sym_jit.h>
+
+using namespace std;
+
+bool same(double a, double b) {
+    if (a == b) return true; // infinities
+    if (isnan(a) || isnan(b)) return isnan(a) && isnan(b);
+    return fabs(a - b) <= 1e-12 * (1.0 + fabs(b));
+}
+
+int main() {
+    Sym x = SymVar(0);
+    Sym y = SymVar(1);
+    Sym c = SymConst(0.5);
+
+    SymVec args3(3);
+    args3[0] = x - y;
+    args3[1] = sin(x);
+    args3[2] = cos(y);
+
+    SymVec args2(2);
+    args2[0] = sqr(x) + c;
+    args2[1] = y;
+
+    vector<Sym> pop;
+    pop.push_back(x);
+    pop.push_back(c);
+    pop.push_back(x + y * c);
+    pop.push_back(inv(x) - sqrt(sqr(y)));
+    pop.push_back(exp(tanh(x)) * log(sqr(y) + c));
+    pop.push_back(Sym(pow_token, args2));
+    pop.push_back(Sym(ifltz_token, args3));
+    pop.push_back(atan(x) + asinh(y) + acos(c) + cosh(x * c));
+    pop.push_back(SymLambda(sin(x) * sin(x) + y) * x); // through a lambda function
+
+    vector<single_function> funcs;
+    compile(pop, funcs);
+    multi_function all = compile(pop);
+
+    vector<double> out(pop.size());
+    vector<double> in(2);
+
+    for (unsigned k = 0; k < 50; ++k) {
+	in[0] = -2.5 + 0.1 * k;
+	in[1] = 1.5 - 0.07 * k;
+
+	all(&in[0], &out[0]);
+
+	for (unsigned i = 0; i < pop.size(); ++i) {
+	    double e = eval(pop[i], in);
+	    double f = funcs[i](&in[0]);
+	    if (!same(f, e) || !same(out[i], e)) {
+		cout << "Compiled " << pop[i] << " gives " << f << " and " << out[i] << " instead of " << e << endl;
+		return 1;
+	    }
+	}
+    }
+
+#ifdef SYM_JIT
+    // a sym is compiled once
+    single_function f = compile(pop[4]);
+    if (f != funcs[4]) {
+	cout << "Function was compiled again" << endl;
+	return 1;
+    }
+
+    // the cache does not keep a sym alive once the population has dropped it
+    Sym child = sin(x) + SymConst(0.25);
+    compile(cos(child));
+    for (unsigned i = 0; i < 5000; ++i) {
+	compile(x * SymConst(1.0 + i));
+    }
+    if (child.refcount() != 1) {
+	cout << "The compile cache keeps dead syms" << endl;
+	return 1;
+    }
+#endif
+
+    cout << "all compiled functions agree" << endl;
+    return 0;
+}
+
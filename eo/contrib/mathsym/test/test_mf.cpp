@@ -1,4 +1,5 @@
 
+#include <cmath>
 #include "Sym.h"
 #include "MultiFunction.h"
 #include "FunDef.h"
@@ -41,5 +42,32 @@ int main() {
     cout << "4 " << eval(b, vec) << endl;
     cout << "5 " << eval(c, vec) << endl;
     
+    // batch evaluation, on more records than a block
+    pop.push_back(a);
+    pop.push_back(sin(v) * exp(b));
+    MultiFunction mb(pop);
+    
+    unsigned n = 100;
+    vector< vector<double> > records(n, vector<double>(1));
+    vector<const double*> x(n);
+    for (unsigned r = 0; r < n; ++r) {
+	records[r][0] = r + 1.0;
+	x[r] = &records[r][0];
+    }
+    
+    vector<double> yb(pop.size() * n);
+    mb(&x[0], n, &yb[0]);
+    
+    for (unsigned i = 0; i < pop.size(); ++i) {
+	for (unsigned r = 0; r < n; ++r) {
+	    double e = eval(pop[i], records[r]);
+	    if (fabs(yb[i * n + r] - e) > 1e-9 * fabs(e)) {
+		cout << "Batch evaluation of " << pop[i] << " on " << records[r][0] << " gives " << yb[i * n + r] << " instead of " << e << endl;
+		return 1;
+	    }
+	}
+    }
+    
+    cout << "batch ok" << endl;
 }
 
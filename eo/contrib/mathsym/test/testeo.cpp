@@ -28,6 +28,10 @@
 #include <eoSymCrossover.h>
 #include <eoSymEval.h>
 
+#include <iostream>
+
+using namespace std;
+
 typedef EoSym<double> EoType;
 
 int main() {
@@ -29,6 +29,7 @@
 #include <utils/eoParallel.h>
 #include <utils/eoParser.h>
 #include <utils/eoLogger.h>
+#include <utils/eoRNG.h>
 #include <eoFunctor.h>
 #include <vector>
 
@@ -36,9 +37,90 @@
 #include <omp.h>
 #endif
 
+#if __cplusplus >= 201103L
+#include <exception>
+#endif
+
+/**
+  Runs the iterations of a parallel apply, and keeps the first exception
+  thrown by one of them: an exception can not leave an OpenMP region, it
+  is thrown again by rethrow once the loop is over. The iterations that
+  come after the exception, in any thread, are skipped, so that for
+  instance a budget of evaluations stops the whole loop.
+
+  Needs C++11 (std::exception_ptr), otherwise the iterations are simply run.
+
+  @ingroup Utilities
+*/
+class eoParallelApplyGuard
+{
+public:
+
+    eoParallelApplyGuard() : failed(false) {}
+
+    template <class EOT>
+    void run(eoUF<EOT&, void>& _proc, EOT& _eo)
+    {
+#if __cplusplus >= 201103L
+        bool stop;
+#ifdef _OPENMP
+#pragma omp atomic read
+#endif
+        stop = failed;
+        if (stop)
+            return;
+
+        try
+        {
+            _proc(_eo);
+        }
+        catch (...)
+        {
+#ifdef _OPENMP
+#pragma omp critical(eoParallelApplyGuard)
+#endif
+            {
+                if (!failed)
+                    error = std::current_exception();
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+                failed = true;
+            }
+        }
+#else
+        _proc(_eo);
+#endif
+    }
+
+    /** throws the exception of the loop, if any */
+    void rethrow()
+    {
+#if __cplusplus >= 201103L
+        if (failed)
+            std::rethrow_exception(error);
+#endif
+    }
+
+private:
+
+    bool failed;
+#if __cplusplus >= 201103L
+    std::exception_ptr error;
+#endif
+};
+
 /**
   Applies a unary function to a std::vector of things.
 
+  When the loop is parallelized, each thread draws its random numbers from
+  its own stream of eo::rngPool (see eo::threadRng), so that stochastic
+  functions can safely be applied. With a static distribution of the work
+  (--parallelize-dynamic=0), results are reproducible for a given seed and
+  number of threads. An exception thrown while applying the function to an
+  element stops the loop in all the threads, and is thrown again once it is
+  over (see eoParallelApplyGuard).
+
   @ingroup Utilities
 */
 template <class EOT>
@@ -55,15 +137,22 @@ void apply(eoUF<EOT&, void>& _proc, std::vector<EOT>& _pop)
         t1 = omp_get_wtime();
     }
 
+    if ( eo::parallel.isEnabled() )
+    {
+        eo::rngPool.reserve( omp_get_max_threads() );
+    }
+
+    eoParallelApplyGuard guard;
+
     if (!eo::parallel.isDynamic())
     {
-#pragma omp parallel for if(eo::parallel.isEnabled()) //default(none) shared(_proc, _pop, size)
+#pragma omp parallel for schedule(static) if(eo::parallel.isEnabled()) //default(none) shared(_proc, _pop, size)
 #ifdef _MSC_VER
         //Visual Studio supports only OpenMP version 2.0 in which
         //an index variable must be of a signed integral type
-        for (long long i = 0; i < size; ++i) { _proc(_pop[i]); }
+        for (long long i = 0; i < size; ++i) { guard.run(_proc, _pop[i]); }
 #else // _MSC_VER
-        for (size_t i = 0; i < size; ++i) { _proc(_pop[i]); }
+        for (size_t i = 0; i < size; ++i) { guard.run(_proc, _pop[i]); }
 #endif
     }
     else
@@ -72,11 +161,11 @@ void apply(eoUF<EOT&, void>& _proc, std::vector<EOT>& _pop)
 #ifdef _MSC_VER
         //Visual Studio supports only OpenMP version 2.0 in which
         //an index variable must be of a signed integral type
-        for (long long i = 0; i < size; ++i) { _proc(_pop[i]); }
+        for (long long i = 0; i < size; ++i) { guard.run(_proc, _pop[i]); }
 #else // _MSC_VER
         //doesnot work with gcc 4.1.2
         //default(none) shared(_proc, _pop, size)
-        for (size_t i = 0; i < size; ++i) { _proc(_pop[i]); }
+        for (size_t i = 0; i < size; ++i) { guard.run(_proc, _pop[i]); }
 #endif
     }
 
@@ -87,6 +176,8 @@ void apply(eoUF<EOT&, void>& _proc, std::vector<EOT>& _pop)
         log << eo::file(eo::parallel.prefix()) << t2 - t1 << ' ';
     }
 
+    guard.rethrow();
+
 #else // _OPENMP
 
     for (size_t i = 0; i < size; ++i) { _proc(_pop[i]); }
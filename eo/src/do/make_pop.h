@@ -97,6 +97,7 @@ eoPop<EOT>&  do_make_pop(eoParser & _parser, eoState& _state, eoInit<EOT> & _ini
   else				// nothing loaded from a file
     {
       rng.reseed(seedParam.value());
+      eo::rngPool.reseed(seedParam.value());
     }
 
   if (pop.size() < popSize.value()) // missing some guys
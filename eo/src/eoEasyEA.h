@@ -261,7 +261,7 @@ template<class EOT> class eoEasyEA: public eoAlgo<EOT>
             {
                 unsigned pSize = _pop.size();
 
-                offspring.clear(); // new offspring
+                offspring.recycle(); // new offspring, in the storage of the previous ones
 
                 breed(_pop, offspring);
 
@@ -40,7 +40,9 @@ at each _evaluation_, instead of using continuators at each _iteration_.
 The class first call the evaluation function, then check the number of
 times it has been called. If the maximum number of evaluation has been
 reached, it throw an eoMaxEvalException. You can catch this exception
-from your main function, so as to stop everything properly.
+from your main function, so as to stop everything properly. When the
+evaluations are run by a parallel apply, the exception stops all the
+threads and is thrown again by apply.
 
 @ingroup Evaluation
 */
@@ -62,17 +64,22 @@ public :
 
             // increment the value of the self parameter
             // (eoEvalFuncCounter inherits from @see eoValueParam)
-            value()++;
+            unsigned long count = this->increment();
 
             // if we have reached the maximum
-            if ( value() >= _threshold ) {
+            if ( count >= _threshold ) {
+
+                // other threads may have gone past the maximum, the counter stops on it
+                if ( count > _threshold ) {
+                    this->increment( -1 );
+                }
 
                 // go back through the stack until catched
                 throw eoMaxEvalException(_threshold);
             }
 
             // evaluate
-            func(eo);
+            this->func(eo);
 
         } // if invalid
     }
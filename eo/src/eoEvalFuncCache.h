@@ -0,0 +1,309 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+//-----------------------------------------------------------------------------
+// eoEvalFuncCache.h
+/*
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+    Contact: http://eodev.sourceforge.net
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef eoEvalFuncCache_H
+#define eoEvalFuncCache_H
+
+#include <stdint.h>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <eoEvalFunc.h>
+#include <utils/eoStat.h>
+
+/**
+  Remembers the fitnesses of the last evaluated genomes, and gives them back
+  instead of calling the wrapped evaluator again when a genome comes back,
+  as often happens with low mutation rates on bitstrings or permutations.
+
+  It works with individuals deriving from eoVector. The genes are hashed
+  with FNV-1a, and the fitness is only given back when the whole genome is
+  equal to the cached one. The cache holds a bounded number of genomes, in
+  sets of a few entries chosen by the hash: when a set is full, its entry to
+  replace is chosen by the CLOCK algorithm (an approximation of least
+  recently used).
+
+  It can be used by the threads of a parallel apply: each set is protected
+  by one of a fixed number of OpenMP locks, and the evaluations themselves
+  run outside of them. In eo::mpi::ParallelApply, give it to the workers:
+  each of them then keeps its own cache.
+
+  Example:
+
+    MyEval true_eval;
+    eoEvalFuncCache<T> cached_eval( true_eval, 100000 );
+    eoEvalCacheStat<T> cache_stat( cached_eval );
+    checkpoint.add( cache_stat );
+
+  @ingroup Evaluation
+*/
+template<class EOT> class eoEvalFuncCache : public eoEvalFunc<EOT>
+{
+    public :
+        typedef typename EOT::AtomType AtomType;
+        typedef typename EOT::Fitness Fitness;
+        typedef std::vector<AtomType> Genome;
+
+        /**
+         * @param _func the wrapped evaluator
+         * @param _capacity the maximal number of genomes kept
+         */
+        eoEvalFuncCache(eoEvalFunc<EOT>& _func, unsigned _capacity = 65536)
+            : func(_func),
+              nbSets( (_capacity + setSize - 1) / setSize ),
+              slots( nbSets * setSize ),
+              hands( nbSets, 0 ),
+              nbHits(0), nbMisses(0)
+        {
+            if (nbSets == 0)
+                throw std::runtime_error("eoEvalFuncCache needs a capacity of at least one genome");
+#ifdef _OPENMP
+            locks.resize( std::min<unsigned>(nbSets, maxLocks) );
+            for (unsigned i = 0; i < locks.size(); ++i)
+                omp_init_lock(&locks[i]);
+#endif
+        }
+
+        ~eoEvalFuncCache()
+        {
+#ifdef _OPENMP
+            for (unsigned i = 0; i < locks.size(); ++i)
+                omp_destroy_lock(&locks[i]);
+#endif
+        }
+
+        virtual void operator()(EOT& _eo)
+        {
+            if (!_eo.invalid())
+                return;
+
+            const Genome& genome = _eo;
+            uint64_t h = hash(genome);
+
+            Fitness fitness;
+            if (find(h, genome, fitness))
+            {
+                _eo.fitness(fitness);
+                increment(nbHits);
+                return;
+            }
+
+            func(_eo);
+            increment(nbMisses);
+            insert(h, genome, _eo.fitness());
+        }
+
+        /** Number of evaluations saved by the cache */
+        unsigned long hits() const { return read(nbHits); }
+
+        /** Number of evaluations done by the wrapped evaluator */
+        unsigned long misses() const { return read(nbMisses); }
+
+        /** Forgets all the genomes, for instance when the fitness function changes.
+            Each set is emptied under its lock, so that it can be called while other
+            threads evaluate. */
+        void clear()
+        {
+            for (unsigned set = 0; set < nbSets; ++set)
+            {
+                lock(set);
+                for (unsigned i = set * setSize; i < (set + 1) * setSize; ++i)
+                    slots[i].used = false;
+                unlock(set);
+            }
+        }
+
+        /** FNV-1a hash of the bytes of the genes */
+        static uint64_t hash(const Genome& _genome)
+        {
+            uint64_t h = 14695981039346656037ULL;
+            for (typename Genome::const_iterator it = _genome.begin(); it != _genome.end(); ++it)
+            {
+                AtomType atom = *it;
+                const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&atom);
+                for (unsigned k = 0; k < sizeof(AtomType); ++k)
+                {
+                    h ^= bytes[k];
+                    h *= 1099511628211ULL;
+                }
+            }
+            return h;
+        }
+
+    private :
+
+        enum { setSize = 8, maxLocks = 64 };
+
+        struct Slot
+        {
+            Slot() : used(false), referenced(false), hash(0) {}
+
+            bool used;
+            bool referenced;
+            uint64_t hash;
+            Fitness fitness;
+            Genome genome;
+        };
+
+        bool find(uint64_t _h, const Genome& _genome, Fitness& _fitness)
+        {
+            unsigned set = _h % nbSets;
+            bool found = false;
+
+            lock(set);
+            for (unsigned i = set * setSize; i < (set + 1) * setSize; ++i)
+            {
+                Slot& slot = slots[i];
+                if (slot.used && slot.hash == _h && slot.genome == _genome)
+                {
+                    slot.referenced = true;
+                    _fitness = slot.fitness;
+                    found = true;
+                    break;
+                }
+            }
+            unlock(set);
+
+            return found;
+        }
+
+        void insert(uint64_t _h, const Genome& _genome, const Fitness& _fitness)
+        {
+            unsigned set = _h % nbSets;
+            unsigned first = set * setSize;
+
+            lock(set);
+            Slot* target = 0;
+            for (unsigned i = first; i < first + setSize && !target; ++i)
+            {
+                // already inserted by another thread, or a free slot
+                if (!slots[i].used || (slots[i].hash == _h && slots[i].genome == _genome))
+                    target = &slots[i];
+            }
+            while (!target)
+            {
+                // CLOCK: the hand gives a second chance to the recently used slots
+                Slot& slot = slots[first + hands[set]];
+                if (slot.referenced)
+                    slot.referenced = false;
+                else
+                    target = &slot;
+                hands[set] = (hands[set] + 1) % setSize;
+            }
+
+            target->used = true;
+            target->referenced = false;
+            target->hash = _h;
+            target->fitness = _fitness;
+            target->genome = _genome;
+            unlock(set);
+        }
+
+        void lock(unsigned _set)
+        {
+#ifdef _OPENMP
+            omp_set_lock(&locks[_set % locks.size()]);
+#else
+            (void)_set;
+#endif
+        }
+
+        void unlock(unsigned _set)
+        {
+#ifdef _OPENMP
+            omp_unset_lock(&locks[_set % locks.size()]);
+#else
+            (void)_set;
+#endif
+        }
+
+        static void increment(unsigned long& _counter)
+        {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+            ++_counter;
+        }
+
+        static unsigned long read(const unsigned long& _counter)
+        {
+            unsigned long value;
+#ifdef _OPENMP
+#pragma omp atomic read
+#endif
+            value = _counter;
+            return value;
+        }
+
+        eoEvalFunc<EOT>& func;
+
+        unsigned nbSets;
+        std::vector<Slot> slots;
+        std::vector<unsigned char> hands;
+#ifdef _OPENMP
+        std::vector<omp_lock_t> locks;
+#endif
+
+        unsigned long nbHits;
+        unsigned long nbMisses;
+
+        // the locks can not be copied
+        eoEvalFuncCache(const eoEvalFuncCache&);
+        eoEvalFuncCache& operator=(const eoEvalFuncCache&);
+};
+
+/**
+  Gives the numbers of hits and misses of an eoEvalFuncCache since its
+  creation, to be monitored from a checkpoint.
+
+  @ingroup Stats
+*/
+template <class EOT>
+class eoEvalCacheStat : public eoStat<EOT, std::pair<double, double> >
+{
+    public :
+        using eoStat<EOT, std::pair<double, double> >::value;
+
+        eoEvalCacheStat(const eoEvalFuncCache<EOT>& _cache, std::string _description = "Cache hits/misses")
+            : eoStat<EOT, std::pair<double, double> >(std::make_pair(0.0, 0.0), _description), cache(_cache)
+        {}
+
+        virtual void operator()(const eoPop<EOT>&)
+        {
+            value().first = cache.hits();
+            value().second = cache.misses();
+        }
+
+        virtual std::string className(void) const { return "eoEvalCacheStat"; }
+
+    private :
+        const eoEvalFuncCache<EOT>& cache;
+};
+
+#endif
@@ -33,6 +33,9 @@
 /**
 Counts the number of evaluations actually performed.
 
+The counter is incremented atomically, so that it stays exact when the
+evaluations are run by the threads of a parallel apply.
+
 @ingroup Evaluation
 */
 template<class EOT> class eoEvalFuncCounter : public eoEvalFunc<EOT>, public eoValueParam<unsigned long>
@@ -45,12 +48,33 @@ template<class EOT> class eoEvalFuncCounter : public eoEvalFunc<EOT>, public eoV
         {
             if (_eo.invalid())
             {
-                value()++;
+                increment();
                 func(_eo);
             }
         }
 
     protected :
+
+        /** Adds _n (which may be negative) to the counter, from any thread, and returns its new value.
+         *
+         * As the new value is unique to the caller, it can be compared to a budget of evaluations.
+         */
+        unsigned long increment(long _n = 1)
+        {
+            unsigned long& counter = value();
+            unsigned long count;
+#if defined(_OPENMP) && _OPENMP >= 201107
+#pragma omp atomic capture
+            count = counter += _n;
+#elif defined(_OPENMP)
+#pragma omp critical(eoEvalFuncCounter)
+            count = counter += _n;
+#else
+            count = counter += _n;
+#endif
+            return count;
+        }
+
         eoEvalFunc<EOT>& func;
 };
 
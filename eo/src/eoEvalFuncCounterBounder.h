@@ -33,6 +33,9 @@ private:
  * This eval counter permits to stop a search during a generation, without waiting for a continue to be
  * checked at the end of the loop. Useful if you have 10 individuals and 10 generations,
  * but want to stop after 95 evaluations.
+ *
+ * When the population is evaluated by a parallel apply, the exception stops the evaluations in all the threads,
+ * and is thrown again by apply.
 */
 template < typename EOT >
 class eoEvalFuncCounterBounder : public eoEvalFuncCounter< EOT >
@@ -48,14 +51,18 @@ public :
     {
         if (eo.invalid())
             {
-                value()++;
+                unsigned long count = this->increment();
 
-                if (_threshold > 0 && value() >= _threshold)
+                if (_threshold > 0 && count >= _threshold)
                     {
+                        // other threads may have gone past the threshold, the counter stops on it
+                        if (count > _threshold)
+                            this->increment(-1);
+
                         throw eoEvalFuncCounterBounderException(_threshold);
                     }
 
-                func(eo);
+                this->func(eo);
             }
     }
 
@@ -0,0 +1,491 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+//-----------------------------------------------------------------------------
+// eoExternalPopEval.h
+// Evaluation of a population by a pool of external processes
+//-----------------------------------------------------------------------------
+/*
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+    Contact: http://eodev.sourceforge.net
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef eoExternalPopEval_H
+#define eoExternalPopEval_H
+
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <eoPopEvalFunc.h>
+#include <utils/pipecom.h>
+
+/** eoExternalPopEval: evaluates the offspring with a pool of long-lived
+ *    external processes, typically simulators, so that their start-up
+ *    cost is paid once and not at each evaluation.
+ *
+ *  The processes read the individuals on their standard input and write
+ *  their fitnesses on their standard output, in the same order. Each
+ *  message is a frame: its length in bytes, in decimal, followed by a
+ *  newline, then the data. By default the data of an individual is what
+ *  printOn writes (with the precision of a double), and the data of a
+ *  fitness what operator<< writes; encode and decode can be overloaded for
+ *  other formats. A C++ process can simply call serve() with its own
+ *  eoEvalFunc.
+ *
+ *  Up to _batchSize individuals are sent ahead to each process, which
+ *  hides the latency of the pipes, and the answers of all the processes
+ *  are waited for with poll(). A process that dies, sends a malformed
+ *  answer, or takes longer than _timeout seconds (0: no limit) to
+ *  evaluate an individual is killed and started again; the individuals it
+ *  had not answered yet are sent again. An individual that fails more
+ *  than _retries times gets the fitness given to penalty(), or, when there
+ *  is none, makes the evaluation throw a std::runtime_error.
+ *
+ *  Only the individuals whose fitness is invalid are evaluated. Unix only.
+ *
+ *  @example t-eoExternalPopEval.cpp
+ *
+ *  @ingroup Evaluation
+ */
+template<class EOT>
+class eoExternalPopEval : public eoPopEvalFunc<EOT>
+{
+public:
+
+    typedef typename EOT::Fitness Fitness;
+
+    /** Ctor
+     *
+     * @param _command the program to run (found in the PATH) and its arguments
+     * @param _processes the number of processes of the pool
+     * @param _timeout the maximum number of seconds of an evaluation, 0 for no limit
+     * @param _batchSize the number of individuals sent ahead to a process
+     * @param _retries the number of times an individual is sent again to a new process
+     */
+    eoExternalPopEval(const std::vector<std::string>& _command, unsigned _processes,
+                      double _timeout = 0, unsigned _batchSize = 4, unsigned _retries = 1)
+        : command(_command), processes(_processes), timeout(_timeout),
+          batchSize(_batchSize > 0 ? _batchSize : 1), retries(_retries),
+          hasPenalty(false), nStarts(0)
+    {
+        if (command.empty() || processes.empty())
+            throw std::runtime_error("eoExternalPopEval: needs a command and at least one process");
+    }
+
+    /** Closes the input of the processes, and kills those that do not stop within a second */
+    virtual ~eoExternalPopEval()
+    {
+        for (unsigned i = 0; i < processes.size(); ++i)
+            stop(processes[i], false);
+    }
+
+    /// the fitness of the individuals that could not be evaluated
+    void penalty(const Fitness& _penalty)
+    {
+        penaltyFitness = _penalty;
+        hasPenalty = true;
+    }
+
+    /// number of processes started, including the restarts
+    unsigned long starts() const { return nStarts; }
+
+    /** Do the job: sends the invalid offspring to the processes */
+    void operator()(eoPop<EOT>& _parents, eoPop<EOT>& _offspring)
+    {
+        (void)_parents;
+
+        pending.clear();
+        for (unsigned i = 0; i < _offspring.size(); ++i)
+            if (_offspring[i].invalid())
+                pending.push_back(i);
+
+        if (pending.empty())
+            return;
+
+        failures.assign(_offspring.size(), 0);
+        remaining = pending.size();
+
+        // a process that died would otherwise kill us when we write to it
+        struct sigaction ignore, previous;
+        ignore.sa_handler = SIG_IGN;
+        sigemptyset(&ignore.sa_mask);
+        ignore.sa_flags = 0;
+        sigaction(SIGPIPE, &ignore, &previous);
+
+        try
+        {
+            for (unsigned i = 0; i < processes.size(); ++i)
+                if (processes[i].com && waitpid(processes[i].com->pid, 0, WNOHANG) != 0)
+                    stop(processes[i], true); // died while idle
+
+            while (remaining > 0)
+                step(_offspring);
+        }
+        catch (...)
+        {
+            // the processes may still be busy with the individuals sent to them
+            for (unsigned i = 0; i < processes.size(); ++i)
+                stop(processes[i], true);
+            sigaction(SIGPIPE, &previous, 0);
+            throw;
+        }
+
+        sigaction(SIGPIPE, &previous, 0);
+    }
+
+    /** The loop of an evaluation process written with EO: reads the
+     *  individuals on _is, and writes their fitnesses on _os, until _is ends.
+     */
+    static void serve(eoEvalFunc<EOT>& _eval, std::istream& _is = std::cin, std::ostream& _os = std::cout)
+    {
+        _os.precision(std::numeric_limits<double>::digits10 + 2);
+
+        std::string data;
+        while (readFrame(_is, data))
+        {
+            EOT eo;
+            std::istringstream is(data);
+            eo.readFrom(is);
+            eo.invalidate();
+            _eval(eo);
+
+            std::ostringstream os;
+            os.precision(std::numeric_limits<double>::digits10 + 2);
+            os << eo.fitness();
+            _os << os.str().size() << '\n' << os.str();
+
+            // answers are flushed when there is no other individual to evaluate
+            if (_is.rdbuf()->in_avail() <= 0)
+                _os.flush();
+        }
+        _os.flush();
+    }
+
+protected:
+
+    /// the data sent for an individual
+    virtual void encode(const EOT& _eo, std::string& _data) const
+    {
+        std::ostringstream os;
+        os.precision(std::numeric_limits<double>::digits10 + 2);
+        _eo.printOn(os);
+        _data = os.str();
+    }
+
+    /// reads the fitness answered for an individual, throws a std::runtime_error if it can not
+    virtual void decode(const std::string& _data, EOT& _eo) const
+    {
+        std::istringstream is(_data);
+        Fitness fitness;
+        if (!(is >> fitness))
+            throw std::runtime_error("eoExternalPopEval: can not read the fitness \"" + _data + "\"");
+        _eo.fitness(fitness);
+    }
+
+private:
+
+    struct Process
+    {
+        Process() : com(0), written(0), parsed(0), started(0) {}
+
+        PCom* com;
+        std::string output;         // frames not written yet
+        size_t written;
+        std::string input;          // answers read
+        size_t parsed;
+        std::deque<unsigned> inFlight; // individuals sent, in order
+        double started;             // when the evaluation of the first one began
+    };
+
+    static double now()
+    {
+        struct timespec t;
+        clock_gettime(CLOCK_MONOTONIC, &t);
+        return t.tv_sec + 1e-9 * t.tv_nsec;
+    }
+
+    static bool readFrame(std::istream& _is, std::string& _data)
+    {
+        size_t length;
+        if (!(_is >> length) || _is.get() != '\n')
+            return false;
+        _data.resize(length);
+        if (length > 0)
+            _is.read(&_data[0], length);
+        return _is.good() || (length > 0 && _is.gcount() == std::streamsize(length));
+    }
+
+    void start(Process& _p)
+    {
+        std::vector<char*> argv;
+        for (unsigned i = 0; i < command.size(); ++i)
+            argv.push_back(const_cast<char*>(command[i].c_str()));
+        argv.push_back(0);
+
+        _p.com = PipeComOpenArgv(argv[0], &argv[0]);
+        if (!_p.com)
+            throw std::runtime_error("eoExternalPopEval: can not start " + command[0]);
+        ++nStarts;
+
+        fcntl(fileno(_p.com->fWrit), F_SETFL, O_NONBLOCK);
+        fcntl(fileno(_p.com->fRead), F_SETFL, O_NONBLOCK);
+
+        _p.output.clear();
+        _p.written = 0;
+        _p.input.clear();
+        _p.parsed = 0;
+        _p.inFlight.clear();
+    }
+
+    /** stops a process, by killing it, or by closing its input first */
+    static void stop(Process& _p, bool _kill)
+    {
+        if (!_p.com)
+            return;
+
+        int pid = _p.com->pid;
+        if (_kill)
+            kill(pid, SIGKILL);
+        PipeComClose(_p.com);
+        _p.com = 0;
+
+        if (!_kill)
+        {
+            for (unsigned ms = 0; ms < 1000; ++ms)
+            {
+                if (waitpid(pid, 0, WNOHANG) != 0)
+                    return;
+                usleep(1000);
+            }
+            kill(pid, SIGKILL);
+        }
+        waitpid(pid, 0, 0);
+    }
+
+    /** kills a process that failed, the individual it was evaluating counts a failure */
+    void fail(Process& _p, eoPop<EOT>& _pop)
+    {
+        stop(_p, true);
+
+        if (_p.inFlight.empty())
+            return;
+
+        unsigned first = _p.inFlight.front();
+        _p.inFlight.pop_front();
+
+        // the others were not evaluated yet, and are sent again first
+        pending.insert(pending.begin(), _p.inFlight.begin(), _p.inFlight.end());
+        _p.inFlight.clear();
+
+        if (++failures[first] <= retries)
+            pending.push_front(first);
+        else if (hasPenalty)
+        {
+            _pop[first].fitness(penaltyFitness);
+            --remaining;
+        }
+        else
+            throw std::runtime_error("eoExternalPopEval: the evaluation of an individual by " + command[0] + " failed");
+    }
+
+    /** sends new individuals to the processes, and waits until one of them can be read or written */
+    void step(eoPop<EOT>& _pop)
+    {
+        double time = now();
+        std::string data;
+
+        fds.clear();
+        owners.clear();
+        int wait = -1;
+
+        for (unsigned i = 0; i < processes.size(); ++i)
+        {
+            Process& p = processes[i];
+
+            while (p.inFlight.size() < batchSize && !pending.empty())
+            {
+                if (!p.com)
+                    start(p);
+                if (p.inFlight.empty())
+                    p.started = time;
+
+                unsigned index = pending.front();
+                pending.pop_front();
+                encode(_pop[index], data);
+
+                std::ostringstream header;
+                header << data.size() << '\n';
+                p.output += header.str();
+                p.output += data;
+                p.inFlight.push_back(index);
+            }
+
+            if (!p.com)
+                continue;
+
+            struct pollfd fd;
+            fd.fd = fileno(p.com->fRead);
+            fd.events = POLLIN;
+            fd.revents = 0;
+            fds.push_back(fd);
+            owners.push_back(i);
+
+            if (p.written < p.output.size())
+            {
+                fd.fd = fileno(p.com->fWrit);
+                fd.events = POLLOUT;
+                fds.push_back(fd);
+                owners.push_back(i);
+            }
+
+            if (timeout > 0 && !p.inFlight.empty())
+            {
+                int left = static_cast<int>((p.started + timeout - time) * 1000) + 1;
+                if (left < 0)
+                    left = 0;
+                if (wait < 0 || left < wait)
+                    wait = left;
+            }
+        }
+
+        if (poll(&fds[0], fds.size(), wait) < 0 && errno != EINTR)
+            throw std::runtime_error("eoExternalPopEval: poll failed");
+
+        time = now();
+        for (unsigned k = 0; k < fds.size(); ++k)
+        {
+            Process& p = processes[owners[k]];
+            if (!p.com || fds[k].revents == 0)
+                continue;
+
+            if (fds[k].events == POLLOUT)
+            {
+                if (!send(p))
+                    fail(p, _pop);
+            }
+            else if (!receive(p, _pop, time))
+                fail(p, _pop);
+        }
+
+        if (timeout > 0)
+            for (unsigned i = 0; i < processes.size(); ++i)
+            {
+                Process& p = processes[i];
+                if (p.com && !p.inFlight.empty() && time - p.started > timeout)
+                    fail(p, _pop);
+            }
+    }
+
+    /** writes what the process can take, returns false if it is gone */
+    bool send(Process& _p)
+    {
+        ssize_t n = write(fileno(_p.com->fWrit), _p.output.data() + _p.written, _p.output.size() - _p.written);
+        if (n < 0)
+            return errno == EAGAIN || errno == EINTR;
+
+        _p.written += n;
+        if (_p.written == _p.output.size())
+        {
+            _p.output.clear();
+            _p.written = 0;
+        }
+        return true;
+    }
+
+    /** reads the answers of the process, returns false if it is gone or did not answer properly */
+    bool receive(Process& _p, eoPop<EOT>& _pop, double _time)
+    {
+        char buffer[65536];
+        ssize_t n = read(fileno(_p.com->fRead), buffer, sizeof(buffer));
+        if (n < 0)
+            return errno == EAGAIN || errno == EINTR;
+        if (n == 0)
+            return false; // the process died
+        _p.input.append(buffer, n);
+
+        std::string data;
+        for (;;)
+        {
+            size_t eol = _p.input.find('\n', _p.parsed);
+            if (eol == std::string::npos)
+                break;
+
+            char* end;
+            unsigned long length = strtoul(_p.input.c_str() + _p.parsed, &end, 10);
+            if (end != _p.input.c_str() + eol || eol == _p.parsed)
+                return false;
+            if (_p.input.size() - eol - 1 < length)
+                break;
+
+            if (_p.inFlight.empty())
+                return false; // an answer to nothing
+            data.assign(_p.input, eol + 1, length);
+            try
+            {
+                decode(data, _pop[_p.inFlight.front()]);
+            }
+            catch (std::runtime_error&)
+            {
+                return false;
+            }
+
+            _p.inFlight.pop_front();
+            _p.started = _time;
+            _p.parsed = eol + 1 + length;
+            --remaining;
+        }
+
+        _p.input.erase(0, _p.parsed);
+        _p.parsed = 0;
+        return true;
+    }
+
+    // no copy: the processes belong to one evaluator
+    eoExternalPopEval(const eoExternalPopEval&);
+    eoExternalPopEval& operator=(const eoExternalPopEval&);
+
+    std::vector<std::string> command;
+    std::vector<Process> processes;
+    double timeout;
+    unsigned batchSize;
+    unsigned retries;
+    bool hasPenalty;
+    Fitness penaltyFitness;
+    unsigned long nStarts;
+
+    // state of an evaluation
+    std::deque<unsigned> pending;
+    std::vector<unsigned> failures;
+    unsigned remaining;
+    std::vector<struct pollfd> fds;
+    std::vector<unsigned> owners;
+};
+
+#endif
@@ -83,7 +83,7 @@ class eoGeneralBreeder: public eoBreed<EOT>
     {
       unsigned target = howMany(_parents.size());
 
-      _offspring.clear();
+      _offspring.recycle();
       eoSelectivePopulator<EOT> it(_parents, _offspring, select);
 
       while (_offspring.size() < target)
@@ -42,11 +42,11 @@
  * @ingroup Selectors
  */
 template <class EOT>
-class eoLinearFitScaling : public eoPerf2Worth<EOT> // false: do not cache fitness
+class eoLinearFitScaling : public eoPerf2WorthCached<EOT, double> // worths are only recomputed when a fitness changes
 {
 public:
 
-    using eoPerf2Worth<EOT>::value;
+    using eoPerf2WorthCached<EOT, double>::value;
 
     /* Ctor:
        @param _p selective pressure (in (1,2])
@@ -59,7 +59,7 @@ public:
        with m=2-pressure/popSize and M=pressure/popSize.
        in between, the progression depends on exponent (linear if 1).
     */
-    virtual void operator()(const eoPop<EOT>& _pop) {
+    virtual void calculate_worths(const eoPop<EOT>& _pop) {
         unsigned pSize =_pop.size();
         // value() refers to the vector of worthes (we're in an eoParamvalue)
         value().resize(pSize);
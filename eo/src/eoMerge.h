@@ -50,7 +50,20 @@
 */
 
 template<class Chrom> class eoMerge: public eoBF<const eoPop<Chrom>&, eoPop<Chrom>&, void>
-{};
+{
+public:
+  /** Merges as operator(), when the old population is not needed afterwards:
+   * its individuals can be moved instead of copied. The old population is
+   * then emptied by eoPop::recycle, so that no moved-from individual (with a
+   * stale fitness) is left in it. This is what the replacements use. By
+   * default copies.
+   */
+  virtual void moveInto(eoPop<Chrom>& _pop, eoPop<Chrom>& _offspring)
+  {
+    (*this)(_pop, _offspring);
+    _pop.recycle();
+  }
+};
 
 /**
 Straightforward elitism class, specify the number of individuals to copy
@@ -84,14 +97,7 @@ public :
   {
     if ((combien == 0) && (rate == 0.0))
       return;
-    unsigned combienLocal;
-    if (combien == 0)      // rate is specified
-      combienLocal = (unsigned int) (rate * _pop.size());
-    else
-      combienLocal = combien;
-
-    if (combienLocal > _pop.size())
-      throw std::logic_error("Elite larger than population");
+    unsigned combienLocal = howMany(_pop);
 
     std::vector<const EOT*> result;
     _pop.nth_element(combienLocal, result);
@@ -102,7 +108,44 @@ public :
       }
   }
 
+  void moveInto(eoPop<EOT>& _pop, eoPop<EOT>& _offspring)
+  {
+    if ((combien == 0) && (rate == 0.0))
+      {
+        _pop.recycle();
+        return;
+      }
+    unsigned combienLocal = howMany(_pop);
+
+    std::vector<unsigned> result;
+    _pop.nth_element(combienLocal, result);
+
+    for (size_t i = 0; i < result.size(); ++i)
+      {
+#if __cplusplus >= 201103L
+        _offspring.push_back(std::move(_pop[result[i]]));
+#else
+        _offspring.push_back(_pop[result[i]]);
+#endif
+      }
+    _pop.recycle();
+  }
+
 private :
+  unsigned howMany(const eoPop<EOT>& _pop) const
+  {
+    unsigned combienLocal;
+    if (combien == 0)      // rate is specified
+      combienLocal = (unsigned int) (rate * _pop.size());
+    else
+      combienLocal = combien;
+
+    if (combienLocal > _pop.size())
+      throw std::logic_error("Elite larger than population");
+
+    return combienLocal;
+  }
+
   double rate;
   unsigned combien;
 };
@@ -134,6 +177,21 @@ template <class EOT> class eoPlus : public eoMerge<EOT>
             }
         }
 
+        void moveInto(eoPop<EOT>& _pop, eoPop<EOT>& _offspring)
+        {
+            _offspring.reserve(_offspring.size() + _pop.size());
+
+            for (size_t i = 0; i < _pop.size(); ++i)
+            {
+#if __cplusplus >= 201103L
+                _offspring.push_back(std::move(_pop[i]));
+#else
+                _offspring.push_back(_pop[i]);
+#endif
+            }
+            _pop.recycle();
+        }
+
     private :
 };
 
@@ -57,8 +57,9 @@ class eoMergeReduce : public eoReplacement<EOT>
 
         virtual void operator()(eoPop<EOT>& _parents, eoPop<EOT>& _offspring)
         {
-            merge(_parents, _offspring); // parents untouched, result in offspring
-            reduce(_offspring, _parents.size());
+            unsigned pSize = _parents.size();
+            merge.moveInto(_parents, _offspring); // result in offspring, parents emptied
+            reduce(_offspring, pSize);
             _parents.swap(_offspring);
         }
 
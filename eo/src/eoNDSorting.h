@@ -37,6 +37,14 @@
   Non dominated sorting, it *is a* std::vector of doubles, the integer part is the rank (to which front it belongs),
   the fractional part the niching penalty or distance penalty or whatever penalty you want to squeeze into
   the bits.
+
+  With three objectives or more, the fronts are computed by default with the O(M.N^2) algorithm of Deb, which
+  stores for each individual the list of the individuals it dominates. Setting efficient_sort_ selects instead the
+  Efficient Non-dominated Sort with binary search (ENS-BS) of Zhang, Tian, Cheng and Jin (IEEE TEC, 2015): the
+  population is sorted lexicographically, so that an individual can only be dominated by the ones before it, and
+  each individual is put in the first front (found by binary search) that contains nobody dominating it. It needs
+  O(N) memory and much less dominance checks on large populations. Both give the same fronts, provided the
+  fitnesses have no ignored objective.
 */
 template <class EOT>
 class eoNDSorting : public eoPerf2WorthCached<EOT, double>
@@ -44,13 +52,9 @@ class eoNDSorting : public eoPerf2WorthCached<EOT, double>
   public :
 
     using eoPerf2WorthCached<EOT, double>::value;
-      eoNDSorting(bool nasty_flag_ = false)
-          : nasty_declone_flag_that_only_is_implemented_for_two_objectives(nasty_flag_)
-        {}
-
-
-    eoNDSorting()
-        : nasty_declone_flag_that_only_is_implemented_for_two_objectives(false)
+      eoNDSorting(bool nasty_flag_ = false, bool efficient_sort_ = false)
+          : nasty_declone_flag_that_only_is_implemented_for_two_objectives(nasty_flag_),
+            efficient_sort(efficient_sort_)
         {}
 
     /** Pure virtual function that calculates the 'distance' for each element in the current front
@@ -80,7 +84,10 @@ class eoNDSorting : public eoPerf2WorthCached<EOT, double>
                 }
             default :
                 {
-                    m_objectives(_pop);
+                    if (efficient_sort)
+                        ens_objectives(_pop);
+                    else
+                        m_objectives(_pop);
                 }
         }
     }
@@ -356,6 +363,121 @@ private :
       rank_to_worth();
     }
 
+    /** Lexicographic order on the objectives, better first.
+        If a dominates b, a comes first.
+
+        The objectives are compared exactly, so that this is a strict weak
+        ordering for std::sort: the tolerance of the fitness only applies to
+        the dominance. When two individuals are within the tolerance on the
+        first objective where they differ, the dominating one may come
+        second, and their fronts may then differ from Deb's algorithm.
+    */
+    class LexicographicSorter
+    {
+        public:
+            LexicographicSorter(const eoPop<EOT>& _pop) : pop(_pop) {}
+
+            bool operator()(unsigned i, unsigned j) const
+            {
+                typedef typename EOT::Fitness::fitness_traits traits;
+
+                for (unsigned o = 0; o < traits::nObjectives(); ++o)
+                {
+                    double a = pop[i].fitness()[o];
+                    double b = pop[j].fitness()[o];
+
+                    if (a == b)
+                        continue;
+
+                    if (traits::maximizing(o))
+                        return a > b;
+                    return a < b;
+                }
+
+                return false;
+            }
+
+            const eoPop<EOT>& pop;
+    };
+
+    /** Efficient non-dominated sort (ENS-BS), see the class documentation */
+    void ens_objectives(const eoPop<EOT>& _pop)
+    {
+      unsigned i;
+
+      std::vector<unsigned> order(_pop.size());
+      for (i = 0; i < _pop.size(); ++i)
+      {
+        order[i] = i;
+      }
+
+      std::sort(order.begin(), order.end(), LexicographicSorter(_pop));
+
+      std::vector<std::vector<unsigned> > fronts;
+
+      for (i = 0; i < order.size(); ++i)
+      {
+        unsigned index = order[i];
+
+        // if somebody of front k dominates index, so does somebody of every front before k:
+        // binary search for the first front where nobody dominates it
+        unsigned low = 0;
+        unsigned high = fronts.size();
+        while (low < high)
+        {
+          unsigned middle = (low + high) / 2;
+          if (front_dominates(fronts[middle], index, _pop))
+            low = middle + 1;
+          else
+            high = middle;
+        }
+
+        if (low == fronts.size())
+        {
+          fronts.push_back(std::vector<unsigned>());
+        }
+        fronts[low].push_back(index);
+      }
+
+      for (unsigned front_index = 0; front_index < fronts.size(); ++front_index)
+      {
+        std::vector<unsigned>& current_front = fronts[front_index];
+
+        // niching should not depend on the lexicographic order
+        std::sort(current_front.begin(), current_front.end());
+
+        std::vector<double> niche_count = niche_penalty(current_front, _pop);
+
+        // Check whether the derived class was nice
+        if (niche_count.size() != current_front.size())
+        {
+          throw std::logic_error("eoNDSorting: niche and front should have the same size");
+        }
+
+        double max_niche = *std::max_element(niche_count.begin(), niche_count.end());
+
+        for (i = 0; i < current_front.size(); ++i)
+        {
+          value()[current_front[i]] = front_index + niche_count[i] / (max_niche + 1.); // divide by max_niche + 1 to ensure that this front does not overlap with the next
+        }
+      }
+
+      rank_to_worth();
+    }
+
+    /** Is _index dominated by somebody of _front?
+        The last inserted ones are checked first, as they are the closest to _index in the lexicographic order.
+    */
+    bool front_dominates(const std::vector<unsigned>& _front, unsigned _index, const eoPop<EOT>& _pop) const
+    {
+      for (unsigned k = _front.size(); k > 0; --k)
+      {
+        if (_pop[_front[k-1]].fitness().dominates(_pop[_index].fitness()))
+          return true;
+      }
+      return false;
+    }
+
     void rank_to_worth()
     {
       // now all that's left to do is to transform lower rank into higher worth
@@ -371,6 +493,9 @@ private :
 
     }
     public : bool nasty_declone_flag_that_only_is_implemented_for_two_objectives;
+
+    /// use ENS-BS instead of Deb's algorithm for three objectives or more
+    bool efficient_sort;
 };
 
 /**
@@ -380,7 +505,7 @@ template <class EOT>
 class eoNDSorting_I : public eoNDSorting<EOT>
 {
 public :
-  eoNDSorting_I(double _nicheSize, bool nasty_flag_ = false) : eoNDSorting<EOT>(nasty_flag_), nicheSize(_nicheSize) {}
+  eoNDSorting_I(double _nicheSize, bool nasty_flag_ = false, bool efficient_sort_ = false) : eoNDSorting<EOT>(nasty_flag_, efficient_sort_), nicheSize(_nicheSize) {}
 
   std::vector<double> niche_penalty(const std::vector<unsigned>& current_front, const eoPop<EOT>& _pop)
   {
@@ -435,7 +560,7 @@ class eoNDSorting_II : public eoNDSorting<EOT>
 {
   public:
 
-    eoNDSorting_II(bool nasty_flag_ = false) : eoNDSorting<EOT>(nasty_flag_) {}
+    eoNDSorting_II(bool nasty_flag_ = false, bool efficient_sort_ = false) : eoNDSorting<EOT>(nasty_flag_, efficient_sort_) {}
 
   typedef std::pair<double, unsigned> double_index_pair;
 
@@ -78,7 +78,7 @@ class eoOneToOneBreeder: public eoBreed<EOT>
     {
       unsigned target = howMany(_parents.size());
 
-      _offspring.clear();
+      _offspring.recycle();
       eoSelectivePopulator<EOT> popit(_parents, _offspring, select);
 
       for (unsigned iParent=0; iParent<target; iParent++)
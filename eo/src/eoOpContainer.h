@@ -106,7 +106,7 @@ public:
         for (size_t i = 0; i < rates.size(); ++i) {
             _pop.seekp(pos);
             do {
-                if (eo::rng.flip(rates[i])) {
+                if (eo::threadRng().flip(rates[i])) {
                     //            try
                     //            {
                     // apply it to all the guys in the todo std::list
@@ -151,7 +151,7 @@ public:
 
     void apply(eoPopulator<EOT>& _pop)
     {
-      unsigned i = eo::rng.roulette_wheel(rates);
+      unsigned i = eo::threadRng().roulette_wheel(rates);
 
       try
       {
@@ -0,0 +1,215 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+//-----------------------------------------------------------------------------
+// eoParallelGeneralBreeder.h
+/*
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+    Contact: http://eodev.sourceforge.net
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef eoParallelGeneralBreeder_h
+#define eoParallelGeneralBreeder_h
+
+//-----------------------------------------------------------------------------
+
+#include <vector>
+#include <stdexcept>
+
+#include <eoOp.h>
+#include <eoGenOp.h>
+#include <eoPopulator.h>
+#include <eoSelectOne.h>
+#include <eoBreed.h>
+#include <utils/eoHowMany.h>
+#include <utils/eoParallel.h>
+#include <utils/eoRNG.h>
+#include <apply.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+  Multi-threaded version of eoGeneralBreeder.
+
+  When the parallelization is enabled (--parallelize-loop), the offspring
+  slots are partitioned into one contiguous chunk per thread. Each chunk is
+  filled by its own eoSelectivePopulator, drawing its random numbers from the
+  stream of its thread (see eo::threadRng), and the chunks are then
+  concatenated in order. The number of offspring is the same as with
+  eoGeneralBreeder, and the result is deterministic for a given seed and a
+  given number of threads.
+
+  The selector(s) are set up once, sequentially, before the parallel region.
+  With a single shared selector, its operator() must not modify its state
+  (true for tournaments, roulette wheel or random selection); otherwise,
+  give one selector per thread.
+
+  The general operator is shared by all threads: its apply() must not modify
+  its state either, which is the case of eoSequentialOp and eoProportionalOp.
+
+  An exception thrown by the selector or the operator in one of the threads
+  stops the breeding and is thrown again once all the threads are done (see
+  eoParallelApplyGuard).
+
+  Without OpenMP, or when the parallelization is disabled, it behaves exactly
+  like eoGeneralBreeder.
+
+  @ingroup Combination
+  @ingroup Parallel
+*/
+template<class EOT>
+class eoParallelGeneralBreeder: public eoBreed<EOT>
+{
+ public:
+  /** Ctor with a selector shared by all threads
+   *
+   * @param _select a selectoOne, to be used for all selections
+   * @param _op a general operator (will generally be an eoOpContainer)
+   * @param _rate               pour howMany, le nbre d'enfants a generer
+   * @param _interpret_as_rate  <a href="../../tutorial/html/eoEngine.html#howmany">explanation</a>
+   */
+  eoParallelGeneralBreeder(
+          eoSelectOne<EOT>& _select,
+          eoGenOp<EOT>& _op,
+          double  _rate=1.0,
+          bool _interpret_as_rate = true) :
+      selects(1, &_select), op(_op),  howMany(_rate, _interpret_as_rate) {}
+
+  /** Ctor with a selector shared by all threads
+   *
+   * @param _select a selectoOne, to be used for all selections
+   * @param _op a general operator (will generally be an eoOpContainer)
+   * @param _howMany an eoHowMany <a href="../../tutorial/html/eoEngine.html#howmany">explanation</a>
+   */
+  eoParallelGeneralBreeder(
+          eoSelectOne<EOT>& _select,
+          eoGenOp<EOT>& _op,
+          eoHowMany _howMany ) :
+      selects(1, &_select), op(_op),  howMany(_howMany) {}
+
+  /** Ctor with one selector per thread
+   *
+   * @param _selects one selectOne per thread, thread i uses _selects[i]
+   * @param _op a general operator (will generally be an eoOpContainer)
+   * @param _howMany an eoHowMany <a href="../../tutorial/html/eoEngine.html#howmany">explanation</a>
+   */
+  eoParallelGeneralBreeder(
+          std::vector< eoSelectOne<EOT>* > _selects,
+          eoGenOp<EOT>& _op,
+          eoHowMany _howMany ) :
+      selects(_selects), op(_op),  howMany(_howMany)
+  {
+      if (selects.empty())
+          throw std::runtime_error("eoParallelGeneralBreeder needs at least one selector");
+  }
+
+  /** The breeder: calls the genOp on one selective populator per thread
+   *
+   * @param _parents the initial population
+   * @param _offspring the resulting population (content -if any- is lost)
+   */
+  void operator()(const eoPop<EOT>& _parents, eoPop<EOT>& _offspring)
+    {
+      unsigned target = howMany(_parents.size());
+
+      unsigned nchunks = 1;
+#ifdef _OPENMP
+      if ( eo::parallel.isEnabled() )
+        {
+          nchunks = omp_get_max_threads();
+          eo::rngPool.reserve( nchunks );
+        }
+#endif // _OPENMP
+
+      if (selects.size() > 1 && selects.size() < nchunks)
+          throw std::runtime_error("eoParallelGeneralBreeder: less selectors than threads");
+
+      for (unsigned s = 0; s < selects.size(); ++s)
+          selects[s]->setup(_parents);
+
+      parts.resize(nchunks);
+
+      // an exception can not leave the parallel region, it is kept by the guard
+      ChunkFiller fill(*this, _parents, target, nchunks);
+      eoParallelApplyGuard guard;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static,1) num_threads(nchunks) if(nchunks > 1)
+#endif // _OPENMP
+      for (int c = 0; c < static_cast<int>(nchunks); ++c)
+        {
+          int chunk = c;
+          guard.run(fill, chunk);
+        }
+
+      guard.rethrow();
+
+      _offspring.recycle();
+      _offspring.reserve(target);
+      for (unsigned c = 0; c < nchunks; ++c)
+          for (unsigned i = 0; i < parts[c].size(); ++i)
+              _offspring.push_back(parts[c][i]);
+    }
+
+  /// The class name.
+  virtual std::string className() const { return "eoParallelGeneralBreeder"; }
+
+ private:
+
+  /// fills the offspring of one chunk
+  class ChunkFiller : public eoUF<int&, void>
+  {
+  public:
+      ChunkFiller(eoParallelGeneralBreeder<EOT>& _breeder, const eoPop<EOT>& _parents, unsigned _target, unsigned _nchunks) :
+          breeder(_breeder), parents(_parents), target(_target), nchunks(_nchunks) {}
+
+      void operator()(int& _c)
+        {
+          unsigned quota = (target * (_c+1)) / nchunks - (target * _c) / nchunks;
+          eoSelectOne<EOT>& select = breeder.selects.size() > 1 ? *breeder.selects[_c] : *breeder.selects[0];
+          eoPop<EOT>& part = breeder.parts[_c];
+
+          part.recycle();
+          eoSelectivePopulator<EOT> it(parents, part, select, false);
+          it.reserve(quota);
+
+          while (part.size() < quota)
+            {
+              breeder.op(it);
+              ++it;
+            }
+
+          part.resize(quota);   // you might have generated a few more
+        }
+
+  private:
+      eoParallelGeneralBreeder<EOT>& breeder;
+      const eoPop<EOT>& parents;
+      unsigned target;
+      unsigned nchunks;
+  };
+
+  std::vector< eoSelectOne<EOT>* > selects;
+  eoGenOp<EOT>& op;
+  eoHowMany howMany;
+
+  /// offspring of each chunk, kept between generations to reuse their storage
+  std::vector< eoPop<EOT> > parts;
+};
+
+#endif
@@ -56,6 +56,19 @@ class eoPersistent: public eoPrintable
    */
   virtual void readFrom(std::istream& _is) = 0;
 
+  /**
+   * Write object in the binary checkpoints of eoState (see eoState::formatBinary).
+   * Defaults to printOn: objects that have a faster raw form override it, together with readBinaryFrom.
+   * @param _os A std::ostream, opened in binary mode.
+   */
+  virtual void printBinaryOn(std::ostream& _os) const { printOn(_os); }
+
+  /**
+   * Read object from a binary checkpoint, as written by printBinaryOn.
+   * @param _is A std::istream, opened in binary mode.
+   */
+  virtual void readBinaryFrom(std::istream& _is) { readFrom(_is); }
+
 };
 
 ///Standard input for all objects in the EO hierarchy
@@ -37,6 +37,7 @@ Authors:
 #include <algorithm>
 #include <iostream>
 #include <iterator> // needed for GCC 3.2
+#include <utility>
 #include <vector>
 #include <assert.h>
 
@@ -44,6 +45,7 @@ Authors:
 #include <eoOp.h> // for eoInit
 #include <eoPersistent.h>
 #include <eoInit.h>
+#include <eoRawFormat.h>
 #include <utils/rnd_generators.h>  // for shuffle method
 
 /** A std::vector of EO object, to be used in all algorithms
@@ -68,6 +70,7 @@ class eoPop: public std::vector<EOT>, public eoObject, public eoPersistent
 
         using std::vector<EOT>::size;
         using std::vector<EOT>::resize;
+        using std::vector<EOT>::push_back;
         using std::vector<EOT>::operator[];
         using std::vector<EOT>::begin;
         using std::vector<EOT>::end;
@@ -153,6 +156,21 @@ class eoPop: public std::vector<EOT>, public eoObject, public eoPersistent
             }
         };
 
+        /// helper struct for comparing on indices, ties are broken by index
+        struct CmpIndex
+        {
+            CmpIndex(const eoPop<EOT>& _pop) : pop(_pop) {}
+
+            bool operator()(unsigned a, unsigned b) const
+            {
+                if (pop[b] < pop[a]) return true;
+                if (pop[a] < pop[b]) return false;
+                return a < b;
+            }
+
+            const eoPop<EOT>& pop;
+        };
+
 
         /**
           sort the population. Use this member to sort in order
@@ -175,6 +193,32 @@ class eoPop: public std::vector<EOT>, public eoObject, public eoPersistent
         }
 
 
+        /** creates a std::vector of the indices of the individuals in descending order,
+          individuals with the same fitness keep their relative order in the population */
+        void sort(std::vector<unsigned>& result) const
+        {
+            result.resize(size());
+
+            for (unsigned i = 0; i < size(); ++i)
+                result[i] = i;
+
+            std::sort(result.begin(), result.end(), CmpIndex(*this));
+        }
+
+
+        /** creates a std::vector of the indices of the individuals, where the index of the
+          nth best individual is at position nth, with better ones before and worse ones after */
+        void nth_element(int nth, std::vector<unsigned>& result) const
+        {
+            result.resize(size());
+
+            for (unsigned i = 0; i < size(); ++i)
+                result[i] = i;
+
+            std::nth_element(result.begin(), result.begin() + nth, result.end(), CmpIndex(*this));
+        }
+
+
         /**
           shuffle the population. Use this member to put the population
           in random order
@@ -312,6 +356,176 @@ class eoPop: public std::vector<EOT>, public eoObject, public eoPersistent
         }
 
 
+        /** @name Recycling of the individuals
+         *
+         * A population can keep the individuals it drops instead of
+         * destroying them: push_back then copies the new individual into one
+         * of them, which reuses its storage (for instance the vector of genes
+         * of an eoVector) instead of allocating new one. A population that
+         * is emptied and filled again at each generation, like the
+         * offspring of an algorithm, stops allocating memory once it has
+         * reached its size.
+         *
+         * The individuals are moved in and out of the spare ones, so this
+         * needs C++11: otherwise recycle() is clear() and the individuals
+         * removed by resize() are destroyed.
+         */
+        //@{
+        /** Empties the population, keeping its individuals aside for the next push_back */
+        void recycle()
+        {
+#if __cplusplus >= 201103L
+            if (spare.empty())
+            {
+                std::vector<EOT>::swap(spare); // the population takes the empty storage of spare
+            }
+            else
+            {
+                for (typename std::vector<EOT>::iterator it = begin(); it != end(); ++it)
+                    spare.push_back(std::move(*it));
+                std::vector<EOT>::clear();
+            }
+#else
+            std::vector<EOT>::clear();
+#endif
+        }
+
+        /** Appends a copy of _eo, in the storage of a recycled individual if there is one */
+        void push_back(const EOT& _eo)
+        {
+#if __cplusplus >= 201103L
+            if (!spare.empty())
+            {
+                spare.back() = _eo;    // _eo can be in the population, which push_back can move
+                std::vector<EOT>::push_back(std::move(spare.back()));
+                spare.pop_back();
+                return;
+            }
+#endif
+            std::vector<EOT>::push_back(_eo);
+        }
+
+#if __cplusplus >= 201103L
+        /** Appends _eo by moving it, _eo gets the storage of a recycled individual if there is one */
+        void push_back(EOT&& _eo)
+        {
+            if (!spare.empty())
+            {
+                std::swap(spare.back(), _eo);
+                std::vector<EOT>::push_back(std::move(spare.back()));
+                spare.pop_back();
+                return;
+            }
+            std::vector<EOT>::push_back(std::move(_eo));
+        }
+#endif
+
+        /** Resizes the population, the individuals removed are kept aside for the next push_back */
+        void resize(typename std::vector<EOT>::size_type _size)
+        {
+#if __cplusplus >= 201103L
+            for (typename std::vector<EOT>::iterator it = begin() + std::min<size_t>(_size, size()); it != end(); ++it)
+                spare.push_back(std::move(*it));
+#endif
+            std::vector<EOT>::resize(_size);
+        }
+
+#if __cplusplus >= 201103L
+        /** Resizes the population, the new individuals are copies of _value, made in recycled ones if any */
+        void resize(typename std::vector<EOT>::size_type _size, const EOT& _value)
+        {
+            if (_size <= size())
+            {
+                resize(_size);
+                return;
+            }
+            std::vector<EOT>::reserve(_size);
+            while (size() < _size)
+                push_back(_value);
+        }
+#endif
+
+        /** Puts the individual _order[i] at position i, for all i < _order.size(),
+            the other individuals are removed as by resize(). The indices must be distinct.
+
+            The individuals are moved along the cycles of the permutation, so
+            that each of them is moved once, plus one move per cycle.
+        */
+        void reorder(const std::vector<unsigned>& _order)
+        {
+            unsigned n = size();
+
+            // completes the order into a permutation
+            std::vector<unsigned> perm(_order);
+            perm.reserve(n);
+            std::vector<bool> placed(n, false);
+            for (unsigned i = 0; i < _order.size(); ++i)
+                placed[_order[i]] = true;
+            for (unsigned i = 0; i < n; ++i)
+                if (!placed[i])
+                    perm.push_back(i);
+
+            // the individual perm[i] goes to position i
+            std::fill(placed.begin(), placed.end(), false);
+            for (unsigned start = 0; start < n; ++start)
+            {
+                if (placed[start] || perm[start] == start)
+                    continue;
+#if __cplusplus >= 201103L
+                EOT tmp(std::move(operator[](start)));
+#else
+                EOT tmp(operator[](start));
+#endif
+                unsigned j = start;
+                while (perm[j] != start)
+                {
+                    transfer(operator[](j), operator[](perm[j]));
+                    placed[j] = true;
+                    j = perm[j];
+                }
+                transfer(operator[](j), tmp);
+                placed[j] = true;
+            }
+
+            resize(_order.size());
+        }
+
+        /** Removes an individual by putting the last one in its place, which keeps the others where they are
+            and is cheaper than erase(). The individual removed is kept aside as by resize(). */
+        void erase_unordered(typename std::vector<EOT>::iterator _it)
+        {
+            if (_it + 1 != end())
+            {
+#if __cplusplus >= 201103L
+                std::swap(*_it, std::vector<EOT>::back());
+#else
+                *_it = std::vector<EOT>::back();
+#endif
+            }
+            resize(size() - 1);
+        }
+
+        /** Moves an individual, or copies it without C++11 */
+        static void transfer(EOT& _to, EOT& _from)
+        {
+#if __cplusplus >= 201103L
+            _to = std::move(_from);
+#else
+            _to = _from;
+#endif
+        }
+
+        /** Destroys the individuals kept aside */
+        void release_spare()
+        {
+            std::vector<EOT>().swap(spare);
+        }
+
+        /** Number of individuals kept aside */
+        size_t spare_size() const { return spare.size(); }
+        //@}
+
+
         /**
          * Prints sorted pop but does NOT modify it!
          *
@@ -359,6 +573,27 @@ class eoPop: public std::vector<EOT>, public eoObject, public eoPersistent
         }
 
 
+        /**
+         * Write object in binary: populations of raw individuals (see eoRawIndividual) are written as raw blocks of
+         * fitnesses and genes, the others in text.
+         * @param _os A std::ostream, opened in binary mode.
+         */
+        virtual void printBinaryOn(std::ostream& _os) const
+        {
+            eoRawFormat< eoPop<EOT> >::printOn(_os, *this);
+        }
+
+
+        /**
+         * Read object written by printBinaryOn.
+         * @param _is A std::istream, opened in binary mode.
+         */
+        virtual void readBinaryFrom(std::istream& _is)
+        {
+            eoRawFormat< eoPop<EOT> >::readFrom(_is, *this);
+        }
+
+
         /** Inherited from eoObject. Returns the class name.
           @see eoObject
           */
@@ -374,6 +609,19 @@ class eoPop: public std::vector<EOT>, public eoObject, public eoPersistent
                 this->operator[](i).invalidate();
         }
 
+    private:
+
+        /** Individuals dropped by recycle() and resize(), which are not copied along with the population */
+        class Spare : public std::vector<EOT>
+        {
+        public:
+            Spare() {}
+            Spare(const Spare&) : std::vector<EOT>() {}
+            Spare& operator=(const Spare&) { return *this; }
+        };
+
+        Spare spare;
+
 }; // class eoPop
 
 #endif // _EOPOP_H_
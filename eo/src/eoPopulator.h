@@ -185,6 +185,10 @@ private:
 
 /** SelectivePopulator an eoPoplator that uses an eoSelectOne to select guys.
 Supposedly, it is passed the initial population.
+
+The selector is set up on the initial population, unless _setup is false:
+this allows several populators to share a selector that was set up once
+beforehand (e.g. one populator per thread in eoParallelGeneralBreeder).
  */
 template <class EOT>
 class eoSelectivePopulator : public eoPopulator<EOT>
@@ -193,9 +197,9 @@ public :
 
     using eoPopulator< EOT >::src;
 
-    eoSelectivePopulator(const eoPop<EOT>& _pop, eoPop<EOT>& _dest, eoSelectOne<EOT>& _sel)
+    eoSelectivePopulator(const eoPop<EOT>& _pop, eoPop<EOT>& _dest, eoSelectOne<EOT>& _sel, bool _setup = true)
         : eoPopulator<EOT>(_pop, _dest), sel(_sel)
-        { sel.setup(_pop); };
+        { if (_setup) sel.setup(_pop); };
 
     /** the select method actually selects one guy from the src pop */
     const EOT& select() {
@@ -71,7 +71,7 @@ public:
   {
       if (cumulative.size() == 0) setup(_pop);
 
-      double fortune = rng.uniform() * cumulative.back();
+      double fortune = eo::threadRng().uniform() * cumulative.back();
       typename FitVec::iterator result = std::upper_bound(cumulative.begin(), cumulative.end(), fortune);
       return _pop[result - cumulative.begin()];
   }
@@ -46,7 +46,7 @@ template <class EOT> class eoRandomSelect: public eoSelectOne<EOT>
   /// not a big deal!!!
   virtual const EOT& operator()(const eoPop<EOT>& _pop)
   {
-    return _pop[eo::rng.random(_pop.size())] ;
+    return _pop[eo::threadRng().random(_pop.size())] ;
   }
 };
 
@@ -37,11 +37,11 @@
  *  @ingroup Selectors
  */
 template <class EOT>
-class eoRanking : public eoPerf2Worth<EOT> // false: do not cache fitness
+class eoRanking : public eoPerf2WorthCached<EOT, double> // worths are only recomputed when a fitness changes
 {
 public:
 
-    using eoPerf2Worth<EOT>::value;
+    using eoPerf2WorthCached<EOT, double>::value;
 
   /* Ctor:
    @param _p selective pressure (in (1,2]
@@ -50,7 +50,9 @@ public:
   eoRanking(double _p=2.0, double _e=1.0):
     pressure(_p), exponent(_e) {}
 
-  /* helper function: finds index in _pop of _eo, an EOT * */
+  /* helper function: finds index in _pop of _eo, an EOT *
+     (not used any more by the ranking itself, which sorts indices)
+  */
   int lookfor(const EOT *_eo, const eoPop<EOT>& _pop)
     {
       typename eoPop<EOT>::const_iterator it;
@@ -62,20 +64,27 @@ public:
       throw std::runtime_error("Not found in eoLinearRanking");
     }
 
+  /* checks the size of the population before looking at the fitness cache */
+  virtual void operator()(const eoPop<EOT>& _pop)
+    {
+      if (_pop.size() <= 1)
+        throw std::runtime_error("Cannot do ranking with population of size <= 1");
+
+      eoPerf2WorthCached<EOT, double>::operator()(_pop);
+    }
+
   /* COmputes the ranked fitness: fitnesses range in [m,M]
      with m=2-pressure/popSize and M=pressure/popSize.
      in between, the progression depstd::ends on exponent (linear if 1).
+     Equal fitnesses are ranked in the order of the population.
    */
-  virtual void operator()(const eoPop<EOT>& _pop)
+  virtual void calculate_worths(const eoPop<EOT>& _pop)
     {
-      std::vector<const EOT *> rank;
+      std::vector<unsigned> rank;
       _pop.sort(rank);
       unsigned pSize =_pop.size();
       unsigned int pSizeMinusOne = pSize-1;
 
-      if (pSize <= 1)
-        throw std::runtime_error("Cannot do ranking with population of size <= 1");
-
       // value() refers to the std::vector of worthes (we're in an eoParamvalue)
       value().resize(pSize);
 
@@ -85,8 +94,7 @@ public:
           double alpha = (2*pressure-2)/(pSize*pSizeMinusOne);
           for (unsigned i=0; i<pSize; i++)
             {
-              int which = lookfor(rank[i], _pop);
-              value()[which] = alpha*(pSize-i)+beta; // worst -> 1/[P(P-1)/2]
+              value()[rank[i]] = alpha*(pSize-i)+beta; // worst -> 1/[P(P-1)/2]
             }
         }
       else                                 // exponent != 1
@@ -94,11 +102,10 @@ public:
           double gamma = (2*pressure-2)/pSize;
           for (unsigned i=0; i<pSize; i++)
             {
-              int which = lookfor(rank[i], _pop);
               // value in in [0,1]
               double tmp = ((double)(pSize-i))/pSize;
               // to the exponent, and back to [m,M]
-              value()[which] = gamma*pow(tmp, exponent)+beta;
+              value()[rank[i]] = gamma*pow(tmp, exponent)+beta;
             }
         }
     }
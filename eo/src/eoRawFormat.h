@@ -0,0 +1,199 @@
+/* -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+  -----------------------------------------------------------------------------
+  eoRawFormat.h
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+    Contact: http://eodev.sourceforge.net
+ */
+
+#ifndef eoRawFormat_h
+#define eoRawFormat_h
+
+#include <stdint.h>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include <eoVector.h>
+#include <eoScalarFitness.h>
+
+template <class FitT> class eoReal;
+template <class FitT> class eoInt;
+
+/** @addtogroup Utilities
+ * @{
+ */
+
+/**
+ * Tells whether a type can be written as raw bytes, and as which scalar type.
+ *
+ * Specialized for arithmetic types and for eoScalarFitness of them. bool is not raw, as std::vector<bool> does
+ * not store its elements contiguously.
+ */
+template <class T>
+struct eoRawTraits
+{
+    enum { value = false };
+};
+
+#define EO_RAW_TYPE(T) \
+    template <> struct eoRawTraits<T> { enum { value = true }; typedef T type; };
+
+EO_RAW_TYPE(char)
+EO_RAW_TYPE(signed char)
+EO_RAW_TYPE(unsigned char)
+EO_RAW_TYPE(short)
+EO_RAW_TYPE(unsigned short)
+EO_RAW_TYPE(int)
+EO_RAW_TYPE(unsigned int)
+EO_RAW_TYPE(long)
+EO_RAW_TYPE(unsigned long)
+EO_RAW_TYPE(float)
+EO_RAW_TYPE(double)
+EO_RAW_TYPE(long double)
+
+#undef EO_RAW_TYPE
+
+template <class ScalarType, class Compare>
+struct eoRawTraits< eoScalarFitness<ScalarType, Compare> >
+{
+    enum { value = eoRawTraits<ScalarType>::value };
+    typedef ScalarType type;
+};
+
+/**
+ * Tells whether an individual is entirely described by its fitness and its genes, which are then written as raw
+ * blocks of bytes.
+ *
+ * It is given by the exact type of the individual, and not by its base class: the classes deriving from eoVector
+ * often carry more data (the standard deviations of eoEsStdev, the velocities of the particles...). Specialize it
+ * for your own eoVector-like individuals.
+ */
+template <class EOT>
+struct eoRawIndividual
+{
+    enum { value = false };
+};
+
+template <class Fit, class Atom>
+struct eoRawIndividual< eoVector<Fit, Atom> >
+{
+    enum { value = eoRawTraits<Fit>::value && eoRawTraits<Atom>::value };
+};
+
+template <class Fit>
+struct eoRawIndividual< eoReal<Fit> >
+{
+    enum { value = eoRawIndividual< eoVector<Fit, double> >::value };
+};
+
+template <class Fit>
+struct eoRawIndividual< eoInt<Fit> >
+{
+    enum { value = eoRawIndividual< eoVector<Fit, int> >::value };
+};
+
+/**
+ * Writes and reads vectors of individuals in binary, see eoPop::printBinaryOn.
+ *
+ * This generic version is used for the individuals that are not raw: it simply goes through the text format of
+ * the population.
+ */
+template <class Pop, bool raw = eoRawIndividual<typename Pop::value_type>::value>
+struct eoRawFormat
+{
+    static void printOn(std::ostream& _os, const Pop& _pop)
+    {
+        _pop.printOn(_os);
+    }
+
+    static void readFrom(std::istream& _is, Pop& _pop)
+    {
+        _pop.readFrom(_is);
+    }
+};
+
+/**
+ * Raw individuals: the size of the population, then for each individual the size of its genome, its validity
+ * flag, its fitness and its genes, all in the native representation of the machine.
+ */
+template <class Pop>
+struct eoRawFormat<Pop, true>
+{
+    typedef typename Pop::value_type EOT;
+    typedef typename eoRawTraits<typename EOT::Fitness>::type FitnessType;
+    typedef typename EOT::AtomType AtomType;
+
+    static void printOn(std::ostream& _os, const Pop& _pop)
+    {
+        uint64_t size = _pop.size();
+        _os.write(reinterpret_cast<const char*>(&size), sizeof(size));
+
+        for (size_t i = 0; i < _pop.size(); ++i)
+        {
+            const EOT& eo = _pop[i];
+            uint64_t length = eo.size();
+            char invalid = eo.invalid();
+            FitnessType fitness = invalid ? FitnessType() : static_cast<FitnessType>(eo.fitness());
+
+            _os.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            _os.write(&invalid, 1);
+            _os.write(reinterpret_cast<const char*>(&fitness), sizeof(fitness));
+            if (length > 0)
+                _os.write(reinterpret_cast<const char*>(&eo[0]), length * sizeof(AtomType));
+        }
+    }
+
+    static void readFrom(std::istream& _is, Pop& _pop)
+    {
+        uint64_t size;
+        read(_is, &size, sizeof(size));
+        _pop.resize(size);
+
+        for (size_t i = 0; i < _pop.size(); ++i)
+        {
+            EOT& eo = _pop[i];
+            uint64_t length;
+            char invalid;
+            FitnessType fitness;
+
+            read(_is, &length, sizeof(length));
+            read(_is, &invalid, 1);
+            read(_is, &fitness, sizeof(fitness));
+            eo.resize(length);
+            if (length > 0)
+                read(_is, &eo[0], length * sizeof(AtomType));
+
+            if (invalid)
+                eo.invalidate();
+            else
+                eo.fitness(fitness);
+        }
+    }
+
+private:
+
+    static void read(std::istream& _is, void* _data, size_t _size)
+    {
+        if (!_is.read(static_cast<char*>(_data), _size))
+            throw std::runtime_error("Truncated population in binary format");
+    }
+};
+
+/** @} */
+
+#endif
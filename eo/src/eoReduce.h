@@ -59,8 +59,14 @@ template <class EOT> class eoTruncate : public eoReduce<EOT>
         if (_newgen.size() < _newsize)
           throw std::logic_error("eoTruncate: Cannot truncate to a larger size!\n");
 
-        _newgen.sort();
-        _newgen.resize(_newsize);
+        // sorts the indices of the survivors, which are then moved once
+        std::vector<unsigned> order(_newgen.size());
+        for (unsigned i = 0; i < order.size(); ++i)
+            order[i] = i;
+        std::partial_sort(order.begin(), order.begin() + _newsize, order.end(),
+                          typename eoPop<EOT>::CmpIndex(_newgen));
+        order.resize(_newsize);
+        _newgen.reorder(order);
     }
 };
 
@@ -76,9 +82,14 @@ template <class EOT> class eoRandomReduce : public eoReduce<EOT>
         if (_newgen.size() < _newsize)
           throw std::logic_error("eoRandomReduce: Cannot truncate to a larger size!\n");
 
-        // shuffle the population, then trucate
-        _newgen.shuffle();
-        _newgen.resize(_newsize);
+        // shuffle the indices of the population, then trucate
+        std::vector<unsigned> order(_newgen.size());
+        for (unsigned i = 0; i < order.size(); ++i)
+            order[i] = i;
+        UF_random_generator<unsigned int> gen;
+        std::random_shuffle(order.begin(), order.end(), gen);
+        order.resize(_newsize);
+        _newgen.reorder(order);
     }
 };
 
@@ -105,12 +116,14 @@ public:
     /// helper struct for comparing on std::pairs
     // compares the scores
     // uses the fitness if scores are equals ????
-    typedef std::pair<float, typename eoPop<EOT>::iterator>  EPpair;
+    typedef std::pair<float, unsigned>  EPpair;
     struct Cmp {
+	Cmp(const eoPop<EOT>& _pop) : pop(_pop) {}
+	const eoPop<EOT>& pop;
 	bool operator()(const EPpair a, const EPpair b) const
 	{
 	    if (b.first == a.first)
-		return  (*b.second < *a.second);
+		return  (pop[b.second] < pop[a.second]);
 	    return b.first < a.first;
 	}
     };
@@ -127,7 +140,7 @@ public:
         std::vector<EPpair> scores(presentSize);
         for (unsigned i=0; i<presentSize; i++)
 	    {
-		scores[i].second = _newgen.begin()+i;
+		scores[i].second = i;
 		Fitness fit = _newgen[i].fitness();
 		for (unsigned itourn = 0; itourn < t_size; ++itourn)
 		    {
@@ -141,36 +154,26 @@ public:
 
         // now we have the scores
         typename std::vector<EPpair>::iterator it = scores.begin() + _newsize;
-        std::nth_element(scores.begin(), it, scores.end(), Cmp());
+        std::nth_element(scores.begin(), it, scores.end(), Cmp(_newgen));
         // sort(scores.begin(), scores.end(), Cmp());
         unsigned j;
 	//      std::cout << "Les scores apres tri\n";
 	//      for (j=0; j<scores.size(); j++)
 	//        {
-	//          std::cout << scores[j].first << " " << *scores[j].second << std::endl;
+	//          std::cout << scores[j].first << " " << _newgen[scores[j].second] << std::endl;
 	//        }
 
-	tmPop.reserve(presentSize);
-	tmPop.clear();
-
+        // the survivors are moved once to the front, the others are removed
+        std::vector<unsigned> order(_newsize);
         for (j=0; j<_newsize; j++)
 	    {
-		tmPop.push_back(*scores[j].second);
+		order[j] = scores[j].second;
 	    }
 
-        _newgen.swap(tmPop);
-
-        // erase does not work, but I'm sure there is a way in STL to mark
-        // and later delete all inside a std::vector ??????
-        // this would avoid all copies here
-
-	//      it = scores.begin() + _newsize;
-	//      while (it < scores.end())
-	//        _newgen.erase(it->second);
+        _newgen.reorder(order);
     }
 private:
     unsigned t_size;
-    eoPop<EOT> tmPop;
 };
 
 /** a truncate class that does not sort, but repeatidely kills the worse.
@@ -190,7 +193,7 @@ class eoLinearTruncate : public eoReduce<EOT>
     for (unsigned i=0; i<oldSize - _newsize; i++)
       {
         typename eoPop<EOT>::iterator it = _newgen.it_worse_element();
-        _newgen.erase(it);
+        _newgen.erase_unordered(it);
       }
   }
 };
@@ -238,7 +241,7 @@ public:
         // in the new code from stdc++v3 an iterator from a container<T> is no longer an pointer to T
         // Because eo already contained a fuction using eoPop<EOT>::iterator's we will use the following
 
-        _newgen.erase( inverse_deterministic_tournament(_newgen.begin(), _newgen.end(), t_size) );
+        _newgen.erase_unordered( inverse_deterministic_tournament(_newgen.begin(), _newgen.end(), t_size) );
 
       }
   }
@@ -291,7 +294,7 @@ public:
         // in the new code from stdc++v3 an iterator from a container<T> is no longer an pointer to T
         // Because eo already contained a fuction using eoPop<EOT>::iterator's we will use the following
 
-        _newgen.erase( inverse_stochastic_tournament(_newgen.begin(), _newgen.end(), t_rate) );
+        _newgen.erase_unordered( inverse_stochastic_tournament(_newgen.begin(), _newgen.end(), t_rate) );
 
 
       }
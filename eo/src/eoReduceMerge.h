@@ -66,7 +66,7 @@ class eoReduceMerge : public eoReplacement<EOT>
           if (_parents.size() < _offspring.size())
             throw std::logic_error("eoReduceMerge: More offspring than parents!\n");
           reduce(_parents, _parents.size() - _offspring.size());
-          merge(_offspring, _parents);
+          merge.moveInto(_offspring, _parents);
         }
 
     private :
@@ -67,23 +67,24 @@ public:
 
     void operator()(eoPop<EOT> & _parents, eoPop<EOT> & _offspring)
     {
-      eoPop<EOT> temp;
       unsigned int finalPopSize = _parents.size();
       unsigned int offSize = _offspring.size();
 
       unsigned int elite = howManyElite(finalPopSize);
+      temp.resize(elite);
       if (elite)                   // some parents MUST be saved somewhere
         {
-          temp.resize(elite);
-          _parents.nth_element(elite);
-          std::copy(_parents.begin(), _parents.begin()+elite, temp.begin());
-          _parents.erase(_parents.begin(), _parents.begin()+elite);
+          std::vector<unsigned> order;
+          _parents.nth_element(elite, order);
+          for (unsigned i = 0; i < elite; ++i)
+            eoPop<EOT>::transfer(temp[i], _parents[order[i]]);
+          _parents.reorder(std::vector<unsigned>(order.begin()+elite, order.end()));
         }
 
       // the reduce steps. First the parents
       unsigned reducedParentSize = howManyReducedParents(_parents.size());
       if (!reducedParentSize)
-        _parents.clear();
+        _parents.resize(0);
       else if (reducedParentSize != _parents.size())
         reduceParents(_parents, reducedParentSize);
 
@@ -95,9 +96,7 @@ public:
         reduceOffspring(_offspring, reducedOffspringSize);
 
       // now merge reduced populations
-      _parents.resize(reducedParentSize + _offspring.size());
-      std::copy(_offspring.begin(), _offspring.end(),
-                _parents.begin()+reducedParentSize);
+      plus.moveInto(_offspring, _parents);
 
       // reduce the resulting population
       // size depstd::ends on elitism
@@ -106,9 +105,7 @@ public:
           if (_parents.size() != finalPopSize-elite)
             reduceFinal(_parents, finalPopSize-elite);
           // and put back the elite
-          unsigned oldPSize = _parents.size();
-          _parents.resize(_parents.size()+elite);
-          std::copy(temp.begin(), temp.end(), _parents.begin()+oldPSize);
+          plus.moveInto(temp, _parents);
         }
       else
         {                   // only reduce final pop to right size
@@ -117,14 +114,16 @@ public:
           if (elite)       // then treat weak elitism
             {
               unsigned toSave = 0;
-              _parents.sort();
+              std::vector<unsigned> order;
+              _parents.sort(order);
+              _parents.reorder(order);
               EOT & eoLimit = _parents[elite-1];
               unsigned index=0;
               while ( (temp[index++] > eoLimit) && (index < temp.size()) )
                 toSave++;
               if (toSave)
                 for (unsigned i=0; i<toSave; i++)
-                  _parents[finalPopSize-1-i] = temp[i];
+                  eoPop<EOT>::transfer(_parents[finalPopSize-1-i], temp[i]);
             }
         }
     }
@@ -138,6 +137,9 @@ private:
   eoReduce<EOT> & reduceParents;
   eoReduce<EOT> & reduceOffspring;
   eoReduce<EOT> & reduceFinal;
+  // the elite parents, kept to reuse their storage
+  eoPop<EOT> temp;
+  eoPlus<EOT> plus;
 };
 
 #endif
@@ -26,57 +26,35 @@
 #ifndef eoSharing_h
 #define eoSharing_h
 
+#include <typeinfo>
+#include <algorithm>
+
 #include <eoPerf2Worth.h>
+#include <eoVector.h>
 #include <utils/eoDistance.h>
+#include <utils/eoParallel.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /** Sharing is a perf2worth class that implements
  *  Goldberg and Richardson's basic sharing
 */
 
-/** A helper class for Sharing - to  hold distances
- *
- * @ingroup Selectors
- * */
-class dMatrix : public std::vector<double>
-  {
-  public:
-    // Ctor : sets size
-    dMatrix(unsigned _s) : std::vector<double>(_s*_s), rSize(_s) {}
-
-    /** simple accessor */
-    double operator()(unsigned _i, unsigned _j) const
-    {
-      return this->operator[](_i*rSize + _j);
-    }
-
-    /** reference - to set values */
-    double & operator()(unsigned _i, unsigned _j)
-    {
-      return this->operator[](_i*rSize + _j);
-    }
-
-    /** just in case */
-    void printOn(std::ostream & _os)
-    {
-      unsigned index=0;
-      for (unsigned i=0; i<rSize; i++)
-        {
-          for (unsigned j=0; j<rSize; j++)
-            _os << this->operator[](index++) << " " ;
-          _os << std::endl;
-        }
-      _os << std::endl;
-    }
-
-    private:
-      unsigned rSize;              // row size (== number of columns!)
-  };
-
-
 /** Sharing is a perf2worth class that implements
  *  Goldberg and Richardson's basic sharing
  *  see eoSharingSelect for how to use it
  * and test/t-eoSharing.cpp for a sample use of both
+ *
+ * The niche counts are accumulated on the fly, without storing the distance
+ * matrix: only the lower triangle is computed, by square tiles of tileSize
+ * individuals so that both rows stay in cache. Rows of tiles are dealt in turn
+ * to the threads when the parallelization is enabled (--parallelize-loop): the
+ * niche counts are then the same on every run with the same number of
+ * threads, and the distance must be thread-safe. eoQuadDistance and eoHammingDistance are
+ * called directly, without going through a virtual call for each pair.
+ *
  * @ingroup Selectors
 */
 template <class EOT>
@@ -97,41 +75,129 @@ public:
   */
     void operator()(const eoPop<EOT>& _pop)
     {
-      unsigned i, j,
+      unsigned i,
         pSize=_pop.size();
       if (pSize <= 1)
         throw std::runtime_error("Apptempt to do sharing with population of size 1");
       value().resize(pSize);
       std::vector<double> sim(pSize);      // to hold the similarities
-      dMatrix distMatrix(pSize); // to hold the distances
-
-      // compute the similarities (wrong name for distMatrix, I know)
-      distMatrix(0,0)=1;
-      for (i=1; i<pSize; i++)
-        {
-          distMatrix(i,i)=1;
-          for (j=0; j<i; j++)
-            {
-              double d =  dist(_pop[i], _pop[j]);
-              distMatrix(i,j) =
-                distMatrix(j,i) = ( d>nicheSize ? 0 : 1-(d/nicheSize) );
-            }
-        }
-
-      for (i=0; i<pSize; i++)
-        {
-          double sum=0.0;
-          for (j=0; j<pSize; j++)
-            sum += distMatrix(i,j);
-          sim[i] = sum;
-        }
+
+      niche_counts(_pop, sim, static_cast<const EOT*>(0));
 
       // now set the worthes values
       for (i = 0; i < _pop.size(); ++i)
         value()[i]=_pop[i].fitness()/sim[i];
     }
-    // private data of class eoSharing
+
 private:
+
+  /// number of individuals per side of a tile of the similarity matrix
+  static const unsigned tileSize = 64;
+
+  /** Niche counts of vectors: use the fast paths if possible */
+  template <class Fit, class Atom>
+  void niche_counts(const eoPop<EOT>& _pop, std::vector<double>& _sim, const eoVector<Fit, Atom>*)
+  {
+    if (typeid(dist) == typeid(eoQuadDistance<EOT>))
+      niche_counts(_pop, QuadCall(static_cast<eoQuadDistance<EOT>&>(dist)), _sim);
+    else if (typeid(dist) == typeid(eoHammingDistance<EOT>))
+      niche_counts(_pop, HammingCall(static_cast<eoHammingDistance<EOT>&>(dist)), _sim);
+    else
+      niche_counts(_pop, VirtualCall(dist), _sim);
+  }
+
+  /** Niche counts of any other kind of individuals */
+  void niche_counts(const eoPop<EOT>& _pop, std::vector<double>& _sim, const void*)
+  {
+    niche_counts(_pop, VirtualCall(dist), _sim);
+  }
+
+  /** Computes the niche count of every individual (its similarity with itself included) */
+  template <class Distance>
+  void niche_counts(const eoPop<EOT>& _pop, Distance _dist, std::vector<double>& _sim)
+  {
+    unsigned pSize = _pop.size();
+    unsigned nTiles = (pSize + tileSize - 1) / tileSize;
+
+    unsigned nThreads = 1;
+#ifdef _OPENMP
+    if (eo::parallel.isEnabled())
+      nThreads = omp_get_max_threads();
+#endif // _OPENMP
+
+    // one line of partial sums per thread
+    std::vector<double> partial(nThreads * pSize, 0.0);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1) num_threads(nThreads) if(nThreads > 1)
+#endif // _OPENMP
+    // the largest rows of tiles first, dealt in turn to the threads: each
+    // line of partial sums gets the same contributions in the same order on
+    // every run, so that the niche counts are reproducible
+    for (int ti = static_cast<int>(nTiles) - 1; ti >= 0; --ti)
+      {
+        unsigned thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif // _OPENMP
+        double* sum = &partial[thread * pSize];
+
+        unsigned iBegin = ti * tileSize;
+        unsigned iEnd = std::min(iBegin + tileSize, pSize);
+
+        for (unsigned tj = 0; tj <= static_cast<unsigned>(ti); ++tj)
+          {
+            unsigned jBegin = tj * tileSize;
+            for (unsigned i = iBegin; i < iEnd; ++i)
+              {
+                unsigned jEnd = std::min(jBegin + tileSize, i);
+                for (unsigned j = jBegin; j < jEnd; ++j)
+                  {
+                    double d = _dist(_pop[i], _pop[j]);
+                    if (d < nicheSize)
+                      {
+                        double s = 1 - (d/nicheSize);
+                        sum[i] += s;
+                        sum[j] += s;
+                      }
+                  }
+              }
+          }
+      }
+
+    for (unsigned i = 0; i < pSize; ++i)
+      {
+        _sim[i] = 1;                       // similarity with itself
+        for (unsigned t = 0; t < nThreads; ++t)
+          _sim[i] += partial[t * pSize + i];
+      }
+  }
+
+  /** Calls any distance through its virtual operator() */
+  struct VirtualCall
+  {
+    VirtualCall(eoDistance<EOT>& _d) : d(_d) {}
+    double operator()(const EOT& _eo1, const EOT& _eo2) const { return d(_eo1, _eo2); }
+    eoDistance<EOT>& d;
+  };
+
+  /** Calls eoQuadDistance directly */
+  struct QuadCall
+  {
+    QuadCall(eoQuadDistance<EOT>& _d) : d(_d) {}
+    double operator()(const EOT& _eo1, const EOT& _eo2) const { return d.eoQuadDistance<EOT>::operator()(_eo1, _eo2); }
+    eoQuadDistance<EOT>& d;
+  };
+
+  /** Calls eoHammingDistance directly */
+  struct HammingCall
+  {
+    HammingCall(eoHammingDistance<EOT>& _d) : d(_d) {}
+    double operator()(const EOT& _eo1, const EOT& _eo2) const { return d.eoHammingDistance<EOT>::operator()(_eo1, _eo2); }
+    eoHammingDistance<EOT>& d;
+  };
+
+    // private data of class eoSharing
   double nicheSize;
   eoDistance<EOT> & dist;            // specific distance
 };
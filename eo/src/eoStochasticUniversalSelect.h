@@ -65,7 +65,7 @@ public:
       indices.reserve(_pop.size());
       indices.resize(0);
 
-      double fortune = rng.uniform() * cumulative.back();
+      double fortune = eo::threadRng().uniform() * cumulative.back();
       double step = cumulative.back() / double(_pop.size());
 
       unsigned i = std::upper_bound(cumulative.begin(), cumulative.end(), fortune) - cumulative.begin();
@@ -83,7 +83,7 @@ public:
       }
       // shuffle
       for (int i = indices.size() - 1; i > 0; --i) {
-          int j = rng.random(i+1);
+          int j = eo::threadRng().random(i+1);
           std::swap(indices[i], indices[j]);
       }
   }
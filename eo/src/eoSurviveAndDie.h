@@ -92,31 +92,30 @@ public:
     {
         unsigned pSize = _pop.size();
         unsigned nbSurvive = howmanySurvive(pSize);
-        // first, save the best into _luckyGuys
-        if (nbSurvive)
-            {
-                _pop.nth_element(nbSurvive);
-                // copy best
-                _luckyGuys.resize(nbSurvive);
-                std::copy(_pop.begin(), _pop.begin()+nbSurvive, _luckyGuys.begin());
-                // erase them from pop
-                _pop.erase(_pop.begin(), _pop.begin()+nbSurvive);
-            }
-        unsigned nbRemaining = _pop.size();
 
         // carefull, we can have a rate of 1 if we want to kill all remaining
         unsigned nbDie = std::min(howmanyDie(pSize), pSize-nbSurvive);
-        if (nbDie > nbRemaining)
+        if (nbDie > pSize-nbSurvive)
             throw std::logic_error("eoDeterministicSurviveAndDie: Too many to kill!\n");
 
-        if (!nbDie)
-          {
+        _luckyGuys.resize(nbSurvive);
+        if (!nbSurvive && !nbDie)
             return;
-          }
-        // else
-        // kill the worse nbDie
-        _pop.nth_element(nbRemaining-nbDie);
-        _pop.resize(nbRemaining-nbDie);
+
+        // the indices of the best first, and of the worse last
+        std::vector<unsigned> order;
+        _pop.nth_element(nbSurvive, order);
+        typename eoPop<EOT>::CmpIndex cmp(_pop);
+        if (nbDie)
+            std::nth_element(order.begin() + nbSurvive, order.end() - nbDie, order.end(), cmp);
+
+        // first, move the best into _luckyGuys
+        for (unsigned i = 0; i < nbSurvive; ++i)
+            eoPop<EOT>::transfer(_luckyGuys[i], _pop[order[i]]);
+
+        // then keep the others, except the worse nbDie
+        std::vector<unsigned> remaining(order.begin() + nbSurvive, order.end() - nbDie);
+        _pop.reorder(remaining);
     }
 
 };
@@ -161,21 +160,18 @@ public:
     {
         unsigned pSize = _parents.size(); // target number of individuals
 
-        eoPop<EOT> luckyParents;       // to hold the absolute survivors
-        sAdParents(_parents, luckyParents);
-
-        eoPop<EOT> luckyOffspring;       // to hold the absolute survivors
+        sAdParents(_parents, luckyParents);     // the absolute survivors
         sAdOffspring(_offspring, luckyOffspring);
 
         unsigned survivorSize = luckyOffspring.size() + luckyParents.size();
         if (survivorSize > pSize)
             throw std::logic_error("eoGeneralReplacement: More survivors than parents!\n");
 
-        plus(_parents, _offspring); // all that remain in _offspring
+        plus.moveInto(_parents, _offspring); // all that remain in _offspring
 
         reduceGlobal(_offspring, pSize - survivorSize);
-        plus(luckyParents, _offspring);
-        plus(luckyOffspring, _offspring);
+        plus.moveInto(luckyParents, _offspring);
+        plus.moveInto(luckyOffspring, _offspring);
 
         _parents.swap(_offspring);
 
@@ -185,6 +181,9 @@ private :
   eoReduce<EOT>& reduceGlobal;
   eoDeterministicSurviveAndDie<EOT> sAdParents;
   eoDeterministicSurviveAndDie<EOT> sAdOffspring;
+  // to hold the absolute survivors, kept to reuse their storage
+  eoPop<EOT> luckyParents;
+  eoPop<EOT> luckyOffspring;
   // plus helper (could be replaced by operator+= ???)
   eoPlus<EOT> plus;
   // the default reduce: deterministic truncation
@@ -206,7 +206,7 @@ void CMAParams::defaults(unsigned n_, unsigned maxgen_) {
     weights /= sumw;
 
     mucov = mueff;
-    ccumsig *= (mueff + 2.) / (n + mueff + 3.);
+    ccumsig = (mueff + 2.) / (n + mueff + 3.);
     ccumcov = 4. / (n + 4);
 
     double t1 = 2. / ((n+1.4142)*(n+1.4142));
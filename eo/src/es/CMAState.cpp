@@ -55,6 +55,7 @@
 #include <limits>
 #include <iostream>
 #include <cassert>
+#include <algorithm>
 
 #include <utils/eoRNG.h>
 
@@ -120,6 +121,39 @@ struct CMAStateImpl {
         }
     }
 
+    /* number of samples multiplied by a row of B while it is in cache */
+    static const unsigned sampleBlock = 32;
+
+    void sample(const vector<vector<double>* >& batch) {
+        unsigned n = p.n;
+        unsigned lambda = batch.size();
+
+        /* draw all D*z first, in the same order as single samples; sample k is row k of DZ */
+        vector<double> DZ(lambda * n);
+        for (unsigned k = 0; k < lambda; ++k) {
+            double* dz = &DZ[k * n];
+            for (unsigned i = 0; i < n; ++i)
+                dz[i] = d[i] * rng.normal();
+            batch[k]->resize(n);
+        }
+
+        /* X = mean + sigma * (DZ * B^T), by blocks of samples so that the rows of
+         * B and DZ are reused while in cache, with contiguous inner products */
+        for (unsigned k0 = 0; k0 < lambda; k0 += sampleBlock) {
+            unsigned k1 = std::min(lambda, k0 + sampleBlock);
+            for (unsigned i = 0; i < n; ++i) {
+                const double* b_row = &*B[i];
+                for (unsigned k = k0; k < k1; ++k) {
+                    const double* dz = &DZ[k * n];
+                    double sum = 0;
+                    for (unsigned j = 0; j < n; ++j)
+                        sum += b_row[j] * dz[j];
+                    (*batch[k])[i] = mean[i] + sigma * sum;
+                }
+            }
+        }
+    }
+
     void reestimate(const vector<const vector<double>* >& pop, double muBest, double muWorst) {
 
         assert(pop.size() == p.mu);
@@ -132,22 +166,27 @@ struct CMAStateImpl {
         valarray<double> BDz(n);
 
         /* calculate xmean and rgBDz~N(0,C) */
-        for (unsigned i = 0; i < n; ++i) {
-            mean[i] = 0.;
-            for (unsigned j = 0; j < pop.size(); ++j) {
-                mean[i] += p.weights[j] * (*pop[j])[i];
+        std::fill(mean.begin(), mean.end(), 0.);
+        for (unsigned j = 0; j < pop.size(); ++j) {
+            const vector<double>& x = *pop[j];
+            for (unsigned i = 0; i < n; ++i) {
+                mean[i] += p.weights[j] * x[i];
             }
+        }
+        for (unsigned i = 0; i < n; ++i) {
             BDz[i] = sqrt(p.mueff)*(mean[i] - oldmean[i])/sigma;
         }
 
-        vector<double> tmp(n);
-        /* calculate z := D^(-1) * B^(-1) * rgBDz into rgdTmp */
-        for (unsigned i = 0; i < n; ++i) {
-            double sum = 0.0;
-            for (unsigned j = 0; j < n; ++j) {
-                sum += B[j][i] * BDz[j];
+        vector<double> tmp(n, 0.0);
+        /* calculate z := D^(-1) * B^(-1) * rgBDz into rgdTmp (B^T row by row) */
+        for (unsigned j = 0; j < n; ++j) {
+            const double* b_row = &*B[j];
+            for (unsigned i = 0; i < n; ++i) {
+                tmp[i] += b_row[i] * BDz[j];
             }
-            tmp[i] = sum / d[i];
+        }
+        for (unsigned i = 0; i < n; ++i) {
+            tmp[i] /= d[i];
         }
 
         /* cumulation for sigma (ps) using B*z */
@@ -199,31 +238,34 @@ struct CMAStateImpl {
         if (p.ccov != 0.) {
             //flgEigensysIsUptodate = 0;
 
-            /* update covariance matrix */
+            /* steps of the selected points, one contiguous row of mu values per
+             * coordinate: Y[i][k] = (x_k[i] - oldmean[i]) / sigma, and WY[i][k] = w_k * Y[i][k] */
+            unsigned mu = p.mu;
+            vector<double> Y(n * mu), WY(n * mu);
+            for (unsigned k = 0; k < mu; ++k) {
+                const vector<double>& x = *pop[k];
+                for (unsigned i = 0; i < n; ++i) {
+                    Y[i * mu + k] = (x[i] - oldmean[i]) / sigma;
+                    WY[i * mu + k] = p.weights[k] * Y[i * mu + k];
+                }
+            }
+
+            double oldWeight = (1 - p.ccov) + (1-hsig) * p.ccumcov * (2. - p.ccumcov);
+            double rankOne = p.ccov * (1./p.mucov);
+            double rankMu = p.ccov * (1-1./p.mucov);
+
+            /* update covariance matrix: rank one update with pc, and rank mu
+             * update as C += rankMu * WY * Y^T, one inner product of length mu per entry */
             for (unsigned i = 0; i < n; ++i) {
                 vector<double>::iterator c_row = C[i];
+                const double* wy = &WY[i * mu];
                 for (unsigned j = 0; j <= i; ++j) {
-                    c_row[j] =
-                                (1 - p.ccov) * c_row[j]
-                                        +
-                                p.ccov * (1./p.mucov) * pc[i] * pc[j]
-                                        +
-                                (1-hsig) * p.ccumcov * (2. - p.ccumcov) * c_row[j];
-
-                    /*C[i][j] = (1 - p.ccov) * C[i][j]
-                        + sp.ccov * (1./sp.mucov)
-                        * (rgpc[i] * rgpc[j]
-                                + (1-hsig)*sp.ccumcov*(2.-sp.ccumcov) * C[i][j]); */
-                    for (unsigned k = 0; k < p.mu; ++k) { /* additional rank mu update */
-                        c_row[j] += p.ccov * (1-1./p.mucov) * p.weights[k]
-                            * ( (*pop[k])[i] - oldmean[i])
-                            * ( (*pop[k])[j] - oldmean[j])
-                            / sigma / sigma;
-
-                           // * (rgrgx[index[k]][i] - rgxold[i])
-                           // * (rgrgx[index[k]][j] - rgxold[j])
-                           // / sigma / sigma;
+                    const double* y = &Y[j * mu];
+                    double sum = 0.;
+                    for (unsigned k = 0; k < mu; ++k) {
+                        sum += wy[k] * y[k];
                     }
+                    c_row[j] = oldWeight * c_row[j] + rankOne * pc[i] * pc[j] + rankMu * sum;
                 }
             }
         }
@@ -356,6 +398,7 @@ CMAState::CMAState(const CMAState& that) : pimpl(new CMAStateImpl(*that.pimpl ))
 CMAState& CMAState::operator=(const CMAState& that) { *pimpl = *that.pimpl; return *this; }
 
 void CMAState::sample(vector<double>& v) const {  pimpl->sample(v); }
+void CMAState::sample(const vector<vector<double>* >& batch) const {  pimpl->sample(batch); }
 
 void CMAState::reestimate(const vector<const vector<double>* >& population, double muBest, double muWorst) { pimpl->reestimate(population, muBest, muWorst); }
 bool CMAState::updateEigenSystem(unsigned max_tries, unsigned max_iters) { return pimpl->updateEigenSystem(max_tries, max_iters); }
@@ -49,6 +49,15 @@ class CMAState {
      */
     void sample(std::vector<double>& v) const;
 
+    /**
+     *  sample a batch of vectors at once, as one matrix product
+     *
+     *  Each vector is resized to the dimensionality. The random numbers are
+     *  drawn in the same order as with as many calls to sample(v): for
+     *  the same seed, the batch is identical to the single samples.
+     */
+    void sample(const std::vector<std::vector<double>* >& batch) const;
+
     /**
      * Reestimate covariance matrix and other internal parameters
      * Does NOT update the eigen system (call that seperately)
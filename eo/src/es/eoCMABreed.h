@@ -37,11 +37,20 @@ class eoCMABreed : public eoBreed< eoVector<FitT, double> > {
 
     eo::CMAState& state;
     unsigned lambda;
+    unsigned eigenPeriod;
+    unsigned gen;
 
     typedef eoVector<FitT, double> EOT;
 
     public:
-    eoCMABreed(eo::CMAState& state_, unsigned lambda_) : state(state_), lambda(lambda_) {}
+    /**
+     * eigenPeriod: the (O(n^3)) eigen decomposition of the covariance matrix
+     * is only updated every eigenPeriod generations, the offspring being
+     * sampled with the last one in between (Hansen advises about
+     * 1/(10 n ccov) for large dimensions)
+     */
+    eoCMABreed(eo::CMAState& state_, unsigned lambda_, unsigned eigenPeriod_ = 1)
+        : state(state_), lambda(lambda_), eigenPeriod(std::max(1u, eigenPeriod_)), gen(0) {}
 
     void operator()(const eoPop<EOT>& parents, eoPop<EOT>& offspring) {
 
@@ -59,17 +68,19 @@ class eoCMABreed : public eoBreed< eoVector<FitT, double> > {
         // learn
         state.reestimate(mu, sorted[0]->fitness(), sorted.back()->fitness());
 
-        if (!state.updateEigenSystem(10)) {
+        if (++gen % eigenPeriod == 0 && !state.updateEigenSystem(10)) {
             std::cerr << "No good eigensystem found" << std::endl;
         }
 
-        // generate
+        // generate, all offspring at once
         offspring.resize(lambda);
 
+        std::vector<std::vector<double>* > batch(lambda);
         for (unsigned i = 0; i < lambda; ++i) {
-            state.sample( static_cast< std::vector<double>& >( offspring[i] ));
+            batch[i] = static_cast< std::vector<double>* >( &offspring[i] );
             offspring[i].invalidate();
         }
+        state.sample(batch);
 
     }
 };
@@ -101,9 +101,9 @@ template<class EOT> class eoUniformMutation: public eoMonOp<EOT>
       if (homogeneous)             // implies no bounds object
         for (unsigned lieu=0; lieu<_eo.size(); lieu++)
           {
-            if (rng.flip(p_change[0]))
+            if (eo::threadRng().flip(p_change[0]))
               {
-                _eo[lieu] += 2*epsilon[0]*rng.uniform()-epsilon[0];
+                _eo[lieu] += 2*epsilon[0]*eo::threadRng().uniform()-epsilon[0];
                 hasChanged = true;
               }
           }
@@ -114,7 +114,7 @@ template<class EOT> class eoUniformMutation: public eoMonOp<EOT>
             throw std::runtime_error("Invalid size of indi in eoUniformMutation");
 
           for (unsigned lieu=0; lieu<_eo.size(); lieu++)
-            if (rng.flip(p_change[lieu]))
+            if (eo::threadRng().flip(p_change[lieu]))
               {
                 // check the bounds
                 double emin = _eo[lieu]-epsilon[lieu];
@@ -123,7 +123,7 @@ template<class EOT> class eoUniformMutation: public eoMonOp<EOT>
                   emin = std::max(bounds.minimum(lieu), emin);
                 if (bounds.isMaxBounded(lieu))
                   emax = std::min(bounds.maximum(lieu), emax);
-                _eo[lieu] = emin + (emax-emin)*rng.uniform();
+                _eo[lieu] = emin + (emax-emin)*eo::threadRng().uniform();
                 hasChanged = true;
               }
         }
@@ -205,9 +205,9 @@ template<class EOT> class eoDetUniformMutation: public eoMonOp<EOT>
       if (homogeneous)
         for (unsigned i=0; i<no; i++)
           {
-            unsigned lieu = rng.random(_eo.size());
+            unsigned lieu = eo::threadRng().random(_eo.size());
             // actually, we should test that we don't re-modify same variable!
-            _eo[lieu] = 2*epsilon[0]*rng.uniform()-epsilon[0];
+            _eo[lieu] = 2*epsilon[0]*eo::threadRng().uniform()-epsilon[0];
           }
       else
         {
@@ -216,7 +216,7 @@ template<class EOT> class eoDetUniformMutation: public eoMonOp<EOT>
             throw std::runtime_error("Invalid size of indi in eoDetUniformMutation");
           for (unsigned i=0; i<no; i++)
             {
-              unsigned lieu = rng.random(_eo.size());
+              unsigned lieu = eo::threadRng().random(_eo.size());
               // actually, we should test that we don't re-modify same variable!
 
               // check the bounds
@@ -226,7 +226,7 @@ template<class EOT> class eoDetUniformMutation: public eoMonOp<EOT>
                 emin = std::max(bounds.minimum(lieu), emin);
               if (bounds.isMaxBounded(lieu))
                 emax = std::min(bounds.maximum(lieu), emax);
-              _eo[lieu] = emin + (emax-emin)*rng.uniform();
+              _eo[lieu] = emin + (emax-emin)*eo::threadRng().uniform();
             }
         }
       return true;
@@ -292,7 +292,7 @@ template<class EOT> class eoSegmentCrossover: public eoQuadOp<EOT>
       double alphaMin = -alpha;
       double alphaMax = 1+alpha;
       if (alpha == 0.0)            // no check to perform
-        fact = -alpha + rng.uniform(range); // in [-alpha,1+alpha)
+        fact = -alpha + eo::threadRng().uniform(range); // in [-alpha,1+alpha)
       else                         // look for the bounds for fact
         {
           for (i=0; i<_eo1.size(); i++)
@@ -315,7 +315,7 @@ template<class EOT> class eoSegmentCrossover: public eoQuadOp<EOT>
                   }
               }
             }
-          fact = alphaMin + (alphaMax-alphaMin)*rng.uniform();
+          fact = alphaMin + (alphaMax-alphaMin)*eo::threadRng().uniform();
         }
 
       for (i=0; i<_eo1.size(); i++)
@@ -395,7 +395,7 @@ template<class EOT> class eoHypercubeCrossover: public eoQuadOp<EOT>
               r1=_eo1[i];
               r2=_eo2[i];
               if (r1 != r2) {      // otherwise do nothing
-                fact = rng.uniform(range);       // in [0,1)
+                fact = eo::threadRng().uniform(range);       // in [0,1)
                 _eo1[i] = fact * r1 + (1-fact) * r2;
                 _eo2[i] = (1-fact) * r1 + fact * r2;
                 hasChanged = true; // forget (im)possible alpha=0
@@ -428,10 +428,10 @@ template<class EOT> class eoHypercubeCrossover: public eoQuadOp<EOT>
               // then draw variables
               double median = (objMin+objMax)/2.0; // uniform within bounds
               // double median = (rmin+rmax)/2.0;  // Bounce on bounds
-              double valMin = objMin + (median-objMin)*rng.uniform();
-              double valMax = median + (objMax-median)*rng.uniform();
+              double valMin = objMin + (median-objMin)*eo::threadRng().uniform();
+              double valMax = median + (objMax-median)*eo::threadRng().uniform();
               // don't always put large value in _eo1 - or what?
-              if (rng.flip(0.5))
+              if (eo::threadRng().flip(0.5))
                 {
                   _eo1[i] = valMin;
                   _eo2[i] = valMax;
@@ -492,7 +492,7 @@ template<class EOT> class eoRealUXover: public eoQuadOp<EOT>
       bool changed = false;
       for (unsigned int i=0; i<_eo1.size(); i++)
         {
-          if (rng.flip(preference))
+          if (eo::threadRng().flip(preference))
             if (_eo1[i] != _eo2[i])
               {
                 double tmp = _eo1[i];
@@ -31,9 +31,11 @@
 
 // all bitstring-specific files
 #include <ga/eoBit.h>
+#include <ga/eoPackedBit.h>
 
 // the operators
 #include <ga/eoBitOp.h>
+#include <ga/eoPackedBitOp.h>
 
 // #include <ga/eoBitOpFactory.h> to be corrected - thanks someone!
 
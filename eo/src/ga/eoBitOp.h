@@ -55,7 +55,7 @@ template<class Chrom> class eoOneBitFlip: public eoMonOp<Chrom>
    */
   bool operator()(Chrom& chrom)
     {
-      unsigned i = eo::rng.random(chrom.size());
+      unsigned i = eo::threadRng().random(chrom.size());
       chrom[i] = !chrom[i];
       return true;
     }
@@ -88,7 +88,7 @@ template<class Chrom> class eoDetBitFlip: public eoMonOp<Chrom>
       // for duplicate checking see eoDetSingleBitFlip
       for (unsigned k=0; k<num_bit; k++)
         {
-          unsigned i = eo::rng.random(chrom.size());
+          unsigned i = eo::threadRng().random(chrom.size());
           chrom[i] = !chrom[i];
         }
       return true;
@@ -131,7 +131,7 @@ template<class Chrom> class eoDetSingleBitFlip: public eoMonOp<Chrom>
 
 	    do
 		{
-		    temp = eo::rng.random( chrom.size() );
+		    temp = eo::threadRng().random( chrom.size() );
 		}
 	    while ( find( selected.begin(), selected.end(), temp ) != selected.end() );
 
@@ -178,7 +178,7 @@ template<class Chrom> class eoBitMutation: public eoMonOp<Chrom>
       double actualRate = (normalize ? rate/chrom.size() : rate);
       bool changed_something = false;
       for (unsigned i = 0; i < chrom.size(); i++)
-            if (eo::rng.flip(actualRate))
+            if (eo::threadRng().flip(actualRate))
         {
                 chrom[i] = !chrom[i];
             changed_something = true;
@@ -211,8 +211,8 @@ template<class Chrom> class eoBitInversion: public eoMonOp<Chrom>
   bool operator()(Chrom& chrom)
     {
 
-      unsigned u1 = eo::rng.random(chrom.size() + 1) , u2;
-      do u2 = eo::rng.random(chrom.size() + 1); while (u1 == u2);
+      unsigned u1 = eo::threadRng().random(chrom.size() + 1) , u2;
+      do u2 = eo::threadRng().random(chrom.size() + 1); while (u1 == u2);
       unsigned r1 = std::min(u1, u2), r2 = std::max(u1, u2);
 
       std::reverse(chrom.begin() + r1, chrom.begin() + r2);
@@ -307,7 +307,7 @@ template<class Chrom> class eo1PtBitXover: public eoQuadOp<Chrom>
    */
   bool operator()(Chrom& chrom1, Chrom& chrom2)
     {
-      unsigned site = eo::rng.random(std::min(chrom1.size(), chrom2.size()));
+      unsigned site = eo::threadRng().random(std::min(chrom1.size(), chrom2.size()));
 
       if (!std::equal(chrom1.begin(), chrom1.begin()+site, chrom2.begin()))
       {
@@ -351,7 +351,7 @@ template<class Chrom> class eoUBitXover: public eoQuadOp<Chrom>
       bool changed = false;
       for (unsigned int i=0; i<chrom1.size(); i++)
         {
-          if (chrom1[i] != chrom2[i] && eo::rng.flip(preference))
+          if (chrom1[i] != chrom2[i] && eo::threadRng().flip(preference))
             {
               bool tmp = chrom1[i];
               chrom1[i]=chrom2[i];
@@ -396,7 +396,7 @@ public:
 
         // select ranges of bits to swap
         do {
-            unsigned bit(eo::rng.random(max_size));
+            unsigned bit(eo::threadRng().random(max_size));
             if(points[bit])
                 continue;
             else {
@@ -464,7 +464,7 @@ template<class Chrom> class eoBitGxOver: public eoQuadOp<Chrom>
 
       // selects genes to swap
       do {
-        unsigned bit = eo::rng.random(max_genes);
+        unsigned bit = eo::threadRng().random(max_genes);
         if (points[bit])
           continue;
         else
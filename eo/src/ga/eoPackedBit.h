@@ -0,0 +1,211 @@
+/*
+   eoPackedBit.h
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+    Contact: http://eodev.sourceforge.net
+*/
+
+#ifndef eoPackedBit_h
+#define eoPackedBit_h
+
+//-----------------------------------------------------------------------------
+
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include <EO.h>
+#include <utils/eoDistance.h>
+
+/** Number of bits set in a 64 bits word
+@ingroup bitstring
+*/
+inline unsigned eoPopcount(uint64_t _word)
+{
+#ifdef __GNUC__
+    return __builtin_popcountll(_word);
+#else
+    _word = _word - ((_word >> 1) & 0x5555555555555555ULL);
+    _word = (_word & 0x3333333333333333ULL) + ((_word >> 2) & 0x3333333333333333ULL);
+    _word = (_word + (_word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (_word * 0x0101010101010101ULL) >> 56;
+#endif
+}
+
+/** Implementation of a bitstring chromosome packed into 64 bits words.
+
+@class eoPackedBit eoPackedBit.h ga/eoPackedBit.h
+@ingroup bitstring
+
+Bit i is bit i%64 of word i/64; the unused bits of the last word are always
+zero. Unlike eoBit, which is based on std::vector<bool>, the words are
+directly accessible, so that operators (see eoPackedBitOp.h) can work a whole
+word at a time.
+
+It is printed and read exactly like an eoBit (fitness, size, then the bits as
+a string of 0 and 1), so that both can read each other's files.
+*/
+template <class FitT> class eoPackedBit: public EO<FitT>
+{
+public:
+
+    typedef uint64_t Word;
+
+    /// Number of bits per word
+    static const unsigned wordSize = 64;
+
+  /**
+   * (Default) Constructor.
+   * @param _size Size of the binary std::string.
+   * @param _value Default value.
+   */
+  eoPackedBit(unsigned _size = 0, bool _value = false) : nbits(0)
+    {
+      resize(_size, _value);
+    }
+
+  /// My class name.
+  virtual std::string className() const
+    {
+      return "eoPackedBit";
+    }
+
+  /// Number of bits
+  unsigned size() const { return nbits; }
+
+  /// Change the number of bits, new bits are set to _value
+  void resize(unsigned _size, bool _value = false)
+    {
+      unsigned old = nbits;
+      nbits = _size;
+      data.resize((_size + wordSize - 1) / wordSize, 0);
+      if (_value)
+        for (unsigned i = old; i < _size; ++i)
+          set(i, true);
+      clear_tail();
+    }
+
+  /// Value of bit _i
+  bool operator[](unsigned _i) const
+    {
+      return (data[_i / wordSize] >> (_i % wordSize)) & 1;
+    }
+
+  /// Set bit _i to _value
+  void set(unsigned _i, bool _value)
+    {
+      Word mask = Word(1) << (_i % wordSize);
+      if (_value)
+        data[_i / wordSize] |= mask;
+      else
+        data[_i / wordSize] &= ~mask;
+    }
+
+  /// Invert bit _i
+  void flip(unsigned _i)
+    {
+      data[_i / wordSize] ^= Word(1) << (_i % wordSize);
+    }
+
+  /// Number of bits set
+  unsigned count() const
+    {
+      unsigned n = 0;
+      for (unsigned w = 0; w < data.size(); ++w)
+        n += eoPopcount(data[w]);
+      return n;
+    }
+
+  /// The words; the caller must keep the unused bits of the last one to zero
+  std::vector<Word>& words() { return data; }
+
+  /// The words
+  const std::vector<Word>& words() const { return data; }
+
+  /// Sets the unused bits of the last word to zero
+  void clear_tail()
+    {
+      if (nbits % wordSize)
+        data.back() &= (Word(1) << (nbits % wordSize)) - 1;
+    }
+
+  /**
+   * To print me on a stream.
+   * @param os The std::ostream.
+   */
+  virtual void printOn(std::ostream& os) const
+    {
+      EO<FitT>::printOn(os);
+      os << ' ';
+      os << size() << ' ';
+      std::string bits(nbits, '0');
+      for (unsigned i = 0; i < nbits; ++i)
+        if ((*this)[i])
+          bits[i] = '1';
+      os << bits;
+    }
+
+  /**
+   * To read me from a stream.
+   * @param is The std::istream.
+   */
+  virtual void readFrom(std::istream& is)
+    {
+      EO<FitT>::readFrom(is);
+      unsigned s;
+      is >> s;
+      std::string bits;
+      is >> bits;
+      if (is)
+        {
+          data.assign((bits.size() + wordSize - 1) / wordSize, 0);
+          nbits = bits.size();
+          for (unsigned i = 0; i < nbits; ++i)
+            if (bits[i] == '1')
+              set(i, true);
+        }
+    }
+
+private:
+  std::vector<Word> data;
+  unsigned nbits;
+};
+
+
+/** Hamming distance between packed bitstrings, one popcount per word
+
+@ingroup bitstring
+*/
+template <class FitT>
+class eoHammingDistance< eoPackedBit<FitT> > : public eoDistance< eoPackedBit<FitT> >
+{
+public:
+  double operator()(const eoPackedBit<FitT> & _v1, const eoPackedBit<FitT> & _v2)
+  {
+    const std::vector<uint64_t>& w1 = _v1.words();
+    const std::vector<uint64_t>& w2 = _v2.words();
+    unsigned sum = 0;
+    for (unsigned w = 0; w < w1.size(); ++w)
+      sum += eoPopcount(w1[w] ^ w2[w]);
+    return sum;
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+#endif //eoPackedBit_h
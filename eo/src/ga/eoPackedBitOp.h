@@ -0,0 +1,315 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+//-----------------------------------------------------------------------------
+// eoPackedBitOp.h
+/*
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+    Contact: http://eodev.sourceforge.net
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef eoPackedBitOp_h
+#define eoPackedBitOp_h
+
+//-----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <utils/eoRNG.h>
+#include <eoInit.h>
+#include <eoOp.h>
+#include <ga/eoPackedBit.h>
+
+/** Operators on eoPackedBit, working a word (64 bits) at a time.
+
+Mutations draw the distance to the next flipped bit in a geometric law,
+rather than one random number per bit.
+*/
+
+/** Random 64 bits word
+@ingroup bitstring
+*/
+inline uint64_t eoRandomWord(eoRng& _gen)
+{
+    return (uint64_t(_gen.rand()) << 32) | uint64_t(_gen.rand());
+}
+
+/** Number of failures before the next success, in Bernoulli trials with
+    probability p of success, where _logq = log(1-p)
+@ingroup bitstring
+*/
+inline double eoGeometricSkip(eoRng& _gen, double _logq)
+{
+    double u = 1.0 - _gen.uniform(); // in (0,1]
+    return std::floor(std::log(u) / _logq);
+}
+
+/** Swaps bits [_from, _to) between two packed bitstrings
+    @return true if at least one bit has changed
+@ingroup bitstring
+*/
+template<class Chrom>
+bool eoSwapBitRange(Chrom& _chrom1, Chrom& _chrom2, unsigned _from, unsigned _to)
+{
+    const unsigned ws = Chrom::wordSize;
+    std::vector<uint64_t>& w1 = _chrom1.words();
+    std::vector<uint64_t>& w2 = _chrom2.words();
+
+    uint64_t changed = 0;
+    for (unsigned w = _from / ws; _from < _to; ++w)
+    {
+        unsigned end = std::min(_to, (w+1) * ws);
+        unsigned lo = _from - w * ws;
+        unsigned hi = end - w * ws;
+        uint64_t mask = (hi == ws ? ~uint64_t(0) : (uint64_t(1) << hi) - 1) & ~((uint64_t(1) << lo) - 1);
+
+        uint64_t diff = (w1[w] ^ w2[w]) & mask;
+        w1[w] ^= diff;
+        w2[w] ^= diff;
+        changed |= diff;
+
+        _from = end;
+    }
+    return changed != 0;
+}
+
+
+/** Random initialization of packed bitstrings, one draw per 32 bits
+
+@ingroup bitstring
+@ingroup Initializators
+*/
+template<class Chrom> class eoPackedBitInit: public eoInit<Chrom>
+{
+ public:
+  eoPackedBitInit(unsigned _size) : size(_size) {}
+
+  virtual std::string className() const { return "eoPackedBitInit"; }
+
+  void operator()(Chrom& chrom)
+    {
+      chrom.resize(size);
+      std::vector<uint64_t>& words = chrom.words();
+      for (unsigned w = 0; w < words.size(); ++w)
+        words[w] = eoRandomWord(eo::threadRng());
+      chrom.clear_tail();
+      chrom.invalidate();
+    }
+
+ private:
+  unsigned size;
+};
+
+
+/** eoPackedOneBitFlip --> changes 1 bit
+
+@ingroup bitstring
+@ingroup Variators
+*/
+template<class Chrom> class eoPackedOneBitFlip: public eoMonOp<Chrom>
+{
+ public:
+  virtual std::string className() const { return "eoPackedOneBitFlip"; }
+
+  bool operator()(Chrom& chrom)
+    {
+      chrom.flip(eo::threadRng().random(chrom.size()));
+      return true;
+    }
+};
+
+
+/** eoPackedBitMutation --> classic mutation: each bit is flipped with
+    probability rate (rate/size if normalized), as eoBitMutation, but the
+    flipped bits are found by geometric skips.
+
+@ingroup bitstring
+@ingroup Variators
+*/
+template<class Chrom> class eoPackedBitMutation: public eoMonOp<Chrom>
+{
+ public:
+  /**
+   * (Default) Constructor.
+   * @param _rate Rate of mutation.
+   * @param _normalize use rate/chrom.size if true
+   */
+  eoPackedBitMutation(const double& _rate = 0.01, bool _normalize=false):
+    rate(_rate), normalize(_normalize) {}
+
+  virtual std::string className() const { return "eoPackedBitMutation"; }
+
+  bool operator()(Chrom& chrom)
+    {
+      double actualRate = (normalize ? rate/chrom.size() : rate);
+      if (actualRate <= 0 || chrom.size() == 0)
+        return false;
+
+      if (actualRate >= 1)
+        {
+          std::vector<uint64_t>& words = chrom.words();
+          for (unsigned w = 0; w < words.size(); ++w)
+            words[w] = ~words[w];
+          chrom.clear_tail();
+          return true;
+        }
+
+      eoRng& gen = eo::threadRng();
+      double logq = std::log(1.0 - actualRate);
+      bool changed_something = false;
+      for (double i = eoGeometricSkip(gen, logq); i < chrom.size(); i += 1 + eoGeometricSkip(gen, logq))
+        {
+          chrom.flip(unsigned(i));
+          changed_something = true;
+        }
+      return changed_something;
+    }
+
+ private:
+  double rate;
+  bool normalize;
+};
+
+
+/** eoPacked1PtBitXover --> classic 1-point crossover, swaps the bits before
+    a random site, as eo1PtBitXover
+
+@ingroup bitstring
+@ingroup Variators
+*/
+template<class Chrom> class eoPacked1PtBitXover: public eoQuadOp<Chrom>
+{
+ public:
+  virtual std::string className() const { return "eoPacked1PtBitXover"; }
+
+  bool operator()(Chrom& chrom1, Chrom& chrom2)
+    {
+      unsigned site = eo::threadRng().random(std::min(chrom1.size(), chrom2.size()));
+      return eoSwapBitRange(chrom1, chrom2, 0, site);
+    }
+};
+
+
+/** eoPackedUBitXover --> classic uniform crossover, as eoUBitXover
+
+With the default preference of 0.5, the swap mask of each word is a single
+random word.
+
+@ingroup bitstring
+@ingroup Variators
+*/
+template<class Chrom> class eoPackedUBitXover: public eoQuadOp<Chrom>
+{
+ public:
+  eoPackedUBitXover(const float& _preference = 0.5): preference(_preference)
+    {
+      if ( (_preference <= 0.0) || (_preference >= 1.0) )
+        throw std::runtime_error("UxOver --> invalid preference");
+    }
+
+  virtual std::string className() const { return "eoPackedUBitXover"; }
+
+  bool operator()(Chrom& chrom1, Chrom& chrom2)
+    {
+      if ( chrom1.size() != chrom2.size())
+        throw std::runtime_error("UxOver --> chromosomes sizes don't match" );
+
+      eoRng& gen = eo::threadRng();
+      std::vector<uint64_t>& w1 = chrom1.words();
+      std::vector<uint64_t>& w2 = chrom2.words();
+      uint64_t changed = 0;
+
+      if (preference == 0.5)
+        {
+          // the unused bits are zero in both, they cannot be swapped
+          for (unsigned w = 0; w < w1.size(); ++w)
+            {
+              uint64_t diff = (w1[w] ^ w2[w]) & eoRandomWord(gen);
+              w1[w] ^= diff;
+              w2[w] ^= diff;
+              changed |= diff;
+            }
+        }
+      else
+        {
+          double logq = std::log(1.0 - preference);
+          for (double i = eoGeometricSkip(gen, logq); i < chrom1.size(); i += 1 + eoGeometricSkip(gen, logq))
+            {
+              changed |= eoSwapBitRange(chrom1, chrom2, unsigned(i), unsigned(i) + 1);
+            }
+        }
+      return changed != 0;
+    }
+
+ private:
+  float preference;
+};
+
+
+/** eoPackedNPtsBitXover --> n-point crossover: bits are swapped every other
+    segment between n random sites, as eoNPtsBitXover
+
+@ingroup bitstring
+@ingroup Variators
+*/
+template<class Chrom> class eoPackedNPtsBitXover : public eoQuadOp<Chrom>
+{
+public:
+
+    eoPackedNPtsBitXover(const unsigned& _num_points = 2) : num_points(_num_points)
+        {
+            if (num_points < 1)
+                throw std::runtime_error("NxOver --> invalid number of points");
+        }
+
+    virtual std::string className() const { return "eoPackedNPtsBitXover"; }
+
+    bool operator()(Chrom& chrom1, Chrom& chrom2) {
+        unsigned max_size(std::min(chrom1.size(), chrom2.size()));
+        if (max_size < 2)
+            return false;
+        unsigned max_points(std::min(max_size - 1, num_points));
+
+        // select distinct sites in [1, max_size)
+        std::vector<unsigned> points;
+        points.reserve(max_points);
+        while (points.size() < max_points) {
+            unsigned bit(1 + eo::threadRng().random(max_size - 1));
+            if (std::find(points.begin(), points.end(), bit) == points.end())
+                points.push_back(bit);
+        }
+        std::sort(points.begin(), points.end());
+        if (points.size() % 2)
+            points.push_back(max_size);
+
+        // swap every other segment
+        bool changed(false);
+        for (unsigned i = 0; i < points.size(); i += 2)
+            changed = eoSwapBitRange(chrom1, chrom2, points[i], points[i+1]) || changed;
+        return changed;
+    }
+
+private:
+
+    unsigned num_points;
+};
+
+//-----------------------------------------------------------------------------
+
+#endif
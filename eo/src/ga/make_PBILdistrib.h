@@ -88,6 +88,7 @@ eoPBILDistrib<EOT> &  do_make_PBILdistrib(eoParser & _parser, eoState& _state, E
   else				// nothing loaded from a file
     {
       rng.reseed(seedParam.value());
+      eo::rngPool.reseed(seedParam.value());
     }
 
   // for future stateSave, register the algorithm into the state
@@ -0,0 +1,165 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+//-----------------------------------------------------------------------------
+// eoFlatParseTree.h : parse trees stored in an array (for Tree-based Genetic Programming)
+/*
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+    Contact: http://eodev.sourceforge.net
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef eoFlatParseTree_h
+#define eoFlatParseTree_h
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include <EO.h>
+#include <gp/flat_tree.h>
+
+using namespace gp_parse_tree;
+
+/** Parse-tree for genetic programming, stored in a single array (see flat_tree.h)
+
+The trees are the ones of eoParseTree, with the same Nodes, and they are
+printed and read in the same format, but their nodes are kept in prefix
+order, along with the size of each subtree: the operators (see
+eoFlatParseTreeOp.h) copy ranges of nodes instead of subtree objects
+taken from the global pools, which is faster, and safe when the
+individuals are initialized or varied by several threads.
+
+The trees are evaluated compiled (see compiled() and postfix_program in
+parse_tree.h), their Node must have the batch operator.
+
+@class eoFlatParseTree eoFlatParseTree.h gp/eoFlatParseTree.h
+
+@ingroup ParseTree
+*/
+template <class FType, class Node>
+class eoFlatParseTree : public EO<FType>, public flat_tree<Node>
+{
+public:
+
+    using flat_tree<Node>::size;
+
+    /**
+     * Default Constructor
+     */
+    eoFlatParseTree(void)  {}
+
+    /**
+     * Copy Constructor
+     * @param tree The tree to copy
+     */
+    eoFlatParseTree(const flat_tree<Node>& tree) : flat_tree<Node>(tree) {}
+
+    /**
+     * Conversion from a parse_tree, or an eoParseTree (without its fitness)
+     * @param tree The tree to copy
+     */
+    eoFlatParseTree(const parse_tree<Node>& tree) : flat_tree<Node>(tree.ebegin(), tree.eend()) {}
+
+    /**
+     * Copy Constructor, the compiled program is not shared
+     * @param tree The tree to copy
+     */
+    eoFlatParseTree(const eoFlatParseTree<FType, Node>& tree) : EO<FType>(tree), flat_tree<Node>(tree) {}
+
+    eoFlatParseTree& operator=(const eoFlatParseTree<FType, Node>& tree)
+    {
+        EO<FType>::operator=(tree);
+        flat_tree<Node>::operator=(tree);
+        program.clear();
+        return *this;
+    }
+
+    /**
+     * The tree compiled for the evaluation on batches of cases, as
+     * eoParseTree::compiled(). It is only compiled again when the fitness
+     * is invalid, as the operators that change the tree must invalidate it.
+     */
+    const postfix_program<Node>& compiled(void) const
+    {
+        if (this->invalid() || program.empty())
+            this->compile(program);
+        return program;
+    }
+
+    /**
+     * To prune me to a certain size, as eoParseTree::pruneTree
+     * @param _size My maximum size
+     */
+    virtual void pruneTree(unsigned _size)
+    {
+        if (_size < 1)
+            return;
+
+        program.clear();
+        this->prune(_size);
+    }
+
+    /**
+     * To read me from a stream
+     * @param is The std::istream
+     */
+    eoFlatParseTree(std::istream& is) : EO<FType>(), flat_tree<Node>()
+    {
+        readFrom(is);
+    }
+
+    /// My class name
+    std::string className(void) const { return "eoFlatParseTree"; }
+
+    /**
+     * To print me on a stream, in the order of eoParseTree
+     * @param os The std::ostream
+     */
+    void printOn(std::ostream& os) const
+    {
+        EO<FType>::printOn(os);
+        os << ' ';
+
+        os << size() << ' ';
+
+        std::copy(this->rbegin(), this->rend(), std::ostream_iterator<Node>(os, " "));
+    }
+
+    /**
+     * To read me from a stream, in the format of printOn
+     * @param is The std::istream
+     */
+    void readFrom(std::istream& is)
+    {
+        EO<FType>::readFrom(is);
+
+        unsigned sz;
+        is >> sz;
+
+        std::vector<Node> v(sz);
+        for (unsigned i = 0; i < sz; ++i)
+            is >> v[i];
+
+        this->assign(v.rbegin(), v.rend());
+        program.clear();
+    }
+
+private:
+
+    mutable postfix_program<Node> program;
+};
+
+#endif
@@ -0,0 +1,148 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+//-----------------------------------------------------------------------------
+// eoFlatParseTreeDepthInit.h : initializor for the eoFlatParseTree class
+/*
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+    Contact: http://eodev.sourceforge.net
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef eoFlatParseTreeDepthInit_h
+#define eoFlatParseTreeDepthInit_h
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <eoInit.h>
+#include <gp/eoFlatParseTree.h>
+#include <utils/eoRNG.h>
+
+/** eoFlatParseTreeDepthInit : the initializer class for eoFlatParseTree,
+the grow, full and ramped half and half methods of eoParseTreeDepthInit.
+
+The nodes are generated in prefix order, straight into the array of the
+tree. The random numbers come from the generator of the calling thread
+(see eo::threadRng) and the given nodes are copied before they are
+randomized, so that the grow and full methods can initialize a
+population in parallel (see apply). The ramped half and half method
+changes the depth and the method after each tree, it is sequential.
+
+\class eoFlatParseTreeDepthInit eoFlatParseTreeDepthInit.h gp/eoFlatParseTreeDepthInit.h
+\ingroup ParseTree
+*/
+template <class FType, class Node>
+class eoFlatParseTreeDepthInit : public eoInit< eoFlatParseTree<FType, Node> >
+{
+    protected:
+        struct lt_arity
+        {
+            bool operator()(const Node& _node1, const Node& _node2) const { return (_node1.arity() < _node2.arity()); }
+        };
+
+    public :
+
+    typedef eoFlatParseTree<FType, Node> EoType;
+
+    /**
+     * Constructor
+     * @param _max_depth The maximum depth of a tree
+     * @param _initializor A std::vector containing the possible nodes
+     * @param _grow False results in a full tree, True result is a randomly grown tree
+     * @param _ramped_half_and_half True results in Ramped Half and Half Initialization
+     */
+    eoFlatParseTreeDepthInit(
+        unsigned _max_depth,
+        const std::vector<Node>& _initializor,
+        bool _grow = true,
+        bool _ramped_half_and_half = false)
+        : eoInit<EoType>(),
+          max_depth(_max_depth),
+          initializor(_initializor),
+          grow(_grow),
+          ramped_half_and_half(_ramped_half_and_half),
+          current_depth(_max_depth)
+    {
+        if (initializor.empty())
+        {
+            throw std::logic_error("eoFlatParseTreeDepthInit: uhm, wouldn't you rather give a non-empty set of Nodes?");
+        }
+        // the terminals in front, in their order
+        std::stable_sort(initializor.begin(), initializor.end(), lt_arity());
+
+        last_terminal = 0;
+        while (last_terminal < initializor.size() && initializor[last_terminal].arity() == 0)
+            ++last_terminal;
+    }
+
+    /// My class name
+    virtual std::string className() const { return "eoFlatParseTreeDepthInit"; };
+
+    /**initialize a tree
+     * @param _tree : the tree to be initialized
+     */
+    void operator()(EoType& _tree)
+    {
+        std::vector<Node> sequence;
+        generate(sequence, current_depth, grow);
+        _tree.assign(sequence.begin(), sequence.end());
+        _tree.invalidate();
+
+        if (ramped_half_and_half)
+        {
+            if (grow)
+            {
+                if (current_depth > 2)
+                    current_depth--;
+                else
+                    current_depth = max_depth;
+            }
+            // change the grow method from 'grow' to 'full' or from 'full' to 'grow'
+            grow = !grow;
+        }
+    }
+
+   private :
+
+    void generate(std::vector<Node>& sequence, unsigned the_max, bool grow_it) const
+    {
+        eoRng& gen = eo::threadRng();
+
+        size_t what;
+        if (the_max <= 1)
+            what = gen.random(last_terminal); // terminals only
+        else if (grow_it)
+            what = gen.random(initializor.size());
+        else
+            what = last_terminal + gen.random(initializor.size() - last_terminal);
+
+        sequence.push_back(initializor[what]);
+        sequence.back().randomize();
+
+        for (int i = 0; i < initializor[what].arity(); ++i)
+            generate(sequence, the_max - 1, grow_it);
+    }
+
+    unsigned max_depth;
+    std::vector<Node> initializor;
+    size_t last_terminal;
+    bool grow;
+    bool ramped_half_and_half;
+    unsigned current_depth;
+};
+
+#endif
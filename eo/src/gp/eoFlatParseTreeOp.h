@@ -0,0 +1,226 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+//-----------------------------------------------------------------------------
+// eoFlatParseTreeOp.h : crossover and mutation operators for the eoFlatParseTree class
+/*
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+    Contact: http://eodev.sourceforge.net
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef eoFlatParseTreeOp_h
+#define eoFlatParseTreeOp_h
+
+#include <vector>
+
+#include <eoInit.h>
+#include <eoOp.h>
+#include <gp/eoFlatParseTree.h>
+#include <utils/eoRNG.h>
+
+/*
+  The operators of eoParseTreeOp.h, for the eoFlatParseTree class. They
+  draw their random numbers from the generator of the calling thread (see
+  eo::threadRng), so that they can vary the individuals of a population in
+  parallel.
+*/
+
+/** eoFlatSubtreeXOver --> subtree xover, as eoSubtreeXOver
+\class eoFlatSubtreeXOver eoFlatParseTreeOp.h gp/eoFlatParseTreeOp.h
+\ingroup ParseTree
+*/
+template<class FType, class Node>
+class eoFlatSubtreeXOver: public eoQuadOp< eoFlatParseTree<FType, Node> > {
+public:
+
+  typedef eoFlatParseTree<FType,Node> EoType;
+  /**
+   * Constructor
+   * @param _max_length the maximum size of an individual
+   */
+  eoFlatSubtreeXOver( unsigned _max_length)
+    : eoQuadOp<EoType>(), max_length(_max_length) {};
+
+  /// the classname
+  virtual std::string className() const { return "eoFlatSubtreeXOver"; };
+
+  /// Dtor
+  virtual ~eoFlatSubtreeXOver () {};
+
+  /**
+   * Perform crossover on two individuals
+   * param _eo1 The first parent individual
+   * param _eo2 The second parent individual
+   */
+  bool operator()(EoType & _eo1, EoType & _eo2 )
+  {
+    eoRng& gen = eo::threadRng();
+    unsigned i = gen.random(_eo1.size());
+    unsigned j = gen.random(_eo2.size());
+
+    _eo1.swap_subtrees(i, _eo2, j);
+
+    _eo1.pruneTree(max_length);
+    _eo2.pruneTree(max_length);
+
+    return true;
+  }
+ private:
+  unsigned max_length;
+};
+
+/** eoFlatBranchMutation --> replace a subtree with a randomly created subtree, as eoBranchMutation
+\class eoFlatBranchMutation eoFlatParseTreeOp.h gp/eoFlatParseTreeOp.h
+\ingroup ParseTree
+ */
+template<class FType, class Node>
+class eoFlatBranchMutation: public eoMonOp< eoFlatParseTree<FType, Node> >
+{
+public:
+
+  typedef eoFlatParseTree<FType,Node> EoType;
+  /**
+   * Constructor
+   * @param _init An instantiation of eoFlatParseTreeDepthInit
+   * @param _max_length the maximum size of an individual
+   */
+  eoFlatBranchMutation(eoInit<EoType>& _init, unsigned _max_length)
+    : eoMonOp<EoType>(), max_length(_max_length), initializer(_init)
+  {};
+
+  /// the class name
+  virtual std::string className() const { return "eoFlatBranchMutation"; };
+
+  /// Dtor
+  virtual ~eoFlatBranchMutation() {};
+
+  /**
+   * Mutate an individual
+   * @param _eo1 The individual that is to be changed
+   */
+  bool operator()(EoType& _eo1 )
+  {
+    eoRng& gen = eo::threadRng();
+    unsigned i = gen.random(_eo1.size());
+
+    EoType eo2;
+    initializer(eo2);
+
+    unsigned j = gen.random(eo2.size());
+
+    _eo1.replace(i, eo2, j); // insert subtree
+
+    _eo1.pruneTree(max_length);
+
+    return true;
+  }
+
+private :
+
+  unsigned max_length;
+  eoInit<EoType>& initializer;
+};
+
+/** eoFlatPointMutation --> replace a Node with a Node of the same arity, as eoPointMutation
+\class eoFlatPointMutation eoFlatParseTreeOp.h gp/eoFlatParseTreeOp.h
+\ingroup ParseTree
+*/
+template<class FType, class Node>
+class eoFlatPointMutation: public eoMonOp< eoFlatParseTree<FType, Node> >
+{
+public:
+
+  typedef eoFlatParseTree<FType,Node> EoType;
+
+  /**
+   * Constructor
+   * @param _initializor The std::vector of Nodes given to the eoFlatParseTreeDepthInit
+   */
+  eoFlatPointMutation( const std::vector<Node>& _initializor)
+    : eoMonOp<EoType>(), initializor(_initializor)
+  {};
+
+  /// the class name
+  virtual std::string className() const { return "eoFlatPointMutation"; };
+
+  /// Dtor
+  virtual ~eoFlatPointMutation() {};
+
+  /**
+   * Mutate an individual
+   * @param _eo1 The individual that is to be changed
+   */
+  bool operator()(EoType& _eo1 )
+  {
+    eoRng& gen = eo::threadRng();
+    // select a random node i that is to be mutated
+    unsigned i = gen.random(_eo1.size());
+    int arity = _eo1[i].arity();
+
+    unsigned j;
+    do
+    {
+        j = gen.random(initializor.size());
+    } while (initializor[j].arity() != arity);
+
+    // the subtree sizes do not change
+    _eo1[i] = initializor[j];
+
+    return true;
+  }
+
+private :
+  std::vector<Node> initializor;
+};
+
+/** eoFlatHoistMutation --> replace the individual with one of its subtrees, as eoHoistMutation
+\class eoFlatHoistMutation eoFlatParseTreeOp.h gp/eoFlatParseTreeOp.h
+\ingroup ParseTree
+ */
+template<class FType, class Node>
+class eoFlatHoistMutation: public eoMonOp< eoFlatParseTree<FType, Node> >
+{
+public:
+
+  typedef eoFlatParseTree<FType,Node> EoType;
+
+  /**
+   * Constructor
+   */
+  eoFlatHoistMutation()
+    : eoMonOp<EoType>()
+  {};
+
+  /// The class name
+  virtual std::string className() const { return "eoFlatHoistMutation"; };
+
+  /// Dtor
+  virtual ~eoFlatHoistMutation() {};
+
+  /**
+   * Mutate an individual
+   * @param _eo1 The individual that is to be changed
+   */
+  bool operator()(EoType& _eo1 )
+  {
+    // select a hoist point, the new tree is always smaller
+    _eo1.hoist(eo::threadRng().random(_eo1.size()));
+
+    return true;
+  }
+};
+
+#endif
@@ -0,0 +1,85 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+//-----------------------------------------------------------------------------
+// eoNodePoolStat.h : monitoring of the memory pools of the parse trees
+/*
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+    Contact: http://eodev.sourceforge.net
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef eoNodePoolStat_h
+#define eoNodePoolStat_h
+
+#include <string>
+
+#include <gp/parse_tree.h>
+#include <utils/eoStat.h>
+
+/**
+  Gives one of the counts of the memory pools that hold the nodes of all the
+  parse trees (see MemPool in node_pool.h): the blocks in use, their highest
+  number (added over the threads) or the number of chunks of 8 kB, to be
+  monitored from a checkpoint. Add one stat per count to monitor.
+
+  The pools of the threads are read without synchronization, the stat must
+  be called outside of any parallel region, as the checkpoints are.
+
+  @ingroup Stats
+  @ingroup ParseTree
+*/
+template <class EOT>
+class eoNodePoolStat : public eoStat<EOT, double>
+{
+    public :
+        using eoStat<EOT, double>::value;
+
+        enum Count { Live, Peak, Chunks };
+
+        eoNodePoolStat(Count _count = Live, std::string _description = "")
+            : eoStat<EOT, double>(0.0, _description.empty() ? defaultDescription(_count) : _description),
+              count(_count)
+        {}
+
+        virtual void operator()(const eoPop<EOT>&)
+        {
+            gp_parse_tree::MemPool::Statistics stats = gp_parse_tree::MemPool::total();
+            switch (count)
+            {
+            case Live :   value() = stats.live; break;
+            case Peak :   value() = stats.peak; break;
+            case Chunks : value() = stats.chunks; break;
+            }
+        }
+
+        virtual std::string className(void) const { return "eoNodePoolStat"; }
+
+    private :
+
+        static std::string defaultDescription(Count _count)
+        {
+            switch (_count)
+            {
+            case Peak :   return "Peak GP pool blocks";
+            case Chunks : return "GP pool chunks";
+            default :     return "Live GP pool blocks";
+            }
+        }
+
+        Count count;
+};
+
+#endif
@@ -82,7 +82,33 @@ public:
      */
     eoParseTree(const parse_tree<Node>& tree)  : parse_tree<Node>(tree) {}
 
-//    eoParseTree(const eoParseTree<FType, Node>& tree) :  parse_tree<Node>(tree) {}
+    /**
+     * Copy Constructor, the compiled program is not shared
+     * @param tree The tree to copy
+     */
+    eoParseTree(const eoParseTree<FType, Node>& tree) : EO<FType>(tree), parse_tree<Node>(tree) {}
+
+    eoParseTree& operator=(const eoParseTree<FType, Node>& tree)
+    {
+        EO<FType>::operator=(tree);
+        parse_tree<Node>::operator=(tree);
+        program.clear();
+        return *this;
+    }
+
+    /**
+     * The tree compiled for the evaluation on batches of cases (see
+     * postfix_program in parse_tree.h). It is only compiled again when the
+     * fitness is invalid, as the operators that change the tree must
+     * invalidate it.
+     */
+    const postfix_program<Node>& compiled(void) const
+    {
+        if (this->invalid() || program.empty())
+            this->compile(program);
+        return program;
+    }
+
     /**
      * To prune me to a certain size
      * @param _size My maximum size
@@ -92,6 +118,7 @@ public:
         if (_size < 1)
             return;
 
+        program.clear();
         while (size() > _size)
         {
             back() = this->operator[](size()-2);
@@ -151,6 +178,7 @@ public:
         }
         parse_tree<Node> tmp(v.begin(), v.end());
         this->swap(tmp);
+        program.clear();
 
         /*
          * old code which caused problems for paradisEO
@@ -168,6 +196,10 @@ public:
         std::copy(std::istream_iterator<Node>(is), std::istream_iterator<Node>(), back_inserter(*this));
         */
     }
+
+private:
+
+    mutable postfix_program<Node> program;
 };
 /** @example t-eoSymreg.cpp
  */
@@ -132,9 +132,9 @@ class eoParseTreeDepthInit : public eoInit< eoParseTree<FType, Node> >
 
             if (the_max == 1)
             { // generate terminals only
-                    typename std::vector<Node>::iterator it = initializor.begin() + rng.random(last_terminal);
-                    it->randomize();
+                    typename std::vector<Node>::iterator it = initializor.begin() + eo::threadRng().random(last_terminal);
                     sequence.push_front(*it);
+                    sequence.front().randomize();
                     return;
             }
 
@@ -142,16 +142,16 @@ class eoParseTreeDepthInit : public eoInit< eoParseTree<FType, Node> >
 
             if (grow)
             {
-                    what_it = initializor.begin() + rng.random(initializor.size());
+                    what_it = initializor.begin() + eo::threadRng().random(initializor.size());
             }
             else // full
             {
-                    what_it = initializor.begin() + last_terminal + rng.random(initializor.size() - last_terminal);
+                    what_it = initializor.begin() + last_terminal + eo::threadRng().random(initializor.size() - last_terminal);
             }
 
-        what_it->randomize();
-
+            // a copy is randomized, so that several threads can initialize trees
             sequence.push_front(*what_it);
+            sequence.front().randomize();
 
             for (int i = 0; i < what_it->arity(); ++i)
                     generate(sequence, the_max - 1, last_terminal);
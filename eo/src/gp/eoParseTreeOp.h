@@ -63,8 +63,8 @@ public:
    */
   bool operator()(EoType & _eo1, EoType & _eo2 )
   {
-          int i = rng.random(_eo1.size());
-          int j = rng.random(_eo2.size());
+          int i = eo::threadRng().random(_eo1.size());
+          int j = eo::threadRng().random(_eo2.size());
 
           typename parse_tree<Node>::subtree tmp = _eo1[i];
           _eo1[i] = _eo2[j]; // insert subtree
@@ -110,12 +110,12 @@ public:
    */
   bool operator()(EoType& _eo1 )
   {
-          int i = rng.random(_eo1.size());
+          int i = eo::threadRng().random(_eo1.size());
 
       EoType eo2;
       initializer(eo2);
 
-          int j = rng.random(eo2.size());
+          int j = eo::threadRng().random(eo2.size());
 
           _eo1[i] = eo2[j]; // insert subtree
 
@@ -171,7 +171,7 @@ public:
   bool operator()(EoType& _eo1 )
   {
         // select a random node i that is to be mutated
-        int i = rng.random(_eo1.size());
+        int i = eo::threadRng().random(_eo1.size());
         // request the arity of the node that is to be replaced
         int arity = _eo1[i].arity();
 
@@ -179,7 +179,7 @@ public:
 
         do
         {
-                j = rng.random(initializor.size());
+                j = eo::threadRng().random(initializor.size());
 
         }while ((initializor[j].arity() != arity));
 
@@ -227,11 +227,11 @@ public:
    */
   bool operator()(EoType& _eo1 )
   {
-          int i = rng.random(_eo1.size());
+          int i = eo::threadRng().random(_eo1.size());
           // look for a terminal
           while (_eo1[i].arity() != 0)
           {
-                i= rng.random(_eo1.size());
+                i= eo::threadRng().random(_eo1.size());
           };
 
           // create a new tree to
@@ -242,11 +242,11 @@ public:
                 initializer(eo2);
           }while(eo2.size() == 1);
 
-          int j = rng.random(eo2.size());
+          int j = eo::threadRng().random(eo2.size());
           // make sure we select a subtree (and not a terminal)
           while((eo2[j].arity() == 0))
           {
-                j = rng.random(eo2.size());
+                j = eo::threadRng().random(eo2.size());
           };
 
 
@@ -294,22 +294,22 @@ public:
    */
   bool operator()(EoType& _eo1 )
   {
-          int i = rng.random(_eo1.size());
+          int i = eo::threadRng().random(_eo1.size());
           // look for a subtree
           while ((_eo1[i].arity() == 0) && (_eo1.size() > 1))
           {
-                i= rng.random(_eo1.size());
+                i= eo::threadRng().random(_eo1.size());
           };
 
           // create a new tree to
           EoType eo2;
           initializer(eo2);
 
-          int j = rng.random(eo2.size());
+          int j = eo::threadRng().random(eo2.size());
           // make sure we select a subtree (and not a terminal)
           while(eo2[j].arity() != 0)
           {
-                j = rng.random(eo2.size());
+                j = eo::threadRng().random(eo2.size());
           };
 
           _eo1[i] = eo2[j]; // insert subtree
@@ -360,7 +360,7 @@ public:
 
 
           // select a hoist point
-          int i = rng.random(_eo1.size());
+          int i = eo::threadRng().random(_eo1.size());
           // and create a new tree
           EoType eo2(_eo1[i]);
 
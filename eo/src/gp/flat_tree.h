@@ -0,0 +1,265 @@
+#ifndef FLAT_TREE_HH
+#define FLAT_TREE_HH
+
+/**
+ *	flat_tree class, a parse tree stored in a single array
+
+  A flat_tree holds the same trees as a parse_tree (the Node requirements
+  are the same, see parse_tree.h), but instead of a subtree object per
+  node, whose node and arguments come from the global pools of
+  node_pool.h, it keeps two arrays: the nodes in prefix order (the root
+  first, then the subtree of each argument in turn) and, for each node,
+  the size of the subtree it starts. The subtree of node i is thus the
+  range [i, i + subtree_size(i)) of the array, so that
+
+    - replacing a subtree by another one (the crossover and most
+      mutations) copies a range of nodes, and fixes the sizes of the
+      ancestors in a single scan of the nodes before it;
+
+    - traversing a tree reads consecutive memory;
+
+    - the trees only allocate through their std::vectors, so they can be
+      built and changed by several threads at the same time (the pools of
+      node_pool.h are shared by all the parse_trees, without a lock).
+
+  Nodes are indexed in prefix order: tree[0] is the root, where the
+  subtree operator of parse_tree counts from the leaves (the root is its
+  back()). The order of parse_tree is the prefix order reversed however,
+  as it visits the arguments from the last one, so that both classes
+  read the sequences of nodes of the other backwards:
+
+  \code
+  parse_tree<Node> tree(flat.rbegin(), flat.rend());
+  flat_tree<Node> again(tree.ebegin(), tree.eend());
+  \endcode
+
+  A flat_tree has no subtree objects, hence no apply() calling the Node
+  on its argument subtrees: it is evaluated compiled into a
+  postfix_program (see parse_tree.h), with the batch operator of the Node.
+*/
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <gp/parse_tree.h>
+
+namespace gp_parse_tree
+{
+
+template <class T> class flat_tree
+{
+  public :
+
+    typedef T value_type;
+    typedef typename std::vector<T>::iterator iterator;
+    typedef typename std::vector<T>::const_iterator const_iterator;
+    typedef typename std::vector<T>::reverse_iterator reverse_iterator;
+    typedef typename std::vector<T>::const_reverse_iterator const_reverse_iterator;
+
+    flat_tree(void) : nodes(), sizes() {}
+
+    /* Builds the tree from its nodes in the order of parse_tree(b, e) */
+    template <class It>
+    flat_tree(It b, It e) : nodes(), sizes()
+    {
+        std::vector<T> reversed(b, e);
+        assign(reversed.rbegin(), reversed.rend());
+    }
+
+    virtual ~flat_tree(void) {}
+
+    /* Replaces the tree by the one whose nodes are [b, e) in prefix order */
+    template <class It>
+    void assign(It b, It e)
+    {
+        nodes.assign(b, e);
+        sizes.resize(nodes.size());
+
+        // from the last node, every subtree is complete when its root is met
+        std::vector<unsigned> pending;
+        for (size_t i = nodes.size(); i-- > 0;)
+        {
+            unsigned size = 1;
+            int arity = nodes[i].arity();
+            if (pending.size() < size_t(arity))
+                throw std::runtime_error("flat_tree: missing arguments in a prefix sequence");
+            for (int a = 0; a < arity; ++a)
+            {
+                size += pending.back();
+                pending.pop_back();
+            }
+            sizes[i] = size;
+            pending.push_back(size);
+        }
+
+        if (pending.size() > 1)
+            throw std::runtime_error("flat_tree: more than one tree in a prefix sequence");
+    }
+
+    /* Equality and inequality */
+
+    bool operator==(const flat_tree& other) const
+    { return sizes == other.sizes && nodes == other.nodes; }
+
+    bool operator!=(const flat_tree& other) const
+    { return !operator==(other); }
+
+    /* Simple tree statistics */
+
+    size_t size(void) const  { return nodes.size(); }
+    bool empty(void) const   { return nodes.empty(); }
+    void clear(void)         { nodes.clear(); sizes.clear(); }
+
+    size_t depth(void) const
+    {
+        // the depth of the subtrees whose root has not been met yet
+        std::vector<size_t> pending;
+        for (size_t i = nodes.size(); i-- > 0;)
+        {
+            size_t d = 0;
+            for (int a = nodes[i].arity(); a > 0; --a)
+            {
+                d = std::max(d, pending.back());
+                pending.pop_back();
+            }
+            pending.push_back(d + 1);
+        }
+        return pending.empty() ? 0 : pending.back();
+    }
+
+    /* The nodes, in prefix order */
+
+    T& operator[](size_t i)              { return nodes[i]; }
+    const T& operator[](size_t i) const  { return nodes[i]; }
+
+    iterator begin(void)              { return nodes.begin(); }
+    const_iterator begin(void) const  { return nodes.begin(); }
+    iterator end(void)                { return nodes.end(); }
+    const_iterator end(void) const    { return nodes.end(); }
+
+    /* The nodes in the order of the embedded iterators of parse_tree */
+    reverse_iterator rbegin(void)              { return nodes.rbegin(); }
+    const_reverse_iterator rbegin(void) const  { return nodes.rbegin(); }
+    reverse_iterator rend(void)                { return nodes.rend(); }
+    const_reverse_iterator rend(void) const    { return nodes.rend(); }
+
+    /* The subtree of node i is [i, subtree_end(i)) */
+    size_t subtree_size(size_t i) const { return sizes[i]; }
+    size_t subtree_end(size_t i) const  { return i + sizes[i]; }
+
+    /* Compilation for the evaluation on batches of cases, see postfix_program */
+    void compile(postfix_program<T>& program) const
+    {
+        program.clear();
+        if (!empty())
+            compile_subtree(0, program);
+    }
+
+    /* Replaces the subtree of node i by the subtree of node j of another tree */
+    void replace(size_t i, const flat_tree& other, size_t j)
+    {
+        if (&other == this)
+        {
+            flat_tree copy(*this);
+            replace(i, copy, j);
+            return;
+        }
+        replace(i, other.nodes.begin() + j, other.sizes.begin() + j, other.sizes[j]);
+    }
+
+    /* Exchanges the subtree of node i with the subtree of node j of another tree */
+    void swap_subtrees(size_t i, flat_tree& other, size_t j)
+    {
+        if (&other == this)
+        {
+            // a single tree is left, which gets the subtree of node j
+            replace(i, other, j);
+            return;
+        }
+
+        std::vector<T> mine(nodes.begin() + i, nodes.begin() + subtree_end(i));
+        std::vector<unsigned> mySizes(sizes.begin() + i, sizes.begin() + subtree_end(i));
+
+        replace(i, other, j);
+        other.replace(j, mine.begin(), mySizes.begin(), mine.size());
+    }
+
+    /* The tree becomes its subtree of node i */
+    void hoist(size_t i)
+    {
+        size_t e = subtree_end(i);
+        nodes.erase(nodes.begin() + e, nodes.end());
+        nodes.erase(nodes.begin(), nodes.begin() + i);
+        sizes.erase(sizes.begin() + e, sizes.end());
+        sizes.erase(sizes.begin(), sizes.begin() + i);
+    }
+
+    /*
+        Replaces the root by its first argument until the tree has no more than
+        max_size nodes, as eoParseTree::pruneTree (its tree[size() - 2] is the
+        first argument of the root), that is the first subtree small enough
+        along the first arguments, which follow each other.
+    */
+    void prune(size_t max_size)
+    {
+        if (empty())
+            return;
+
+        size_t root = 0;
+        while (sizes[root] > max_size && nodes[root].arity() > 0)
+            ++root;
+
+        if (root > 0)
+            hoist(root);
+    }
+
+    /* Customized Swap */
+    void swap(flat_tree& other)
+    {
+        nodes.swap(other.nodes);
+        sizes.swap(other.sizes);
+    }
+
+  private :
+
+    void compile_subtree(size_t i, postfix_program<T>& program) const
+    {
+        for (size_t arg = i + 1; arg < subtree_end(i); arg = subtree_end(arg))
+            compile_subtree(arg, program);
+        program.push_back(nodes[i], nodes[i].arity());
+    }
+
+    template <class NodeIt, class SizeIt>
+    void replace(size_t i, NodeIt b, SizeIt s, size_t n)
+    {
+        size_t old = sizes[i];
+
+        // the ancestors of i are the nodes before it whose subtree goes past it
+        for (size_t p = 0; p < i; ++p)
+            if (p + sizes[p] > i)
+                sizes[p] = sizes[p] - old + n;
+
+        if (n >= old)
+        {
+            std::copy(b, b + old, nodes.begin() + i);
+            std::copy(s, s + old, sizes.begin() + i);
+            nodes.insert(nodes.begin() + i + old, b + old, b + n);
+            sizes.insert(sizes.begin() + i + old, s + old, s + n);
+        }
+        else
+        {
+            std::copy(b, b + n, nodes.begin() + i);
+            std::copy(s, s + n, sizes.begin() + i);
+            nodes.erase(nodes.begin() + i + n, nodes.begin() + i + old);
+            sizes.erase(sizes.begin() + i + n, sizes.begin() + i + old);
+        }
+    }
+
+    std::vector<T> nodes;
+    std::vector<unsigned> sizes;
+};
+
+} // namespace gp_parse_tree
+
+#endif
@@ -18,47 +18,366 @@
 #ifndef node_pool_h
 #define node_pool_h
 
+// keeps the slow paths of the pools out of the inlined allocations
+#if defined(__GNUC__)
+#define NODE_POOL_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define NODE_POOL_NOINLINE __declspec(noinline)
+#else
+#define NODE_POOL_NOINLINE
+#endif
+
+/**
+    Pool of blocks of a given size, for the nodes and arguments of the subtrees.
+
+    Each thread has its own free list and its own chunks, so that trees can
+    be built, varied and destroyed by several threads at the same time
+    without a lock. The chunks are aligned on their size and start with the
+    pool of the thread that carved them: a block freed by another thread
+    (as when the offspring bred in parallel replace the parents) goes to
+    the list of returned blocks of that pool, under a lock, and the owner
+    takes them back when its own free list is empty. The threads are
+    numbered in a thread local variable the first time they use a pool,
+    and give their number back when they end (in C++11), so that the next
+    thread takes over their pools and their memory. The threads beyond
+    max_threads share a common pool under its lock.
+
+    Without OpenMP, every thread uses the common pool, without a lock and
+    without looking for the owner of a block, as the pools can not be used
+    by several threads at once anyway.
+
+    The pools count their blocks, see statistics() and eoNodePoolStat.
+    They are static members of the allocators below, included inside the
+    namespace gp_parse_tree by parse_tree.h, which includes omp.h.
+*/
 class MemPool
 {
 public :
 
-    MemPool(unsigned int sz) : esize(sz<sizeof(Link)? sizeof(Link) : sz) {}
+    enum { max_threads = 256 };
+
+    /// the counts of a pool, or of all of them
+    struct Statistics
+    {
+        Statistics() : live(0), peak(0), chunks(0) {}
+
+        size_t live;   // blocks in use
+        size_t peak;   // highest number of blocks in use, added over the threads
+        size_t chunks; // chunks of 8 kB carved
+    };
+
+#ifdef _OPENMP
+    MemPool(unsigned int sz) : esize(sz<sizeof(Link)? sizeof(Link) : sz), common(true)
+#else
+    MemPool(unsigned int sz) : esize(sz<sizeof(Link)? sizeof(Link) : sz), common(false)
+#endif
+    {
+        for (unsigned t = 0; t < max_threads; ++t)
+            threads[t] = 0;
+        registry().push_back(this);
+    }
+
     ~MemPool()
     {
-        Chunk* n = chunks;
-        while(n)
-        {
-            Chunk* p = n;
-            n = n->next;
-            delete p;
-        }
+        for (unsigned t = 0; t < max_threads; ++t)
+            delete threads[t];
     }
 
     void* allocate()
     {
-        if (head == 0) grow();
-        Link* p = head;
-        head = p->next;
+        // the pool of the thread with blocks left, without a lock
+        Pool* pool = fast_local();
+        Link* p = pool ? pool->head : 0;
+        if (p == 0)
+            return refill();
+
+        pool->head = p->next;
+        if (++pool->live > pool->peak)
+            pool->peak = pool->live;
         return static_cast<void*>(p);
     }
 
     void deallocate(void* b)
     {
         Link* p = static_cast<Link*>(b);
-        p->next = head;
-        head = p;
+#ifdef _OPENMP
+        Pool* owner = reinterpret_cast<Chunk*>(reinterpret_cast<size_t>(b) & ~size_t(Chunk::size - 1))->owner;
+        if (owner != fast_local())
+        {
+            give_back(owner, p);
+            return;
+        }
+#else
+        Pool* owner = &common;
+#endif
+        p->next = owner->head;
+        owner->head = p;
+        --owner->live;
+    }
+
+    /** The counts of this pool. As the counts of the threads are not
+        synchronized, it must be called outside of any parallel region. */
+    Statistics statistics() const
+    {
+        Statistics s;
+        for (unsigned t = 0; t <= max_threads; ++t)
+        {
+            const Pool* pool = t < max_threads ? threads[t] : &common;
+            if (pool == 0)
+                continue;
+            s.live += pool->live - pool->nreturned;
+            s.peak += pool->peak;
+            s.chunks += pool->nchunks;
+        }
+        return s;
+    }
+
+    /// The counts of all the pools, outside of any parallel region
+    static Statistics total()
+    {
+        Statistics s;
+        const std::vector<MemPool*>& pools = registry();
+        for (size_t i = 0; i < pools.size(); ++i)
+        {
+            Statistics one = pools[i]->statistics();
+            s.live += one.live;
+            s.peak += one.peak;
+            s.chunks += one.chunks;
+        }
+        return s;
     }
 
 private :
 
-    void grow()
+    struct Link
+    {
+        Link* next;
+    };
+
+    struct Pool;
+
+    /// the start of a chunk, which is aligned on its size
+    struct Chunk
+    {
+        enum {size = 8 * 1024, header = 16, per_block = 16};
+        Pool* owner;
+    };
+
+    /// the free list and the chunks of a thread
+    struct Pool
+    {
+        Pool(bool s = false) : head(0), returned(0), live(0), nreturned(0), peak(0), nchunks(0),
+                               next_chunk(0), end_chunk(0), shared(s)
+        {
+#ifdef _OPENMP
+            omp_init_lock(&returnLock);
+#endif
+        }
+
+        ~Pool()
+        {
+            for (size_t i = 0; i < blocks.size(); ++i)
+                delete [] blocks[i];
+#ifdef _OPENMP
+            omp_destroy_lock(&returnLock);
+#endif
+        }
+
+        void lock()
+        {
+#ifdef _OPENMP
+            omp_set_lock(&returnLock);
+#endif
+        }
+
+        void unlock()
+        {
+#ifdef _OPENMP
+            omp_unset_lock(&returnLock);
+#endif
+        }
+
+        Link* head;
+        Link* returned;   // freed by the other threads, under the lock
+        size_t live;      // counting the returned blocks
+        size_t nreturned; // under the lock
+        size_t peak;
+        size_t nchunks;
+
+        std::vector<char*> blocks; // the memory of the chunks, Chunk::per_block at a time
+        char* next_chunk;
+        char* end_chunk;
+
+        bool shared;      // by several threads, always under the lock
+#ifdef _OPENMP
+        omp_lock_t returnLock;
+#endif
+    };
+
+    /// the pool of the calling thread if it has its own one, 0 otherwise
+    Pool* fast_local()
+    {
+#ifdef _OPENMP
+        unsigned t = thread_slot() - 1; // the largest number when the thread has none yet
+        return t < max_threads ? threads[t] : 0;
+#else
+        return &common;
+#endif
+    }
+
+    /// the pool of the calling thread, created if needed
+    Pool* local()
+    {
+#ifdef _OPENMP
+        unsigned t = thread_number();
+        if (t >= max_threads)
+            return &common;
+        if (threads[t] == 0)
+            threads[t] = new Pool; // only thread t writes its slot
+        return threads[t];
+#else
+        return &common;
+#endif
+    }
+
+    /// allocates when the free list of the thread is empty, or when it has no pool of its own
+    NODE_POOL_NOINLINE void* refill()
     {
-        Chunk* n = new Chunk;
-        n->next = chunks;
-        chunks = n;
+        Pool* pool = local();
+        if (pool->shared) pool->lock();
+
+        if (pool->head == 0) collect(pool);
+        if (pool->head == 0) grow(pool);
+        Link* p = pool->head;
+        pool->head = p->next;
 
-        const int nelem = Chunk::size/esize;
-        char* start = n->mem;
+        if (++pool->live > pool->peak)
+            pool->peak = pool->live;
+
+        if (pool->shared) pool->unlock();
+        return static_cast<void*>(p);
+    }
+
+#ifdef _OPENMP
+    /// frees a block of another pool than the one of the calling thread
+    NODE_POOL_NOINLINE static void give_back(Pool* owner, Link* p)
+    {
+        owner->lock();
+        if (owner->shared)
+        {
+            p->next = owner->head;
+            owner->head = p;
+            --owner->live;
+        }
+        else
+        {
+            p->next = owner->returned;
+            owner->returned = p;
+            ++owner->nreturned;
+        }
+        owner->unlock();
+    }
+#endif
+
+#ifdef _OPENMP
+    /// the number of the calling thread plus one, 0 until its first call
+    static unsigned& thread_slot()
+    {
+#if __cplusplus >= 201103L
+        static thread_local unsigned number = 0;
+#elif defined(_MSC_VER)
+        static __declspec(thread) unsigned number = 0;
+#else
+        static __thread unsigned number = 0;
+#endif
+        return number;
+    }
+
+    /// the numbers given back by the threads that ended
+    static std::vector<unsigned>& free_numbers()
+    {
+        static std::vector<unsigned> numbers;
+        return numbers;
+    }
+
+#if __cplusplus >= 201103L
+    /// gives the number of a thread back when it ends, its pools go to the next thread
+    struct ThreadNumberRelease
+    {
+        ~ThreadNumberRelease()
+        {
+            unsigned& number = thread_slot();
+            unsigned given = number;
+            number = max_threads + 1; // the blocks freed from now on go back to their owner
+#pragma omp critical(MemPoolThreadNumbers)
+            free_numbers().push_back(given);
+        }
+    };
+#endif
+
+    /// the number of the calling thread, given at its first call and shared by all the pools
+    static unsigned thread_number()
+    {
+        unsigned& number = thread_slot();
+        if (number == 0)
+        {
+            static unsigned threads_seen = 0;
+#pragma omp critical(MemPoolThreadNumbers)
+            {
+                std::vector<unsigned>& numbers = free_numbers();
+                if (numbers.empty())
+                    number = ++threads_seen;
+                else
+                {
+                    number = numbers.back();
+                    numbers.pop_back();
+                }
+            }
+#if __cplusplus >= 201103L
+            if (number <= max_threads)
+            {
+                static thread_local ThreadNumberRelease release;
+                (void) release;
+            }
+#endif
+        }
+        return number - 1;
+    }
+#endif // _OPENMP
+
+    /// takes back the blocks freed by the other threads
+    static void collect(Pool* pool)
+    {
+        if (pool->shared)
+            return;
+
+        pool->lock();
+        pool->head = pool->returned;
+        pool->returned = 0;
+        pool->live -= pool->nreturned;
+        pool->nreturned = 0;
+        pool->unlock();
+    }
+
+    void grow(Pool* pool)
+    {
+        if (pool->next_chunk == pool->end_chunk)
+        {
+            // one more chunk to align them
+            char* block = new char[(Chunk::per_block + 1) * Chunk::size];
+            pool->blocks.push_back(block);
+            size_t misalignment = reinterpret_cast<size_t>(block) & (Chunk::size - 1);
+            pool->next_chunk = block + (misalignment ? Chunk::size - misalignment : 0);
+            pool->end_chunk = pool->next_chunk + Chunk::per_block * Chunk::size;
+        }
+
+        char* chunk = pool->next_chunk;
+        pool->next_chunk += Chunk::size;
+        ++pool->nchunks;
+        reinterpret_cast<Chunk*>(chunk)->owner = pool;
+
+        const int nelem = (Chunk::size - Chunk::header)/esize;
+        char* start = chunk + Chunk::header;
         char* last  = &start[(nelem-1)*esize];
         for (char* p = start; p < last; p += esize)
         {
@@ -67,24 +386,18 @@ private :
         }
 
         reinterpret_cast<Link*>(last)->next = 0;
-        head = reinterpret_cast<Link*>(start);
+        pool->head = reinterpret_cast<Link*>(start);
     }
 
-    struct Link
+    static std::vector<MemPool*>& registry()
     {
-        Link* next;
-    };
-
-    struct Chunk
-    {
-        enum {size = 8 * 1024 - 16};
-        Chunk* next;
-        char mem[size];
-    };
+        static std::vector<MemPool*> pools;
+        return pools;
+    }
 
-    Chunk* chunks;
     const unsigned int esize;
-    Link* head;
+    Pool* threads[max_threads];
+    Pool common; // of the threads beyond max_threads, or of all of them without OpenMP
 };
 
 template<class T>
@@ -247,7 +560,7 @@ public :
                 t = static_cast<T*>(mem3.allocate());
                 new (t) T(*org);
                 new (&t[1]) T(org[1]);
-                new (&t[1]) T(org[2]);
+                new (&t[2]) T(org[2]);
                 break;
             }
         default :
@@ -303,7 +616,7 @@ private :
     static MemPool mem3;
 };
 
-// static (non thread_safe) memory pools
+// static memory pools, with a free list per thread
 template <class T> MemPool Node_alloc<T>::mem  = sizeof(T);
 
 template <class T> MemPool Tree_alloc<T>::mem1 = sizeof(T);
@@ -91,6 +91,32 @@
                 RetVal operator()(RetVal dummy, It begin) const
     \endcode
 
+  ******    Compiled evaluation   ******
+
+  When a tree is evaluated on many cases (the fitness cases of a
+  symbolic regression for instance), it can first be compiled into
+  a postfix_program: a flat array of the nodes in postfix order, which
+  is then evaluated on a whole batch of cases at once:
+
+    \code
+        postfix_program<Node> program;
+        tree.compile(program);
+        std::vector<double> results(cases.size());
+        program.apply(&results[0], cases.size(), cases);
+    \endcode
+
+  This calls, once per node and for all the cases:
+
+    \code
+        template <class It>
+        void Node::operator()(RetVal* results, const RetVal* const* args, size_t n, const It& values) const
+    \endcode
+
+  where args[i][k] is the value of the i-th argument on the k-th case,
+  and results[k] must receive the value of the node on the k-th case.
+  results never points to the arguments. The program points into the
+  tree: compile it again after the tree has been changed.
+
   ******	Internal Structure    ******
 
   A parse_tree has two template arguments: the Node and the ReturnValue
@@ -165,9 +191,14 @@
 
 */
 
+#include <algorithm>
 #include <vector>
 #include <utility> // for swap
 
+#ifdef _OPENMP
+#include <omp.h> // for the pools of node_pool.h
+#endif
+
 #ifdef _MSC_VER
 #pragma warning(disable : 4786) // disable this nagging warning about the limitations of the mirkosoft debugger
 #endif
@@ -186,6 +217,89 @@ inline void do_the_swap(T& a, T& b)
   b = tmp;
 }
 
+/**
+    A parse_tree compiled into a flat array of its nodes in postfix order,
+    evaluated on a batch of cases at a time (see the usage information above).
+    The values of the pending subtrees are kept in blocks of one value per case,
+    which are reused during the evaluation.
+*/
+template <class T> class postfix_program
+{
+  public :
+
+    postfix_program(void) : code(), depth(0), max_depth(0), max_arity(0) {}
+
+    void clear(void) { code.clear(); depth = max_depth = max_arity = 0; }
+
+    /* Appends a node, whose arguments are the last arity values computed */
+    void push_back(const T& node, int arity)
+    {
+        code.push_back(instruction(&node, arity));
+        depth = depth + 1 - arity;
+        max_depth = std::max(max_depth, depth);
+        max_arity = std::max(max_arity, arity);
+    }
+
+    size_t size(void) const  { return code.size(); }
+    bool empty(void) const   { return code.empty(); }
+    const T& operator[](size_t i) const { return *code[i].node; }
+
+    /* Evaluates the program on n cases, results[k] receives the value on the k-th case */
+    template <class RetVal, class It>
+    void apply(RetVal* results, size_t n, const It& values) const
+    {
+        if (empty() || n == 0)
+            return;
+
+        std::vector<RetVal> memory(n * (max_depth + 1));
+        std::vector<RetVal*> free_blocks;
+        for (int b = max_depth; b >= 0; --b)
+            free_blocks.push_back(&memory[b * n]);
+
+        std::vector<RetVal*> stack;
+        std::vector<const RetVal*> args(max_arity + 1);
+
+        for (size_t i = 0; i < code.size(); ++i)
+        {
+            const instruction& ins = code[i];
+            size_t first = stack.size() - ins.arity;
+
+            for (int a = 0; a < ins.arity; ++a)
+                args[a] = stack[first + a];
+
+            // the root writes directly into the results
+            RetVal* out = results;
+            if (i + 1 < code.size())
+            {
+                out = free_blocks.back();
+                free_blocks.pop_back();
+            }
+
+            (*ins.node)(out, &args[0], n, values);
+
+            for (int a = 0; a < ins.arity; ++a)
+                free_blocks.push_back(stack[first + a]);
+            stack.resize(first);
+            stack.push_back(out);
+        }
+    }
+
+  private :
+
+    struct instruction
+    {
+        instruction(const T* n, int a) : node(n), arity(a) {}
+
+        const T* node;
+        int arity;
+    };
+
+    std::vector<instruction> code;
+    int depth;
+    int max_depth;
+    int max_arity;
+};
+
 template <class T> class parse_tree
 {
   public :
@@ -338,6 +452,17 @@ public :
         }
     }
 
+    /* Appends the nodes in postfix order */
+    void compile(postfix_program<T>& program) const
+    {
+        for (int i = 0; i < arity(); ++i)
+        {
+            args[i].compile(program);
+        }
+
+        program.push_back(*content, arity());
+    }
+
         /* Iterators */
 
     iterator begin(void)              { return args; }
@@ -656,6 +781,14 @@ private :
         _root.find_nodes(p);
     }
 
+        /* Compilation for the evaluation on batches of cases, see postfix_program */
+        void compile(postfix_program<T>& program) const
+        {
+                program.clear();
+                if (!empty())
+                        _root.compile(program);
+        }
+
         /* Customized Swap */
         void swap(parse_tree<T>& other)
         {
@@ -782,6 +915,7 @@ private :
 
         base_const_iterator() {}
         base_const_iterator(const subtree* n)  { node = n; }
+        base_const_iterator(const base_const_iterator& org) : node(org.node) {}
 
         base_const_iterator& operator=(const base_const_iterator& org)
         { node = org.node; return *this; }
@@ -865,6 +999,7 @@ private :
 
         embedded_const_iterator() : base_const_iterator() {}
         embedded_const_iterator(const subtree* n): base_const_iterator(n)  {}
+        embedded_const_iterator(const embedded_const_iterator& org) : base_const_iterator(org) {}
         embedded_const_iterator& operator=(const embedded_const_iterator& org)
         { base_const_iterator::operator=(org); return *this; }
 
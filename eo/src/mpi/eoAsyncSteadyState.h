@@ -0,0 +1,424 @@
+/*
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation;
+    version 2 of the License.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+Contact: http://eodev.sourceforge.net
+*/
+# ifndef __EO_ASYNC_STEADY_STATE_H__
+# define __EO_ASYNC_STEADY_STATE_H__
+
+# include <eo>
+# include "eoMpi.h"
+
+# include <map>
+
+/**
+ * @ingroup MPI
+ * @{
+ */
+
+/**
+ * @file eoAsyncSteadyState.h
+ *
+ * @brief Asynchronous steady-state evolutionary algorithm, where the evaluations are done by the workers.
+ *
+ * With eoParallelPopLoopEval, the evaluation of the offspring is a generational barrier: the master waits for all the
+ * evaluations of a generation before replacing, so that a single slow evaluation stalls all the workers. This job
+ * has no barrier:
+ * - each time a worker is free, the master breeds one child from the current population (select + eoGenOp) and
+ *   sends it to this worker;
+ * - as soon as an evaluated child comes back, it is inserted in the population by a steady-state replacement (see
+ *   eoReduceMerge.h, eoSSGAWorseReplacement for instance) and the continuator is called, once per insertion;
+ * - the freed worker immediately receives a new child, bred from the updated population.
+ *
+ * Hence all the workers are kept busy even if the evaluation times vary a lot. As the number of evaluations is not
+ * known in advance, the job has to be used with the DynamicAssignmentAlgorithm. The population given to the algorithm must already be evaluated (with an
+ * eoParallelPopLoopEval, for instance). When the continuator stops, no child is sent anymore, and the children still
+ * being evaluated are waited for and inserted too: with an eoEvalContinue, the budget is exceeded by at most the number
+ * of workers minus one.
+ *
+ * Children are sent by tables of 1 element, so that eoVector based individuals use the binary format of
+ * eo::mpi::communicator.
+ *
+ * @ingroup MPI
+ */
+
+namespace eo
+{
+    namespace mpi
+    {
+        /**
+         * @brief Data used by the asynchronous steady-state job.
+         *
+         * Master side: the population, the variation and the replacement, the children being evaluated by each
+         * worker. Worker side: the evaluation function.
+         */
+        template< class EOT >
+        struct AsyncSteadyStateData
+        {
+            AsyncSteadyStateData(
+                    eoSelectOne<EOT> & _select,
+                    eoGenOp<EOT> & _op,
+                    eoEvalFunc<EOT> & _eval,
+                    eoReplacement<EOT> & _replace,
+                    eoContinue<EOT> & _continuator,
+                    int _masterRank ) :
+                pop( 0 ), running( false ), inserted( 0 ),
+                select( _select ), op( _op ), eval( _eval ), replace( _replace ), continuator( _continuator ),
+                masterRank( _masterRank ), comm( Node::comm() )
+            {
+                // empty
+            }
+
+            /**
+             * @brief Reinitializes the data for a new run on the given (evaluated) population.
+             */
+            void init( eoPop<EOT>& _pop )
+            {
+                pop = &_pop;
+                running = true;
+                inserted = 0;
+                children.clear();
+                assignedTasks.clear();
+            }
+
+            // dynamic parameters
+            /**
+             * @brief Population evolved by the master.
+             */
+            eoPop<EOT> * pop;
+
+            /**
+             * @brief False as soon as the continuator has returned false.
+             */
+            bool running;
+
+            /**
+             * @brief Number of evaluated children inserted in the population since init().
+             */
+            unsigned inserted;
+
+            /**
+             * @brief Children already bred but not yet sent (an eoGenOp can produce several of them at once).
+             */
+            eoPop<EOT> children;
+
+            /**
+             * @brief Child being evaluated by each worker.
+             */
+            std::map< int /* worker rank */, EOT > assignedTasks;
+
+            // static parameters
+            eoSelectOne<EOT> & select;
+            eoGenOp<EOT> & op;
+            eoEvalFunc<EOT> & eval;
+            eoReplacement<EOT> & replace;
+            eoContinue<EOT> & continuator;
+
+            int masterRank;
+            bmpi::communicator& comm;
+        };
+
+        /**
+         * @brief Send task (master side) in the asynchronous steady-state job.
+         *
+         * Breeds children from the current population if none is left, and sends one of them to the worker.
+         */
+        template< class EOT >
+        class SendTaskAsyncSteadyState : public SendTaskFunction< AsyncSteadyStateData< EOT > >
+        {
+            public:
+                using SendTaskFunction< AsyncSteadyStateData< EOT > >::_data;
+
+                SendTaskAsyncSteadyState( SendTaskAsyncSteadyState<EOT> * w = 0 ) : SendTaskFunction< AsyncSteadyStateData< EOT > >( w )
+                {
+                    // empty
+                }
+
+                void operator()( int wrkRank )
+                {
+                    AsyncSteadyStateData< EOT >& d = *_data;
+                    if( d.children.empty() )
+                    {
+                        eoSelectivePopulator<EOT> it( *d.pop, d.children, d.select );
+                        d.op( it );
+                    }
+
+                    EOT & child = d.assignedTasks[ wrkRank ];
+                    child = d.children.back();
+                    d.children.pop_back();
+
+                    d.comm.send( wrkRank, eo::mpi::Channel::Messages, &child, 1 );
+                }
+        };
+
+        /**
+         * @brief Handle response (master side) in the asynchronous steady-state job.
+         *
+         * Retrieves the evaluated child, inserts it in the population and checks the continuator.
+         */
+        template< class EOT >
+        class HandleResponseAsyncSteadyState : public HandleResponseFunction< AsyncSteadyStateData< EOT > >
+        {
+            public:
+                using HandleResponseFunction< AsyncSteadyStateData< EOT > >::_data;
+
+                HandleResponseAsyncSteadyState( HandleResponseAsyncSteadyState<EOT> * w = 0 ) : HandleResponseFunction< AsyncSteadyStateData< EOT > >( w )
+                {
+                    // empty
+                }
+
+                void operator()( int wrkRank )
+                {
+                    AsyncSteadyStateData< EOT >& d = *_data;
+
+                    eoPop<EOT> offspring;
+                    offspring.resize( 1 );
+                    d.comm.recv( wrkRank, eo::mpi::Channel::Messages, &offspring[0], 1 );
+                    d.assignedTasks.erase( wrkRank );
+
+                    d.replace( *d.pop, offspring );
+                    ++d.inserted;
+
+                    if( d.running )
+                    {
+                        d.running = d.continuator( *d.pop );
+                    }
+                }
+        };
+
+        /**
+         * @brief Process task (worker side) in the asynchronous steady-state job.
+         *
+         * Evaluates the received child and sends it back.
+         */
+        template< class EOT >
+        class ProcessTaskAsyncSteadyState : public ProcessTaskFunction< AsyncSteadyStateData< EOT > >
+        {
+            public:
+                using ProcessTaskFunction< AsyncSteadyStateData< EOT > >::_data;
+
+                ProcessTaskAsyncSteadyState( ProcessTaskAsyncSteadyState<EOT> * w = 0 ) : ProcessTaskFunction< AsyncSteadyStateData< EOT > >( w )
+                {
+                    // empty
+                }
+
+                void operator()()
+                {
+                    EOT child;
+                    _data->comm.recv( _data->masterRank, eo::mpi::Channel::Messages, &child, 1 );
+                    timerStat.start("worker_processes");
+                    _data->eval( child );
+                    timerStat.stop("worker_processes");
+                    _data->comm.send( _data->masterRank, eo::mpi::Channel::Messages, &child, 1 );
+                }
+        };
+
+        /**
+         * @brief Is finished (master side) in the asynchronous steady-state job.
+         *
+         * No more child is sent as soon as the continuator has returned false.
+         */
+        template< class EOT >
+        class IsFinishedAsyncSteadyState : public IsFinishedFunction< AsyncSteadyStateData< EOT > >
+        {
+            public:
+                using IsFinishedFunction< AsyncSteadyStateData< EOT > >::_data;
+
+                IsFinishedAsyncSteadyState( IsFinishedAsyncSteadyState<EOT> * w = 0 ) : IsFinishedFunction< AsyncSteadyStateData< EOT > >( w )
+                {
+                    // empty
+                }
+
+                bool operator()()
+                {
+                    return ! _data->running;
+                }
+        };
+
+        /**
+         * @brief Store for the asynchronous steady-state job.
+         *
+         * User can tune functors when constructing the object. For each functor which is not given, a default one is
+         * generated.
+         *
+         * @ingroup MPI
+         */
+        template< class EOT >
+        struct AsyncSteadyStateStore : public JobStore< AsyncSteadyStateData< EOT > >
+        {
+            using JobStore< AsyncSteadyStateData<EOT> >::_stf;
+            using JobStore< AsyncSteadyStateData<EOT> >::_hrf;
+            using JobStore< AsyncSteadyStateData<EOT> >::_ptf;
+            using JobStore< AsyncSteadyStateData<EOT> >::_iff;
+
+            /**
+             * @brief Main constructor for the asynchronous steady-state job.
+             *
+             * @param _select Selection of the parents of each child (master side).
+             * @param _op Variation operator (master side).
+             * @param _eval Evaluation function (worker side).
+             * @param _replace Steady-state replacement, called with one child at a time (master side).
+             * @param _continuator Stopping criterion, called once per inserted child (master side).
+             * @param _masterRank The rank of the master process.
+             */
+            AsyncSteadyStateStore(
+                    eoSelectOne<EOT> & _select,
+                    eoGenOp<EOT> & _op,
+                    eoEvalFunc<EOT> & _eval,
+                    eoReplacement<EOT> & _replace,
+                    eoContinue<EOT> & _continuator,
+                    int _masterRank,
+                    // JobStore functors
+                    SendTaskAsyncSteadyState<EOT> * stf = 0,
+                    HandleResponseAsyncSteadyState<EOT> * hrf = 0,
+                    ProcessTaskAsyncSteadyState<EOT> * ptf = 0,
+                    IsFinishedAsyncSteadyState<EOT> * iff = 0
+                    ) :
+                _data( _select, _op, _eval, _replace, _continuator, _masterRank )
+            {
+                if( stf == 0 ) {
+                    stf = new SendTaskAsyncSteadyState<EOT>;
+                    stf->needDelete( true );
+                }
+
+                if( hrf == 0 ) {
+                    hrf = new HandleResponseAsyncSteadyState<EOT>;
+                    hrf->needDelete( true );
+                }
+
+                if( ptf == 0 ) {
+                    ptf = new ProcessTaskAsyncSteadyState<EOT>;
+                    ptf->needDelete( true );
+                }
+
+                if( iff == 0 ) {
+                    iff = new IsFinishedAsyncSteadyState<EOT>;
+                    iff->needDelete( true );
+                }
+
+                _stf = stf;
+                _hrf = hrf;
+                _ptf = ptf;
+                _iff = iff;
+            }
+
+            AsyncSteadyStateData<EOT>* data() { return &_data; }
+
+            /**
+             * @brief Reinits the store with a new population to evolve.
+             */
+            void data( eoPop<EOT>& _pop )
+            {
+                _data.init( _pop );
+            }
+
+            virtual ~AsyncSteadyStateStore() // for inheritance purposes only
+            {
+            }
+
+            protected:
+            AsyncSteadyStateData<EOT> _data;
+        };
+
+        /**
+         * @brief Asynchronous steady-state job, created for convenience.
+         *
+         * This is an OneShotJob, which means workers leave it along with the master.
+         */
+        template< class EOT >
+        class AsyncSteadyState : public OneShotJob< AsyncSteadyStateData< EOT > >
+        {
+            public:
+
+                AsyncSteadyState( AssignmentAlgorithm & algo,
+                        int masterRank,
+                        AsyncSteadyStateStore< EOT > & store ) :
+                    OneShotJob< AsyncSteadyStateData< EOT > >( algo, masterRank, store )
+            {
+                // empty
+            }
+        };
+    } // namespace mpi
+} // namespace eo
+
+/**
+ * @brief Asynchronous steady-state algorithm, evaluating the children on MPI workers.
+ *
+ * To be called by the master and by all the workers; the population is only used (and must already be evaluated) on
+ * the master side. See eoAsyncSteadyState.h for the algorithm.
+ *
+ * @ingroup MPI
+ */
+template< class EOT >
+class eoAsyncSteadyStateEA : public eoAlgo<EOT>
+{
+    public:
+
+        /**
+         * @param _assignAlgo The scheduling algorithm, which has to be a DynamicAssignmentAlgorithm: the number of
+         * children to evaluate is not known in advance.
+         * @param _masterRank The MPI rank of the master.
+         * @param _select Selection of the parents of each child.
+         * @param _op Variation operator.
+         * @param _eval Evaluation function, used by the workers.
+         * @param _replace Steady-state replacement, called with one child at a time.
+         * @param _continuator Stopping criterion, called once per inserted child.
+         */
+        eoAsyncSteadyStateEA(
+                eo::mpi::AssignmentAlgorithm& _assignAlgo,
+                int _masterRank,
+                eoSelectOne<EOT> & _select,
+                eoGenOp<EOT> & _op,
+                eoEvalFunc<EOT> & _eval,
+                eoReplacement<EOT> & _replace,
+                eoContinue<EOT> & _continuator
+                ) :
+            assignAlgo( _assignAlgo ),
+            masterRank( _masterRank ),
+            store( _select, _op, _eval, _replace, _continuator, _masterRank )
+        {
+            // empty
+        }
+
+        void operator()( eoPop<EOT> & _pop )
+        {
+            store.data( _pop );
+            eo::mpi::AsyncSteadyState<EOT> job( assignAlgo, masterRank, store );
+            job.run();
+        }
+
+        /**
+         * @brief Number of children inserted in the population during the last run (master side).
+         */
+        unsigned inserted()
+        {
+            return store.data()->inserted;
+        }
+
+    private:
+
+        eo::mpi::AssignmentAlgorithm & assignAlgo;
+        int masterRank;
+        eo::mpi::AsyncSteadyStateStore<EOT> store;
+};
+
+/**
+ * @}
+ */
+
+/**
+ * @example t-mpi-asyncSteadyState.cpp
+ */
+
+# endif // __EO_ASYNC_STEADY_STATE_H__
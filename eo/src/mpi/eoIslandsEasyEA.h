@@ -0,0 +1,429 @@
+/*
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation;
+    version 2 of the License.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+Contact: http://eodev.sourceforge.net
+*/
+# ifndef __EO_ISLANDS_EASY_EA_H__
+# define __EO_ISLANDS_EASY_EA_H__
+
+# include <eo>
+# include "eoMpi.h"
+
+# include <algorithm>
+# include <cmath>
+# include <limits>
+# include <list>
+# include <sstream>
+
+/**
+ * @ingroup MPI
+ * @{
+ */
+
+/**
+ * @file eoIslandsEasyEA.h
+ *
+ * @brief Island model: each MPI rank runs its own eoEasyEA, and the islands periodically exchange individuals.
+ *
+ * Every interval generations, each island selects emigrants from its population and sends them to its neighbours in
+ * the migration topology (ring, torus or random). At each generation, the immigrants which have arrived are
+ * integrated in the population by a replacement (by default, they replace the worst individuals).
+ *
+ * Exchanges are non blocking: emigrants are sent with mpi::communicator::isend, and immigrants are only received if
+ * they are already there (mpi::communicator::iprobe), so that an island never waits for a slower neighbour. Islands
+ * only synchronize when they all have finished their runs: the numbers of sent messages are then exchanged, so that
+ * the last immigrants are received (and integrated) and no message is left in flight.
+ *
+ * Individuals are sent as text, with their printOn/readFrom methods, so that any EOT can migrate.
+ *
+ * @ingroup MPI
+ */
+
+namespace eo
+{
+    namespace mpi
+    {
+        /**
+         * @brief Migration topology: gives the ranks of the islands to which an island sends its emigrants.
+         *
+         * It is called at each migration, with the rank of the island and the number of islands.
+         */
+        class IslandTopology : public eoBF< int, int, std::vector<int> >
+        {
+            public:
+                virtual std::string className() const { return "IslandTopology"; }
+        };
+
+        /**
+         * @brief Unidirectional ring: island i sends to island i+1.
+         */
+        class RingIslandTopology : public IslandTopology
+        {
+            public:
+                std::vector<int> operator()( int rank, int size )
+                {
+                    std::vector<int> neighbours;
+                    if( size > 1 )
+                    {
+                        neighbours.push_back( ( rank + 1 ) % size );
+                    }
+                    return neighbours;
+                }
+
+                virtual std::string className() const { return "RingIslandTopology"; }
+        };
+
+        /**
+         * @brief Torus: islands are laid row by row on a grid of the given width, each one sends to its 4 neighbours
+         * (the borders wrapping around).
+         *
+         * If the width is 0, the grid is as square as possible. If the number of islands is not a multiple of the
+         * width, the last row is incomplete and the columns wrap on the existing islands.
+         */
+        class TorusIslandTopology : public IslandTopology
+        {
+            public:
+                TorusIslandTopology( unsigned _width = 0 ) : width( _width ) {}
+
+                std::vector<int> operator()( int rank, int size )
+                {
+                    int w = width;
+                    if( w == 0 )
+                    {
+                        w = std::max( 1, static_cast<int>( std::ceil( std::sqrt( static_cast<double>( size ) ) ) ) );
+                    }
+                    w = std::min( w, size );
+                    int rows = ( size + w - 1 ) / w;
+
+                    int row = rank / w;
+                    int col = rank % w;
+                    int rowLength = std::min( w, size - row * w );
+
+                    std::vector<int> candidates;
+                    candidates.push_back( row * w + ( col + 1 ) % rowLength );
+                    candidates.push_back( row * w + ( col + rowLength - 1 ) % rowLength );
+                    candidates.push_back( columnNeighbour( row + 1, col, rows, w, size ) );
+                    candidates.push_back( columnNeighbour( row + rows - 1, col, rows, w, size ) );
+
+                    std::vector<int> neighbours;
+                    for( unsigned i = 0; i < candidates.size(); ++i )
+                    {
+                        if( candidates[i] != rank
+                                && std::find( neighbours.begin(), neighbours.end(), candidates[i] ) == neighbours.end() )
+                        {
+                            neighbours.push_back( candidates[i] );
+                        }
+                    }
+                    return neighbours;
+                }
+
+                virtual std::string className() const { return "TorusIslandTopology"; }
+
+            private:
+                // island of the given column in the given row, skipping the missing islands of the last row
+                int columnNeighbour( int row, int col, int rows, int w, int size )
+                {
+                    row %= rows;
+                    while( row * w + col >= size )
+                    {
+                        row = ( row + 1 ) % rows;
+                    }
+                    return row * w + col;
+                }
+
+                unsigned width;
+        };
+
+        /**
+         * @brief Random topology: at each migration, the island sends to the given number of other islands, drawn at
+         * random.
+         */
+        class RandomIslandTopology : public IslandTopology
+        {
+            public:
+                RandomIslandTopology( unsigned _nbNeighbours = 1 ) : nbNeighbours( _nbNeighbours ) {}
+
+                std::vector<int> operator()( int rank, int size )
+                {
+                    std::vector<int> others;
+                    for( int i = 0; i < size; ++i )
+                    {
+                        if( i != rank )
+                        {
+                            others.push_back( i );
+                        }
+                    }
+
+                    unsigned n = std::min<unsigned>( nbNeighbours, others.size() );
+                    // partial Fisher-Yates shuffle
+                    for( unsigned i = 0; i < n; ++i )
+                    {
+                        std::swap( others[i], others[ i + eo::rng.random( others.size() - i ) ] );
+                    }
+                    others.resize( n );
+                    return others;
+                }
+
+                virtual std::string className() const { return "RandomIslandTopology"; }
+
+            private:
+                unsigned nbNeighbours;
+        };
+    } // namespace mpi
+} // namespace eo
+
+/**
+ * @brief Island model over eo::mpi, running the given eoEasyEA on each MPI rank.
+ *
+ * The generation loop is the one of eoEasyEA (the continuator, breeder, evaluation and replacement of the given
+ * eoEasyEA are used), with the migrations after the replacement. Each rank gives its own population.
+ *
+ * Emigrants are selected by an eoSelect (which should copy, not remove them), and immigrants are integrated by an
+ * eoReplacement, the immigrants being its offspring. The simplest constructor uses the best or random individuals as
+ * emigrants, and replaces the worst individuals of the population by the immigrants.
+ *
+ * @ingroup MPI
+ */
+template< class EOT >
+class eoIslandsEasyEA : public eoAlgo<EOT>
+{
+    public:
+
+        /**
+         * @param _ea The algorithm run by this island.
+         * @param _topology The migration topology.
+         * @param _interval Number of generations between two migrations.
+         * @param _emigrants Selection of the emigrants.
+         * @param _immigration Integration of the immigrants in the population.
+         */
+        eoIslandsEasyEA(
+                eoEasyEA<EOT> & _ea,
+                eo::mpi::IslandTopology & _topology,
+                unsigned _interval,
+                eoSelect<EOT> & _emigrants,
+                eoReplacement<EOT> & _immigration
+                ) :
+            ea( _ea ), topology( _topology ), interval( std::max( 1u, _interval ) ),
+            emigrants( _emigrants ), immigration( _immigration ),
+            bestSelect( true ), selectNumber( bestSelect, 0 ),
+            comm( eo::mpi::Node::comm() )
+        {
+            // empty
+        }
+
+        /**
+         * @param _ea The algorithm run by this island.
+         * @param _topology The migration topology.
+         * @param _interval Number of generations between two migrations.
+         * @param _nbEmigrants Number of individuals sent to each neighbour at each migration.
+         * @param _randomEmigrants If true, the emigrants are drawn at random, otherwise the best ones are sent.
+         */
+        eoIslandsEasyEA(
+                eoEasyEA<EOT> & _ea,
+                eo::mpi::IslandTopology & _topology,
+                unsigned _interval,
+                unsigned _nbEmigrants,
+                bool _randomEmigrants = false
+                ) :
+            ea( _ea ), topology( _topology ), interval( std::max( 1u, _interval ) ),
+            emigrants( selectNumber ), immigration( replaceWorst ),
+            bestSelect( true ),
+            selectNumber( _randomEmigrants ? static_cast< eoSelectOne<EOT>& >( randomSelect ) : bestSelect, _nbEmigrants ),
+            comm( eo::mpi::Node::comm() )
+        {
+            // empty
+        }
+
+        /// Runs the island until its continuator stops, then waits for the other islands to finish.
+        virtual void operator()( eoPop<EOT>& _pop )
+        {
+            sent.assign( comm.size(), 0 );
+            received = 0;
+            unsigned generation = 0;
+
+            do
+            {
+                try
+                {
+                    unsigned pSize = _pop.size();
+
+                    ea.offspring.recycle(); // new offspring, in the storage of the previous ones
+
+                    ea.breed( _pop, ea.offspring );
+
+                    ea.popEval( _pop, ea.offspring ); // eval of parents + offspring if necessary
+
+                    ea.replace( _pop, ea.offspring ); // after replace, the new pop. is in _pop
+
+                    if( ++generation % interval == 0 )
+                    {
+                        emigrate( _pop );
+                    }
+                    immigrate( _pop, false );
+
+                    if( pSize > _pop.size() )
+                        throw std::runtime_error( "Population shrinking!" );
+                    else if( pSize < _pop.size() )
+                        throw std::runtime_error( "Population growing!" );
+                }
+                catch( std::exception& e )
+                {
+                    std::string s = e.what();
+                    s.append( " in eoIslandsEasyEA" );
+                    throw std::runtime_error( s );
+                }
+            }
+            while( ea.continuator( _pop ) );
+
+            finish( _pop );
+        }
+
+    protected:
+
+        /**
+         * @brief A migration sent to some neighbours, kept until all the sends are complete.
+         */
+        struct Outgoing
+        {
+            std::string buffer;
+            std::vector< bmpi::request > requests;
+        };
+
+        /// Sends the emigrants to the neighbours, without waiting.
+        void emigrate( const eoPop<EOT>& _pop )
+        {
+            std::vector<int> neighbours = topology( comm.rank(), comm.size() );
+            if( neighbours.empty() )
+            {
+                return;
+            }
+
+            eoPop<EOT> travellers;
+            emigrants( _pop, travellers );
+
+            outgoing.push_back( Outgoing() );
+            Outgoing& out = outgoing.back();
+
+            std::ostringstream os;
+            os.precision( std::numeric_limits<double>::digits10 + 2 );
+            travellers.printOn( os );
+            out.buffer = os.str();
+
+            for( unsigned i = 0; i < neighbours.size(); ++i )
+            {
+                out.requests.push_back( comm.isend( neighbours[i], eo::mpi::Channel::Migrations, out.buffer ) );
+                ++sent[ neighbours[i] ];
+            }
+
+            eo::log << eo::debug << "[I" << comm.rank() << "] Sent " << travellers.size() << " emigrants to "
+                << neighbours.size() << " islands." << std::endl;
+
+            releaseSent( false );
+        }
+
+        /// Receives and integrates the immigrants, waiting for them only if _wait is true.
+        void immigrate( eoPop<EOT>& _pop, bool _wait )
+        {
+            bmpi::status status;
+            while( _wait ? expected > received : comm.iprobe( bmpi::any_source, eo::mpi::Channel::Migrations, status ) )
+            {
+                int source = _wait ? bmpi::any_source : status.source();
+                std::string text;
+                comm.recv_single( source, eo::mpi::Channel::Migrations, text );
+                ++received;
+
+                // each migration is integrated on its own, as when it is sent
+                std::istringstream is( text );
+                eoPop<EOT> immigrants;
+                immigrants.readFrom( is );
+                if( ! immigrants.empty() )
+                {
+                    eo::log << eo::debug << "[I" << comm.rank() << "] Integrates " << immigrants.size()
+                        << " immigrants." << std::endl;
+                    immigration( _pop, immigrants );
+                }
+            }
+        }
+
+        /// Forgets the complete sends, waiting for all of them if _wait is true.
+        void releaseSent( bool _wait )
+        {
+            typename std::list< Outgoing >::iterator it = outgoing.begin();
+            while( it != outgoing.end() )
+            {
+                bool complete = true;
+                for( unsigned i = 0; i < it->requests.size(); ++i )
+                {
+                    if( _wait )
+                    {
+                        it->requests[i].wait();
+                    } else
+                    {
+                        complete = it->requests[i].test() && complete;
+                    }
+                }
+
+                if( complete )
+                {
+                    it = outgoing.erase( it );
+                } else
+                {
+                    ++it;
+                }
+            }
+        }
+
+        /// Receives the immigrants still in flight once all the islands have finished.
+        void finish( eoPop<EOT>& _pop )
+        {
+            std::vector<int> fromOthers;
+            comm.all_to_all( sent, fromOthers );
+            expected = 0;
+            for( unsigned i = 0; i < fromOthers.size(); ++i )
+            {
+                expected += fromOthers[i];
+            }
+
+            immigrate( _pop, true );
+            releaseSent( true );
+        }
+
+        eoEasyEA<EOT> & ea;
+        eo::mpi::IslandTopology & topology;
+        unsigned interval;
+        eoSelect<EOT> & emigrants;
+        eoReplacement<EOT> & immigration;
+
+        // default policies: best or random emigrants, replacement of the worst
+        eoSequentialSelect<EOT> bestSelect;
+        eoRandomSelect<EOT> randomSelect;
+        eoSelectNumber<EOT> selectNumber;
+        eoSSGAWorseReplacement<EOT> replaceWorst;
+
+        bmpi::communicator & comm;
+        std::list< Outgoing > outgoing;
+        std::vector<int> sent;
+        int received;
+        int expected;
+};
+
+/**
+ * @}
+ */
+
+/**
+ * @example t-mpi-islands.cpp
+ */
+
+# endif // __EO_ISLANDS_EASY_EA_H__
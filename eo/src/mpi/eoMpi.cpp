@@ -34,6 +34,7 @@ namespace eo
         {
             const int Commands = 0;
             const int Messages = 1;
+            const int Migrations = 2;
         }
 
         namespace Message
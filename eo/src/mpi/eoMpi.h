@@ -136,8 +136,8 @@ namespace eo
          * @brief Tags used in MPI messages for framework communication
          *
          * These tags are used for framework communication and fits "channels", so as to differentiate when we're
-         * sending an order to a worker (Commands) or data (Messages). They are not reserved by the framework and can be
-         * used by the user, but he is not bound to.
+         * sending an order to a worker (Commands) or data (Messages). Islands exchange their emigrants on the Migrations
+         * channel. They are not reserved by the framework and can be used by the user, but he is not bound to.
          *
          * @ingroup MPI
          */
@@ -145,6 +145,7 @@ namespace eo
         {
             extern const int Commands;
             extern const int Messages;
+            extern const int Migrations;
         }
 
         /**
@@ -694,7 +695,8 @@ namespace eo
                  *
                  * Launches the parallelized job algorithm : while there is something to do (! IsFinished ), get a
                  * worker who will be the assignee ; if no worker is available, wait for a response, handle it and reask
-                 * for an assignee. Then send the command and the task.
+                 * for an assignee. Then, unless the handled responses have finished the job, send the command and the
+                 * task.
                  * Once there is no more to do (IsFinished), indicate to all available workers that they're free, wait
                  * for all the responses and send termination messages (see also FinallyBlock).
                  */
@@ -724,6 +726,14 @@ namespace eo
                             }
                             timerStat.stop("master_wait_for_assignee");
 
+                            // the responses handled while waiting can have finished the job: the assignee is given
+                            // back without any task
+                            if( isFinished() )
+                            {
+                                assignmentAlgo.confirm( assignee );
+                                break;
+                            }
+
                             eo::log << eo::debug << "[M" << comm.rank() << "] Assignee : " << assignee << std::endl;
 
                             timerStat.start("master_wait_for_send");
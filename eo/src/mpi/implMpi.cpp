@@ -36,6 +36,11 @@ namespace mpi
         MPI_Finalize();
     }
 
+    status::status( ) : _source( -1 ), _tag( -1 ), _error( 0 )
+    {
+        // empty
+    }
+
     status::status( const MPI_Status & s )
     {
         _source = s.MPI_SOURCE;
@@ -43,6 +48,23 @@ namespace mpi
         _error = s.MPI_ERROR;
     }
 
+    request::request( ) : _request( MPI_REQUEST_NULL )
+    {
+        // empty
+    }
+
+    bool request::test( )
+    {
+        int flag;
+        MPI_Test( &_request, &flag, MPI_STATUS_IGNORE );
+        return flag;
+    }
+
+    void request::wait( )
+    {
+        MPI_Wait( &_request, MPI_STATUS_IGNORE );
+    }
+
     communicator::communicator( )
     {
         _rank = -1;
@@ -123,6 +145,34 @@ namespace mpi
         str.assign( _buf );
     }
 
+    request communicator::isend( int dest, int tag, const std::string& str )
+    {
+        request req;
+        MPI_Isend( (char*)str.c_str(), str.size() + 1, MPI_CHAR, dest, tag, MPI_COMM_WORLD, &req._request );
+        return req;
+    }
+
+    void communicator::recv_single( int src, int tag, std::string& str )
+    {
+        MPI_Status stat;
+        int size;
+        MPI_Probe( src, tag, MPI_COMM_WORLD, &stat );
+        MPI_Get_count( &stat, MPI_CHAR, &size );
+
+        if( _buf == 0 )
+        {
+            _buf = new char[ size ];
+            _bufsize = size;
+        } else if( _bufsize < size )
+        {
+            delete [] _buf;
+            _buf = new char[ size ];
+            _bufsize = size;
+        }
+        MPI_Recv( _buf, size, MPI_CHAR, stat.MPI_SOURCE, stat.MPI_TAG, MPI_COMM_WORLD, &stat );
+        str.assign( _buf );
+    }
+
     /*
      * SEND / RECV Objects
      */
@@ -154,6 +204,24 @@ namespace mpi
         return status( stat );
     }
 
+    bool communicator::iprobe( int src, int tag, status& stat )
+    {
+        int flag;
+        MPI_Status s;
+        MPI_Iprobe( src, tag, MPI_COMM_WORLD, &flag, &s );
+        if( flag )
+        {
+            stat = status( s );
+        }
+        return flag;
+    }
+
+    void communicator::all_to_all( const std::vector<int>& sent, std::vector<int>& received )
+    {
+        received.resize( sent.size() );
+        MPI_Alltoall( (int*)&sent[0], 1, MPI_INT, &received[0], 1, MPI_INT, MPI_COMM_WORLD );
+    }
+
     void communicator::barrier()
     {
         MPI_Barrier( MPI_COMM_WORLD );
@@ -23,7 +23,11 @@ Authors:
 # define __EO_IMPL_MPI_HPP__
 
 # include <mpi.h>
+# include <vector>
 # include <serial/eoSerial.h>
+# include <eoVector.h>
+# include <eoScalarFitness.h>
+# include <eoRawFormat.h>
 
 /**
  * This namespace contains reimplementations of some parts of the Boost::MPI API in C++, so as to be used in
@@ -36,6 +40,9 @@ Authors:
  * instance, users can just send integer, std::string or eoserial::Persistent objects;
  * furthermore, only eoserial::Persistent objects can sent in a table.
  *
+ * Tables of eoVector, eoReal or eoInt individuals whose genes and fitness are plain scalars are an exception: they
+ * are sent as raw bytes, without going through eoserial (see mpi::wire_format and eoRawIndividual).
+ *
  * The documentation of the functions is exactly the same as the official Boost::MPI
  * documentation. You can find it on www.boost.org/doc/libs/1_49_0/doc/html/mpi/
  * The entities are here shortly described, if you need further details, don't hesitate
@@ -92,6 +99,11 @@ namespace mpi
     {
         public:
 
+        /**
+         * @brief Empty status, filled by communicator::iprobe.
+         */
+        status( );
+
         /**
          * @brief Converts a MPI_Status into a status.
          */
@@ -118,6 +130,75 @@ namespace mpi
             int _error;
     };
 
+    /**
+     * @brief Wrapper class for MPI_Request, the handle of a non blocking communication.
+     */
+    class request
+    {
+        public:
+
+        request( );
+
+        /**
+         * @brief Returns true if the communication is complete, without waiting (MPI_Test).
+         */
+        bool test( );
+
+        /**
+         * @brief Waits for the communication to complete (MPI_Wait).
+         */
+        void wait( );
+
+        private:
+            MPI_Request _request;
+
+        friend class communicator;
+    };
+
+    /**
+     * @brief Tag of the tables sent in JSON, through eoserial::Persistent.
+     */
+    struct json_format {};
+
+    /**
+     * @brief Tag of the tables of raw individuals sent as raw bytes.
+     */
+    struct binary_format {};
+
+    /**
+     * @brief Tells whether a type can be sent as raw bytes, and as which scalar type (see eoRawTraits).
+     */
+    template< class T >
+    struct raw_traits : public eoRawTraits< T > {};
+
+    /**
+     * @brief Selects the wire format from a boolean.
+     */
+    template< bool binary >
+    struct select_format
+    {
+        typedef json_format type;
+    };
+
+    template<>
+    struct select_format< true >
+    {
+        typedef binary_format type;
+    };
+
+    /**
+     * @brief Wire format of a table of individuals, given by their exact type.
+     *
+     * They are sent in binary when they are entirely described by their fitness and their genes (see
+     * eoRawIndividual): the classes deriving from eoVector with more data, such as eoEsStdev, go through JSON.
+     */
+    template< class T >
+    typename select_format< eoRawIndividual<T>::value >::type
+    wire_format( const T* )
+    {
+        return typename select_format< eoRawIndividual<T>::value >::type();
+    }
+
     /**
      * @brief Main object, used to send / receive messages, get informations about the rank and the size of the world,
      * etc.
@@ -189,6 +270,27 @@ namespace mpi
          */
         void recv( int src, int tag, std::string& str );
 
+        /**
+         * @brief Sends a string to dest on channel "tag", without waiting for the receiver.
+         *
+         * The string is sent as a single message, which has to be received with recv_single. It must not be modified
+         * nor destroyed before the returned request is complete.
+         *
+         * @param dest MPI rank of the receiver
+         * @param tag MPI tag of message
+         * @param str The std::string to send
+         */
+        request isend( int dest, int tag, const std::string& str );
+
+        /*
+         * @brief Receives a string sent by isend from src on channel "tag".
+         *
+         * @param src MPI rank of the sender
+         * @param tag MPI tag of message
+         * @param std::string Where to save the received string
+         */
+        void recv_single( int src, int tag, std::string& str );
+
         /*
          * SEND / RECV Objects
          */
@@ -205,6 +307,8 @@ namespace mpi
         /**
          * @brief Sends an array of eoserial::Persistent to dest on channel "tag".
          *
+         * Raw individuals (see eoRawIndividual) are sent in binary, see mpi::wire_format.
+         *
          * @param dest MPI rank of the receiver
          * @param tag MPI tag of message
          * @param table The array of eoserial::Persistent objects
@@ -214,23 +318,7 @@ namespace mpi
         template< class T >
         void send( int dest, int tag, T* table, int size )
         {
-            // Puts all the values into an array
-            eoserial::Array* array = new eoserial::Array;
-
-            for( int i = 0; i < size; ++i )
-            {
-                array->push_back( table[i].pack() );
-            }
-
-            // Encapsulates the array into an object
-            eoserial::Object* obj = new eoserial::Object;
-            obj->add( "array", array );
-            std::stringstream ss;
-            obj->print( ss );
-            delete obj;
-
-            // Sends the object as a string
-            send( dest, tag, ss.str() );
+            send( dest, tag, table, size, wire_format( table ) );
         }
 
         /*
@@ -245,6 +333,9 @@ namespace mpi
         /*
          * @brief Receives an array of eoserial::Persistent from src on channel "tag".
          *
+         * The table has to be sent with the same wire format, which is the case as soon as both sides use the same
+         * type.
+         *
          * @param src MPI rank of the sender
          * @param tag MPI tag of message
          * @param table The table in which we're saving the received objects. It must have been allocated by the user,
@@ -255,20 +346,7 @@ namespace mpi
         template< class T >
         void recv( int src, int tag, T* table, int size )
         {
-            // Receives the string which contains the object
-            std::string asText;
-            recv( src, tag, asText );
-
-            // Parses the object and retrieves the table
-            eoserial::Object* obj = eoserial::Parser::parse( asText );
-            eoserial::Array* array = static_cast<eoserial::Array*>( (*obj)["array"] );
-
-            // Retrieves all the values from the array
-            for( int i = 0; i < size; ++i )
-            {
-                eoserial::unpackObject( *array, i, table[i] );
-            }
-            delete obj;
+            recv( src, tag, table, size, wire_format( table ) );
         }
 
         /*
@@ -286,6 +364,26 @@ namespace mpi
          */
         status probe( int src = any_source, int tag = any_tag );
 
+        /**
+         * @brief Wrapper for MPI_Iprobe
+         *
+         * Checks, without waiting, whether a message from process having rank src is available on the channel tag.
+         *
+         * @param src MPI rank of the sender (any_source if it can be any sender)
+         * @param tag MPI tag of the expected message (any_tag if it can be any tag)
+         * @param stat Status of the available message, if any
+         * @return true if a message is available
+         */
+        bool iprobe( int src, int tag, status& stat );
+
+        /**
+         * @brief Wrapper for MPI_Alltoall, with one integer per process
+         *
+         * @param sent The integer to send to each process, indexed by rank
+         * @param received Where to save the integer received from each process, indexed by rank
+         */
+        void all_to_all( const std::vector<int>& sent, std::vector<int>& received );
+
         /**
          * @brief Wrapper for MPI_Barrier
          *
@@ -294,6 +392,151 @@ namespace mpi
         void barrier();
 
         private:
+
+        /*
+         * SEND / RECV tables in JSON
+         */
+
+        template< class T >
+        void send( int dest, int tag, T* table, int size, json_format )
+        {
+            // Puts all the values into an array
+            eoserial::Array* array = new eoserial::Array;
+
+            for( int i = 0; i < size; ++i )
+            {
+                array->push_back( table[i].pack() );
+            }
+
+            // Encapsulates the array into an object
+            eoserial::Object* obj = new eoserial::Object;
+            obj->add( "array", array );
+            std::stringstream ss;
+            obj->print( ss );
+            delete obj;
+
+            // Sends the object as a string
+            send( dest, tag, ss.str() );
+        }
+
+        template< class T >
+        void recv( int src, int tag, T* table, int size, json_format )
+        {
+            // Receives the string which contains the object
+            std::string asText;
+            recv( src, tag, asText );
+
+            // Parses the object and retrieves the table
+            eoserial::Object* obj = eoserial::Parser::parse( asText );
+            eoserial::Array* array = static_cast<eoserial::Array*>( (*obj)["array"] );
+
+            // Retrieves all the values from the array
+            for( int i = 0; i < size; ++i )
+            {
+                eoserial::unpackObject( *array, i, table[i] );
+            }
+            delete obj;
+        }
+
+        /*
+         * SEND / RECV tables in binary
+         *
+         * Two messages are sent: a header holding the genome size and the validity of each individual, then the
+         * fitnesses and the genes. The latter are sent straight from the genomes of the table (and received straight
+         * into them), through a MPI datatype made of their addresses. Raw bytes are sent, hence both sides must share
+         * the same representation of the scalar types.
+         */
+
+        template< class T >
+        void send( int dest, int tag, T* table, int size, binary_format )
+        {
+            typedef typename raw_traits< typename T::Fitness >::type FitnessType;
+
+            std::vector< int > header( 2 * size );
+            std::vector< FitnessType > fitnesses( size );
+            for( int i = 0; i < size; ++i )
+            {
+                header[ 2*i ] = table[i].size();
+                header[ 2*i+1 ] = table[i].invalid();
+                if( !table[i].invalid() )
+                {
+                    fitnesses[i] = table[i].fitness();
+                }
+            }
+            MPI_Send( header.empty() ? 0 : &header[0], header.size(), MPI_INT, dest, tag, MPI_COMM_WORLD );
+
+            MPI_Datatype type = binary_type( table, size, fitnesses );
+            MPI_Send( MPI_BOTTOM, 1, type, dest, tag, MPI_COMM_WORLD );
+            MPI_Type_free( &type );
+        }
+
+        template< class T >
+        void recv( int src, int tag, T* table, int size, binary_format )
+        {
+            typedef typename raw_traits< typename T::Fitness >::type FitnessType;
+            MPI_Status stat;
+
+            std::vector< int > header( 2 * size );
+            MPI_Recv( header.empty() ? 0 : &header[0], header.size(), MPI_INT, src, tag, MPI_COMM_WORLD, &stat );
+            for( int i = 0; i < size; ++i )
+            {
+                table[i].resize( header[ 2*i ] );
+            }
+
+            std::vector< FitnessType > fitnesses( size );
+            MPI_Datatype type = binary_type( table, size, fitnesses );
+            MPI_Recv( MPI_BOTTOM, 1, type, src, tag, MPI_COMM_WORLD, &stat );
+            MPI_Type_free( &type );
+
+            for( int i = 0; i < size; ++i )
+            {
+                if( header[ 2*i+1 ] )
+                {
+                    table[i].invalidate();
+                } else
+                {
+                    table[i].fitness( fitnesses[i] );
+                }
+            }
+        }
+
+        /**
+         * @brief Builds the MPI datatype covering the fitnesses and the genes of the table, at their absolute
+         * addresses.
+         */
+        template< class T, class FitnessType >
+        MPI_Datatype binary_type( T* table, int size, std::vector< FitnessType >& fitnesses )
+        {
+            std::vector< int > lengths;
+            std::vector< MPI_Aint > addresses;
+            MPI_Aint address;
+
+            if( size > 0 )
+            {
+                MPI_Get_address( &fitnesses[0], &address );
+                lengths.push_back( size * sizeof( FitnessType ) );
+                addresses.push_back( address );
+            }
+
+            for( int i = 0; i < size; ++i )
+            {
+                if( table[i].size() > 0 )
+                {
+                    MPI_Get_address( &table[i][0], &address );
+                    lengths.push_back( table[i].size() * sizeof( typename T::AtomType ) );
+                    addresses.push_back( address );
+                }
+            }
+
+            MPI_Datatype type;
+            MPI_Type_create_hindexed( lengths.size(),
+                    lengths.empty() ? 0 : &lengths[0],
+                    addresses.empty() ? 0 : &addresses[0],
+                    MPI_BYTE, &type );
+            MPI_Type_commit( &type );
+            return type;
+        }
+
             int _rank;
             int _size;
 
@@ -60,13 +60,18 @@
     but before that it will call in turn every single
              {statistics, updaters, monitors} that it has been given,
     and after that, if stopping, all lastCall methods of the above.
+
+    The stats that can be computed from an eoStatSweep (average, stdev,
+    best fitness, nth element, quantiles...) are all computed in a single
+    sweep of the population, and do not need the population to be sorted:
+    it is sorted only for the other sorted stats.
 */
 template <class EOT>
 class eoCheckPoint : public eoContinue<EOT>
 {
 public :
 
-    eoCheckPoint(eoContinue<EOT>& _cont)
+    eoCheckPoint(eoContinue<EOT>& _cont) : unsortedSorted(0)
   {
     continuators.push_back(&_cont);
   }
@@ -74,8 +79,18 @@ public :
     bool operator()(const eoPop<EOT>& _pop);
 
     void add(eoContinue<EOT>& _cont) { continuators.push_back(&_cont); }
-    void add(eoSortedStatBase<EOT>& _stat) { sorted.push_back(&_stat); }
-    void add(eoStatBase<EOT>& _stat) { stats.push_back(&_stat); }
+    void add(eoSortedStatBase<EOT>& _stat)
+    {
+        sorted.push_back(&_stat);
+        sortedSwept.push_back(_stat.subscribe(sweep));
+        if (!sortedSwept.back())
+            ++unsortedSorted;
+    }
+    void add(eoStatBase<EOT>& _stat)
+    {
+        stats.push_back(&_stat);
+        statsSwept.push_back(_stat.subscribe(sweep));
+    }
     void add(eoMonitor& _mon)        { monitors.push_back(&_mon); }
     void add(eoUpdater& _upd)        { updaters.push_back(&_upd); }
 
@@ -87,6 +102,10 @@ private :
   std::vector<eoContinue<EOT>*>    continuators;
     std::vector<eoSortedStatBase<EOT>*>    sorted;
     std::vector<eoStatBase<EOT>*>    stats;
+    std::vector<bool> sortedSwept;  // whether the stat is computed from the sweep
+    std::vector<bool> statsSwept;
+    unsigned unsortedSorted;        // sorted stats that need the population to be sorted
+    eoStatSweep<EOT> sweep;
     std::vector<eoMonitor*> monitors;
     std::vector<eoUpdater*> updaters;
 };
@@ -96,19 +115,29 @@ bool eoCheckPoint<EOT>::operator()(const eoPop<EOT>& _pop)
 {
     unsigned i;
 
+    if (sweep.needed())
+      sweep(_pop);
+
+    // sorted_pop stays empty when all the sorted stats use the sweep
     std::vector<const EOT*> sorted_pop;
-    if (!sorted.empty())
-    {
+    if (unsortedSorted > 0)
       _pop.sort(sorted_pop);
 
-      for (i = 0; i < sorted.size(); ++i)
-      {
+    for (i = 0; i < sorted.size(); ++i)
+    {
+      if (sortedSwept[i])
+        sorted[i]->fromSweep(sweep);
+      else
         (*sorted[i])(sorted_pop);
-      }
     }
 
     for (i = 0; i < stats.size(); ++i)
+    {
+      if (statsSwept[i])
+        stats[i]->fromSweep(sweep);
+      else
         (*stats[i])(_pop);
+    }
 
     for (i = 0; i < updaters.size(); ++i)
         (*updaters[i])();
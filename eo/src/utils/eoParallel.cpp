@@ -31,6 +31,7 @@ Authors:
 
 #include "eoParallel.h"
 #include "eoLogger.h"
+#include "eoRNG.h"
 
 eoParallel::eoParallel() :
     _isEnabled( false, "parallelize-loop", "Enable memory shared parallelization into evaluation's loops", '\0' ),
@@ -107,6 +108,7 @@ void make_parallel(eoParser& parser)
                 {
                     omp_set_num_threads( eo::parallel.nthreads() );
                 }
+            eo::rngPool.reserve( omp_get_max_threads() );
         }
 
     if ( eo::parallel.doMeasure() )
@@ -15,4 +15,7 @@ namespace eo
 {
     // global random number generator object
     eoRng rng(static_cast<uint32_t>(time(0)));
+
+    // per-thread generators, populated on demand by parallel loops
+    eoRngPool rngPool;
 }
@@ -53,6 +53,10 @@ typedef unsigned long uint32_t;
 #include "eoPersistent.h"
 #include "eoObject.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 /** Random Number Generator
 
@@ -453,6 +457,138 @@ namespace eo
 }
 using eo::rng;
 
+
+
+/** Pool of independent random number generators, one per OpenMP thread
+
+@class eoRngPool eoRNG.h utils/eoRNG.h
+
+The global eo::rng cannot be shared by the threads of a parallel region: its
+state and next pointer would be updated concurrently. eoRngPool holds one
+private eoRng stream for each additional thread, so that stochastic code
+running inside a parallel loop does not need any lock. Thread 0 (and any code
+running outside a parallel region) keeps on using eo::rng itself, so that a
+sequential run draws exactly the same numbers as before.
+
+Streams are derived from a seed sequence: stream i is seeded with a hashed
+combination of the master seed and i. When streams are created implicitly by
+reserve(), the master seed is drawn from eo::rng, hence a run is reproducible
+for a fixed eo::rng seed and a fixed number of threads, provided the work is
+distributed statically among threads (--parallelize-dynamic=0).
+
+Use eo::threadRng() to get the generator of the calling thread.
+*/
+class eoRngPool
+{
+public :
+
+    eoRngPool() {}
+
+    /** Destructor */
+    ~eoRngPool()
+        {
+            for (size_t i = 0; i < streams.size(); ++i)
+            {
+                delete streams[i];
+            }
+        }
+
+    /** Make sure the pool can serve _nthreads threads
+
+    Missing streams are created and seeded from a master seed drawn from
+    eo::rng. Existing streams are kept untouched.
+
+    @warning Must be called outside of any parallel region.
+    */
+    void reserve(unsigned _nthreads)
+        {
+            if (_nthreads <= size())
+                return;
+
+            uint32_t master = eo::rng.rand();
+            for (unsigned i = size(); i < _nthreads; ++i)
+            {
+                streams.push_back(new eoRng(mix(master, i)));
+            }
+        }
+
+    /** Reseed every stream of the pool from a master seed
+
+    Stream i is reseeded with a hash of (_seed, i), so that two pools
+    reseeded with the same value produce the same streams.
+
+    @warning Must be called outside of any parallel region.
+    */
+    void reseed(uint32_t _seed)
+        {
+            for (unsigned i = 1; i < size(); ++i)
+            {
+                streams[i-1]->reseed(mix(_seed, i));
+            }
+        }
+
+    /** Number of threads served by the pool, thread 0 included */
+    unsigned size() const { return streams.size() + 1; }
+
+    /** Generator of thread _i; thread 0 is served by eo::rng */
+    eoRng& operator[](unsigned _i)
+        {
+            return _i == 0 ? eo::rng : *streams[_i-1];
+        }
+
+private:
+
+    /** @brief Derive the seed of stream _i from a master seed
+
+    Uses the finalizer of the 32 bits MurmurHash3, so that close master
+    seeds or close indexes give uncorrelated initial states.
+    */
+    static uint32_t mix(uint32_t _seed, uint32_t _i)
+        {
+            uint32_t h = _seed ^ (0x9E3779B9U * (_i + 1));
+            h ^= h >> 16;
+            h *= 0x85EBCA6BU;
+            h ^= h >> 13;
+            h *= 0xC2B2AE35U;
+            h ^= h >> 16;
+            return h;
+        }
+
+    /** @brief Streams of threads 1 to size()-1 */
+    std::vector<eoRng*> streams;
+
+    /** @brief Not copyable, see eoRng */
+    eoRngPool(const eoRngPool&);
+
+    /** @brief Not assignable, see eoRng */
+    eoRngPool& operator=(const eoRngPool&);
+};
+
+
+
+namespace eo
+{
+    /** The global pool of per-thread generators */
+    extern eoRngPool rngPool;
+
+    /** @brief Generator of the calling thread
+
+    Returns eo::rng when called from the master thread or outside of any
+    parallel region, and the private stream of the thread otherwise. A thread
+    that the pool was not reserved for falls back on eo::rng (which is then
+    shared, as before).
+    */
+    inline eoRng& threadRng()
+    {
+#ifdef _OPENMP
+        unsigned t = omp_get_thread_num();
+        if (t > 0 && t < rngPool.size())
+            return rngPool[t];
+#endif // _OPENMP
+        return rng;
+    }
+}
+
 /** @} */
 
 
@@ -539,7 +675,7 @@ namespace eo
     /** @brief Random function
 
     This is a convenience function for generating random numbers using the
-    global eo::rng object.
+    generator of the calling thread (see eo::threadRng).
 
     Templatized random function, returns a random double in the range [min, max).
     It works with most basic types such as:
@@ -554,14 +690,14 @@ namespace eo
     */
     template <typename T>
     inline T random(const T& min, const T& max) {
-        return static_cast<T>(rng.uniform() * (max-min)) + min; }
+        return static_cast<T>(threadRng().uniform() * (max-min)) + min; }
 
     /** @brief Random function
 
     @overload
 
     This is a convenience function for generating random numbers using the
-    global eo::rng object.
+    generator of the calling thread (see eo::threadRng).
 
     Templatized random function, returns a random double in the range [0, max).
     It works with most basic types such as:
@@ -575,16 +711,16 @@ namespace eo
     */
     template <typename T>
     inline T random(const T& max) {
-        return static_cast<T>(rng.uniform() * max); }
+        return static_cast<T>(threadRng().uniform() * max); }
 
     /** Normal distribution
 
     This is a convenience function for generating random numbers using the
-    global eo::rng object.
+    generator of the calling thread (see eo::threadRng).
 
     @return ormally distributed random number
     */
-    inline double normal() { return rng.normal(); }
+    inline double normal() { return threadRng().normal(); }
 }
 
 
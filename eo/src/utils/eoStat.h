@@ -38,6 +38,7 @@ Contact: http://eodev.sourceforge.net
 #include <utils/eoParam.h>
 #include <eoPop.h>
 #include <utils/eoMonitor.h>
+#include <utils/eoStatSweep.h>
 //#include <utils/eoCheckPoint.h>
 
 /** @defgroup Stats Statistics computation
@@ -69,6 +70,23 @@ class eoStatBase : public eoUF<const eoPop<EOT>&, void>
 public:
   virtual void lastCall(const eoPop<EOT>&) {}
   virtual std::string className(void) const { return "eoStatBase"; }
+
+  /** Stats that can be computed from an eoStatSweep tell it what they need,
+      and return true: an eoCheckPoint then calls fromSweep instead of operator() */
+  virtual bool subscribe(eoStatSweep<EOT>&) { return false; }
+
+  /// reads the value of the stat, once the sweep is done
+  virtual void fromSweep(const eoStatSweep<EOT>&) {}
+
+protected:
+  /// computes the stat on its own, with a sweep of the population for it only
+  void sweepAlone(const eoPop<EOT>& _pop)
+  {
+      eoStatSweep<EOT> sweep;
+      subscribe(sweep);
+      sweep(_pop);
+      fromSweep(sweep);
+  }
 };
 
 
@@ -108,6 +126,12 @@ public:
   virtual void lastCall(const std::vector<const EOT*>&) {}
   virtual std::string className(void) const { return "eoSortedStatBase"; }
 
+  /** Sorted stats that only need some ranks can get them from an eoStatSweep
+      (see eoStatBase::subscribe), and spare the sort of the population */
+  virtual bool subscribe(eoStatSweep<EOT>&) { return false; }
+
+  /// reads the value of the stat, once the sweep is done
+  virtual void fromSweep(const eoStatSweep<EOT>&) {}
 };
 
 /**
@@ -157,22 +181,14 @@ public :
     eoAverageStat(double _value, std::string _desc) : eoStat<EOT, double>(_value, _desc) {}
 
     virtual void operator()(const eoPop<EOT>& _pop){
-      doit(_pop, Fitness()); // specializations for scalar and std::vector
+      this->sweepAlone(_pop);
     }
 
-  virtual std::string className(void) const { return "eoAverageStat"; }
-
-private :
-
-    // Default behavior
-    template <class T>
-    void doit(const eoPop<EOT>& _pop, T)
-    {
-        Fitness v = std::accumulate(_pop.begin(), _pop.end(), Fitness(0.0), eoAverageStat::sumFitness);
+    virtual bool subscribe(eoStatSweep<EOT>& _sweep) { _sweep.needMoments(); return true; }
 
-        value() = v / _pop.size();
-    }
+    virtual void fromSweep(const eoStatSweep<EOT>& _sweep) { value() = _sweep.average(); }
 
+  virtual std::string className(void) const { return "eoAverageStat"; }
 };
 
 /**
@@ -204,11 +220,16 @@ public :
 
     virtual void operator()(const eoPop<EOT>& _pop)
     {
-        SquarePair result = std::accumulate(_pop.begin(), _pop.end(), std::make_pair(0.0, 0.0), eoSecondMomentStats::sumOfSquares);
+        this->sweepAlone(_pop);
+    }
+
+    virtual bool subscribe(eoStatSweep<EOT>& _sweep) { _sweep.needMoments(); return true; }
 
-        double n = _pop.size();
-        value().first = result.first / n; // average
-        value().second = sqrt( (result.second - n * value().first * value().first) / (n - 1.0)); // stdev
+    virtual void fromSweep(const eoStatSweep<EOT>& _sweep)
+    {
+        double n = _sweep.size();
+        value().first = _sweep.sum() / n; // average
+        value().second = sqrt( (_sweep.sumOfSquares() - n * value().first * value().first) / (n - 1.0)); // stdev
     }
 
   virtual std::string className(void) const { return "eoSecondMomentStats"; }
@@ -241,6 +262,16 @@ public :
         doit(_pop, Fitness());
     }
 
+    virtual bool subscribe(eoStatSweep<EOT>& _sweep) { _sweep.needRank(whichElement); return true; }
+
+    virtual void fromSweep(const eoStatSweep<EOT>& _sweep)
+    {
+        if (whichElement >= _sweep.size())
+            throw std::logic_error("fitness requested of element outside of pop");
+
+        value() = _sweep.ranked(whichElement).fitness();
+    }
+
   virtual std::string className(void) const { return "eoNthElementFitnessStat"; }
 private :
 
@@ -321,9 +352,13 @@ public:
         {}
 
     void operator()(const eoPop<EOT>& _pop) {
-        doit(_pop, Fitness() ); // specializations for scalar and std::vector
+        this->sweepAlone(_pop);
     }
 
+    virtual bool subscribe(eoStatSweep<EOT>& _sweep) { _sweep.needExtremes(); return true; }
+
+    virtual void fromSweep(const eoStatSweep<EOT>& _sweep) { value() = _sweep.best().fitness(); }
+
     virtual std::string className(void) const { return "eoBestFitnessStat"; }
 
 
@@ -344,14 +379,6 @@ private :
       unsigned which;
       bool maxim;
     };
-
-    // default
-    template<class T>
-    void doit(const eoPop<EOT>& _pop, T)
-    { // find the largest elements
-      value() = _pop.best_element().fitness();
-    }
-
 };
 /** @example t-eoSSGA.cpp
  */
@@ -368,9 +395,16 @@ public:
         : eoStat<EOT, EOT>( EOT(), _description )
         {}
 
-    void operator()(const eoPop<EOT>& pop) 
+    void operator()(const eoPop<EOT>& pop)
+    {
+        this->sweepAlone(pop);
+    }
+
+    virtual bool subscribe(eoStatSweep<EOT>& _sweep) { _sweep.needExtremes(); return true; }
+
+    virtual void fromSweep(const eoStatSweep<EOT>& _sweep)
     {
-        EOT best = pop.best_element();
+        const EOT& best = _sweep.best();
         // on the first call, value() is invalid
         if( value().invalid() ) {
             // thus we cannot compare it to something else
@@ -436,24 +470,33 @@ public:
 
 
 
-/*
+/**
+    Std. dev. of the fitnesses of a population, fitness needs to be scalar.
+*/
 template <class EOT>
 class eoStdevStat : public eoStat<EOT, double >
 {
 public :
-    typedef typename eoSecondMomentStats<EOT>::SquarePair SquarePair;
+    using eoStat<EOT, double>::value;
 
     eoStdevStat(std::string _description = "Stdev") : eoStat<EOT, double>(0.0, _description) {}
 
     virtual void operator()(const eoPop<EOT>& _pop)
     {
-        SquarePair result = std::accumulate(pop.begin(), pop.end(), std::make_pair(0.0, 0.0), eoSecondMomentStats::sumOfSquares);
+        this->sweepAlone(_pop);
+    }
+
+    virtual bool subscribe(eoStatSweep<EOT>& _sweep) { _sweep.needMoments(); return true; }
 
-        double n = pop.size();
-        value() = sqrt( (result.second - (result.first / n)) / (n - 1.0)); // stdev
+    virtual void fromSweep(const eoStatSweep<EOT>& _sweep)
+    {
+        double n = _sweep.size();
+        double average = _sweep.sum() / n;
+        value() = sqrt( (_sweep.sumOfSquares() - n * average * average) / (n - 1.0)); // stdev
     }
+
+    virtual std::string className(void) const { return "eoStdevStat"; }
 };
-*/
 
 
 //! A robust measure of dispersion (also called midspread or middle fifty) that is the difference between the third and the first quartile.
@@ -467,20 +510,27 @@ public:
 
     virtual void operator()( const eoPop<EOT> & _pop )
     {
-        if( _pop.size() == 0 ) {
-            // how to implement value() = 0 ?
+        this->sweepAlone(_pop);
+    }
 
-        } else {
-            eoPop<EOT> pop = _pop;
+    virtual bool subscribe(eoStatSweep<EOT>& _sweep)
+    {
+        _sweep.needQuantile(0.25);
+        _sweep.needQuantile(0.75);
+        return true;
+    }
 
-            unsigned int quartile = pop.size()/4;
-            std::nth_element( pop.begin(), pop.begin()+quartile*1, pop.end() );
-            typename EOT::Fitness Q1 = pop[quartile].fitness();
+    virtual void fromSweep(const eoStatSweep<EOT>& _sweep)
+    {
+        if( _sweep.size() == 0 ) {
+            // how to implement value() = 0 ?
 
-            std::nth_element( pop.begin(), pop.begin()+quartile*3, pop.end() );
-            typename EOT::Fitness Q3 = pop[quartile*3].fitness();
+        } else {
+            double Q1 = _sweep.quantile(0.25).fitness();
+            double Q3 = _sweep.quantile(0.75).fitness();
 
-            value() = Q3 - Q1;
+            // the better quartile has the larger fitness only when maximizing
+            value() = Q3 < Q1 ? Q1 - Q3 : Q3 - Q1;
         }
     }
 
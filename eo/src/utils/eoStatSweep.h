@@ -0,0 +1,278 @@
+// -*- mode: c++; c-indent-level: 4; c++-member-init-indent: 8; comment-column: 35; -*-
+
+//-----------------------------------------------------------------------------
+// eoStatSweep.h
+//-----------------------------------------------------------------------------
+/*
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+Contact: http://eodev.sourceforge.net
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef _eoStatSweep_h
+#define _eoStatSweep_h
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <eoPop.h>
+#include <utils/eoParallel.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+  The statistics on the fitnesses of a population that can be computed
+  together: the moments (sum and sum of squares of the fitnesses), the
+  extremes (best and worst individuals) and the individuals of given ranks
+  (nth best, or quantiles).
+
+  The stats tell what they need (see eoStatBase::subscribe), the
+  population is swept once, then each stat reads its value
+  (see eoStatBase::fromSweep). An eoCheckPoint does so for all its stats,
+  which saves a walk through the population per stat, and the sort of the
+  population when no other sorted stat needs it.
+
+  The moments and the extremes are computed in a single pass, split
+  between the OpenMP threads when eo::parallel is enabled (the sums are
+  then added in the order of the threads, so they may differ from a
+  sequential sum in the last digits). The ranks are found by selection
+  (std::nth_element) on pointers to the individuals, without sorting the
+  population.
+
+  The results refer to the individuals of the population, and are valid
+  until it changes.
+
+  @ingroup Stats
+*/
+template <class EOT>
+class eoStatSweep
+{
+public:
+
+    eoStatSweep() : count(0), moments(false), extremes(false), kernel(&eoStatSweep<EOT>::template sweepChunk<false>) {}
+
+    /// asks for the sum and the sum of squares of the fitnesses, which must convert to a double
+    void needMoments()
+    {
+        moments = true;
+        kernel = &eoStatSweep<EOT>::template sweepChunk<true>;
+    }
+
+    /// asks for the best and the worst individuals
+    void needExtremes() { extremes = true; }
+
+    /// asks for the nth best individual, 0 is the best one
+    void needRank(unsigned _rank) { ranks.push_back(_rank); }
+
+    /// asks for a quantile of the fitnesses, see quantile()
+    void needQuantile(double _q) { quantiles.push_back(_q); }
+
+    /// whether a stat needs anything
+    bool needed() const { return moments || extremes || !ranks.empty() || !quantiles.empty(); }
+
+    /// computes everything that was asked for
+    void operator()(const eoPop<EOT>& _pop)
+    {
+        count = _pop.size();
+
+        if ((moments || extremes) && count > 0)
+            sweep(_pop);
+
+        if (!ranks.empty() || !quantiles.empty())
+            select(_pop);
+    }
+
+    /// size of the population
+    unsigned size() const { return count; }
+
+    double sum() const { return total.sum; }
+
+    double sumOfSquares() const { return total.squares; }
+
+    /// the average of the fitnesses
+    double average() const { return total.sum / count; }
+
+    const EOT& best() const
+    {
+        if (count == 0)
+            throw std::runtime_error("eoStatSweep: empty population, when asking for the best individual");
+        return *bestEO;
+    }
+
+    const EOT& worst() const
+    {
+        if (count == 0)
+            throw std::runtime_error("eoStatSweep: empty population, when asking for the worst individual");
+        return *worstEO;
+    }
+
+    /// the nth best individual, that must have been asked for with needRank
+    const EOT& ranked(unsigned _rank) const
+    {
+        if (_rank >= count)
+            throw std::logic_error("eoStatSweep: rank outside of the population");
+        return *ranking[_rank];
+    }
+
+    /** the individual at the given quantile of the fitnesses, that must have been
+      asked for with needQuantile: 0 is the worst individual, 0.5 the median,
+      and the best individual is at the quantile (size()-1)/size() */
+    const EOT& quantile(double _q) const
+    {
+        return ranked(quantileRank(_q));
+    }
+
+private:
+
+    /// what one thread found
+    struct Partial
+    {
+        Partial() : sum(0), squares(0), best(0), worst(0) {}
+
+        double sum;
+        double squares;
+        size_t best;
+        size_t worst;
+    };
+
+    /** sweeps the individuals [_begin, _end[, a chunk is not empty.
+      Only the kernels that compute the moments convert the fitness to a double,
+      so that the sweep can be used with any fitness when they are not needed */
+    template <bool Moments>
+    static bool sweepChunk(const eoPop<EOT>& _pop, size_t _begin, size_t _end, Partial& _partial)
+    {
+        Partial partial;
+        partial.best = partial.worst = _begin;
+
+        for (size_t i = _begin; i < _end; ++i)
+        {
+            const EOT& eo = _pop[i];
+            if (eo.invalid())
+                return false;
+
+            if (Moments)
+            {
+                double fitness = eo.fitness();
+                partial.sum += fitness;
+                partial.squares += fitness * fitness;
+            }
+
+            // same ties as std::max_element and std::min_element
+            if (_pop[partial.best] < eo)
+                partial.best = i;
+            if (eo < _pop[partial.worst])
+                partial.worst = i;
+        }
+
+        _partial = partial;
+        return true;
+    }
+
+    void sweep(const eoPop<EOT>& _pop)
+    {
+        size_t chunks = 1;
+#ifdef _OPENMP
+        if (eo::parallel.isEnabled())
+            chunks = std::min<size_t>(omp_get_max_threads(), count);
+#endif
+        partials.resize(chunks);
+
+        bool valid = true;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if(chunks > 1) reduction(&&:valid)
+#endif // _OPENMP
+#ifdef _MSC_VER
+        for (long long c = 0; c < (long long)chunks; ++c)
+#else
+        for (size_t c = 0; c < chunks; ++c)
+#endif
+            valid = kernel(_pop, count * c / chunks, count * (c + 1) / chunks, partials[c]) && valid;
+
+        if (!valid)
+            throw std::runtime_error("invalid fitness");
+
+        total = partials[0];
+        for (size_t c = 1; c < chunks; ++c)
+        {
+            total.sum += partials[c].sum;
+            total.squares += partials[c].squares;
+            if (_pop[total.best] < _pop[partials[c].best])
+                total.best = partials[c].best;
+            if (_pop[partials[c].worst] < _pop[total.worst])
+                total.worst = partials[c].worst;
+        }
+
+        bestEO = &_pop[total.best];
+        worstEO = &_pop[total.worst];
+    }
+
+    unsigned quantileRank(double _q) const
+    {
+        unsigned index = static_cast<unsigned>(_q * count); // from the worst
+        if (index >= count)
+            index = count - 1;
+        return count - 1 - index;
+    }
+
+    /// puts the individuals of the ranks asked for at their place in ranking
+    void select(const eoPop<EOT>& _pop)
+    {
+        ranking.resize(count);
+        for (unsigned i = 0; i < count; ++i)
+            ranking[i] = &_pop[i];
+
+        positions.assign(ranks.begin(), ranks.end());
+        if (count > 0)
+            for (unsigned i = 0; i < quantiles.size(); ++i)
+                positions.push_back(quantileRank(quantiles[i]));
+
+        std::sort(positions.begin(), positions.end());
+        positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+
+        // each selection only looks at the individuals after the previous rank
+        unsigned first = 0;
+        for (unsigned i = 0; i < positions.size() && positions[i] < count; ++i)
+        {
+            std::nth_element(ranking.begin() + first, ranking.begin() + positions[i], ranking.end(),
+                             typename eoPop<EOT>::Cmp());
+            first = positions[i] + 1;
+        }
+    }
+
+    typedef bool (*Kernel)(const eoPop<EOT>&, size_t, size_t, Partial&);
+
+    unsigned count;
+
+    bool moments;
+    bool extremes;
+    std::vector<unsigned> ranks;
+    std::vector<double> quantiles;
+
+    Kernel kernel;
+    std::vector<Partial> partials;
+    Partial total;
+    const EOT* bestEO;
+    const EOT* worstEO;
+
+    std::vector<unsigned> positions;
+    std::vector<const EOT*> ranking;
+};
+
+#endif
@@ -6,16 +6,142 @@
 #include <config.h>
 #endif
 
+#include <stdint.h>
 #include <algorithm>
+#include <cstdio>
 #include <fstream>
 #include <sstream>
 
+#ifdef WITH_PTHREAD
+#include <pthread.h>
+#endif
+
 #include "eoState.h"
 #include "eoObject.h"
 #include "eoPersistent.h"
+#include "eoLogger.h"
 
 using namespace std;
 
+namespace
+{
+    // first bytes of the binary files, not printable so as not to be mistaken for text
+    const char binaryMagic[8] = { '\211', 'E', 'O', 'S', 'T', 'A', 'T', 'E' };
+    const uint32_t binaryVersion = 1;
+    // written in the native byte order, to detect files coming from another kind of machine
+    const uint32_t byteOrderMark = 0x01020304;
+
+    template <class T>
+    void writeRaw(string& block, const T& value)
+    {
+        block.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <class T>
+    void readRaw(istream& is, T& value)
+    {
+        if (!is.read(reinterpret_cast<char*>(&value), sizeof(T)))
+            throw eoState::loading_error("Truncated header in binary state");
+    }
+}
+
+/**
+ * Writes the snapshots of an eoState in the background, one at a time.
+ */
+class eoStateWriter
+{
+public :
+
+    eoStateWriter() : running(false) {}
+
+    ~eoStateWriter()
+    {
+        join();
+        if (!error.empty())
+            eo::log << eo::warnings << error << std::endl;
+    }
+
+    /** Waits for the previous file, then writes the blocks (which are taken, not copied) into the file */
+    void write(const string& _filename, vector<string>& _blocks)
+    {
+        wait();
+        filename = _filename;
+        blocks.swap(_blocks);
+#ifdef WITH_PTHREAD
+        if (pthread_create(&thread, 0, &eoStateWriter::run, this) == 0)
+        {
+            running = true;
+            return;
+        }
+#endif
+        flush();
+        wait();
+    }
+
+    /** Waits for the current file, and throws if it could not be written */
+    void wait(void)
+    {
+        join();
+        if (!error.empty())
+        {
+            string msg;
+            msg.swap(error);
+            throw runtime_error(msg);
+        }
+    }
+
+private :
+
+    static void* run(void* _writer)
+    {
+        static_cast<eoStateWriter*>(_writer)->flush();
+        return 0;
+    }
+
+    void join(void)
+    {
+#ifdef WITH_PTHREAD
+        if (running)
+        {
+            pthread_join(thread, 0);
+            running = false;
+        }
+#endif
+    }
+
+    /** writes a temporary file, renamed when complete, so that the file is never seen half written */
+    void flush(void)
+    {
+        string tmp = filename + ".tmp";
+        {
+            ofstream os(tmp.c_str(), ios::out | ios::binary);
+            for (unsigned i = 0; os && i < blocks.size(); ++i)
+                os.write(blocks[i].data(), blocks[i].size());
+            if (!os)
+            {
+                error = "Could not write file: " + tmp;
+                blocks.clear();
+                return;
+            }
+        }
+        blocks.clear();
+
+#ifdef _WIN32
+        std::remove(filename.c_str()); // rename does not overwrite there, elsewhere it replaces the file atomically
+#endif
+        if (std::rename(tmp.c_str(), filename.c_str()) != 0)
+            error = "Could not rename " + tmp + " into " + filename;
+    }
+
+    string filename;
+    vector<string> blocks;
+    string error;
+    bool running;
+#ifdef WITH_PTHREAD
+    pthread_t thread;
+#endif
+};
+
 
 
 void eoState::removeComment(string& str, string comment)
@@ -51,6 +177,8 @@ bool eoState::is_section(const string& str, string& name)
 
 eoState::~eoState(void)
 {
+    delete _writer;
+
     for (unsigned i = 0; i < ownedObjects.size(); ++i)
     {
         delete ownedObjects[i];
@@ -75,7 +203,7 @@ void eoState::registerObject(eoPersistent& registrant)
 
 void eoState::load(const string& _filename)
 {
-    ifstream is (_filename.c_str());
+    ifstream is (_filename.c_str(), ios::in | ios::binary);
 
     if (!is)
     {
@@ -83,12 +211,27 @@ void eoState::load(const string& _filename)
         throw runtime_error(str);
     }
 
-    load(is);
+    if (is.peek() == static_cast<unsigned char>(binaryMagic[0]))
+    {
+        loadBinary(is);
+        return;
+    }
+
+    // text, read again without the binary mode
+    is.close();
+    ifstream text(_filename.c_str());
+    load(text);
 }
 
 // FIXME implement parsing and loading of other formats
 void eoState::load(std::istream& is)
 {
+    if (is.peek() == static_cast<unsigned char>(binaryMagic[0]))
+    {
+        loadBinary(is);
+        return;
+    }
+
     string str;
     string name;
 
@@ -148,9 +291,112 @@ void eoState::load(std::istream& is)
 
 }
 
+void eoState::loadBinary(std::istream& is)
+{
+    char magic[sizeof(binaryMagic)];
+    if (!is.read(magic, sizeof(magic)) || !equal(magic, magic + sizeof(magic), binaryMagic))
+        throw loading_error("Not a binary state");
+
+    uint32_t version, mark, nameSize, nbSections;
+    readRaw(is, version);
+    readRaw(is, mark);
+    if (version != binaryVersion || mark != byteOrderMark)
+        throw loading_error("Binary state written by another version of EO or on another kind of machine");
+
+    readRaw(is, nameSize);
+    is.ignore(nameSize); // name of the state
+    readRaw(is, nbSections);
+
+    // the table of the sections, which follow it in the order of their offsets
+    vector<string> names(nbSections);
+    vector<uint64_t> offsets(nbSections), sizes(nbSections);
+    for (unsigned i = 0; i < nbSections; ++i)
+    {
+        readRaw(is, nameSize);
+        names[i].resize(nameSize);
+        if (nameSize > 0 && !is.read(&names[i][0], nameSize))
+            throw loading_error("Truncated header in binary state");
+        readRaw(is, offsets[i]);
+        readRaw(is, sizes[i]);
+    }
+
+    // only the sections of the registered objects are read, the others are skipped
+    uint64_t position = nbSections > 0 ? offsets[0] : 0;
+    string block;
+    for (unsigned i = 0; i < nbSections; ++i)
+    {
+        ObjectMap::iterator it = objectMap.find(names[i]);
+        if (it == objectMap.end())
+            continue;
+
+        if (offsets[i] > position)
+            is.ignore(offsets[i] - position);
+
+        block.resize(sizes[i]);
+        if (sizes[i] > 0 && !is.read(&block[0], sizes[i]))
+            throw loading_error("Truncated section " + names[i] + " in binary state");
+        position = offsets[i] + sizes[i];
+
+        istringstream the_stream(block, ios::in | ios::binary);
+        it->second->readBinaryFrom(the_stream);
+    }
+}
+
+void eoState::binarySnapshot(vector<string>& blocks) const
+{
+    // the sections first, to know their offsets
+    blocks.resize(creationOrder.size() + 1);
+    for (unsigned i = 0; i < creationOrder.size(); ++i)
+    {
+        ostringstream os(ios::out | ios::binary);
+        creationOrder[i]->second->printBinaryOn(os);
+        blocks[i + 1] = os.str();
+    }
+
+    string& header = blocks[0];
+    header.assign(binaryMagic, sizeof(binaryMagic));
+    writeRaw(header, binaryVersion);
+    writeRaw(header, byteOrderMark);
+    writeRaw(header, uint32_t(_tag_state_name.size()));
+    header += _tag_state_name;
+    writeRaw(header, uint32_t(creationOrder.size()));
+
+    uint64_t offset = header.size();
+    for (unsigned i = 0; i < creationOrder.size(); ++i)
+        offset += sizeof(uint32_t) + creationOrder[i]->first.size() + 2 * sizeof(uint64_t);
+
+    for (unsigned i = 0; i < creationOrder.size(); ++i)
+    {
+        const string& name = creationOrder[i]->first;
+        writeRaw(header, uint32_t(name.size()));
+        header += name;
+        writeRaw(header, offset);
+        writeRaw(header, uint64_t(blocks[i + 1].size()));
+        offset += blocks[i + 1].size();
+    }
+}
+
+void eoState::wait(void) const
+{
+    if (_writer)
+        _writer->wait();
+}
+
 void eoState::save(const string& filename) const
 { // saves in order of insertion
-    ofstream os(filename.c_str());
+    if (_binary && _asynchronous)
+    {
+        vector<string> blocks;
+        binarySnapshot(blocks);
+        if (!_writer)
+            _writer = new eoStateWriter;
+        _writer->write(filename, blocks);
+        return;
+    }
+
+    wait(); // the file may be the one being written in the background
+
+    ofstream os(filename.c_str(), _binary ? ios::out | ios::binary : ios::out);
 
     if (!os)
     {
@@ -185,6 +431,15 @@ void eoState::saveSection( std::ostream& os, vector<ObjectMap::iterator>::const_
 
 void eoState::save(std::ostream& os) const
 {
+    if (_binary)
+    {
+        vector<string> blocks;
+        binarySnapshot(blocks);
+        for (unsigned i = 0; i < blocks.size(); ++i)
+            os.write(blocks[i].data(), blocks[i].size());
+        return;
+    }
+
     os << _tag_state_so << _tag_state_name << _tag_state_sc;
    
     // save the first section
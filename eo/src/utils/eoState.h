@@ -37,6 +37,7 @@
 
 class eoObject;
 class eoPersistent;
+class eoStateWriter;
 
 /**
  eoState can be used to register derivants of eoPersistent. It will
@@ -58,6 +59,9 @@ class eoState : public eoFunctorStore
 public :
 
     eoState(std::string name="") :
+      _binary(false),
+      _asynchronous(false),
+      _writer(0),
       _tag_state_so(""),
       _tag_state_name(name),
       _tag_state_sc(""),
@@ -74,6 +78,7 @@ public :
 
     void formatLatex(std::string name)
     {
+        _binary = false;
         _tag_state_so = "";
         _tag_state_name = name;
         _tag_state_sc = "";
@@ -88,6 +93,7 @@ public :
 
     void formatJSON(std::string name)
     {
+        _binary = false;
         _tag_state_so = "{ \"";
         _tag_state_name = name;
         _tag_state_sc = "\":\n";
@@ -100,6 +106,36 @@ public :
         _tag_state_e = "}\n";
     }
 
+    /**
+    * Saves in binary: a header holding the offsets of the sections, followed
+    * by the sections written by eoPersistent::printBinaryOn, in which the
+    * populations of plain vectors are raw blocks of fitnesses and genes.
+    * The files are only meant to be read back on the same kind of machine.
+    * load detects the format by itself.
+    * Each file is a complete snapshot, not a delta from the previous one:
+    * any saved file can be loaded on its own.
+    */
+    void formatBinary(std::string name = "")
+    {
+        _binary = true;
+        _tag_state_name = name;
+    }
+
+    /**
+    * When set, saving into a file only takes a snapshot of the objects,
+    * which is written by a background thread while the algorithm goes on.
+    * The file appears (through a rename) only once it is complete, and the
+    * next save waits for the previous one to be written.
+    * Without thread support (WITH_PTHREAD), files are written right away.
+    */
+    void asynchronous(bool _async = true) { _asynchronous = _async; }
+
+    /**
+    * Waits for the file being written in the background, if any.
+    * Throws if the previous asynchronous save failed.
+    */
+    void wait(void) const;
+
 
     /**
     * Object registration function, note that it does not take ownership!
@@ -160,6 +196,12 @@ public :
 private :
     std::string createObjectName(eoObject* obj);
 
+    bool _binary;
+    bool _asynchronous;
+
+    // the background writer, created by the first asynchronous save
+    mutable eoStateWriter* _writer;
+
     // first is Persistent, second is the raw data associated with it.
     typedef std::map<std::string, eoPersistent*> ObjectMap;
 
@@ -206,6 +248,11 @@ private :
 
     bool is_section(const std::string& str, std::string& name);
 
+    /* binary format: the header and the sections, as successive blocks of bytes */
+    void binarySnapshot(std::vector<std::string>& blocks) const;
+
+    void loadBinary(std::istream& is);
+
 protected:
     void saveSection( std::ostream& os, std::vector<ObjectMap::iterator>::const_iterator it) const;
 
@@ -21,6 +21,7 @@
 #include <stdio.h>
 #include <signal.h>
 #include <unistd.h>
+#include <fcntl.h>
 
 #include "pipecom.h"
 
@@ -78,20 +79,34 @@ PCom * PipeComOpenArgv( char *prog, char *argv[] )
         /* --- replace old stdin --- */
         if( dup2( toFils[0], fileno(stdin) ) < 0 ) {
             perror( "PipeComOpen(son): could not connect" );
-            exit( -1 );
+            _exit( -1 );
             /* --- AVOIR: kill my father --- */
         }
         if( dup2( toPere[1], fileno(stdout) ) < 0 ) {
             perror( "PipeComOpen(son): could not connect" );
-            exit( -1 );
+            _exit( -1 );
         }
+        if( toFils[0] != fileno(stdin) )
+            close( toFils[0] );
+        if( toPere[1] != fileno(stdout) )
+            close( toPere[1] );
+        close( toFils[1] );
+        close( toPere[0] );
         if( execvp( prog, argv ) < 0 ) {
             perror( prog );
             perror( "PipeComOpen: can't exec" );
-            exit(1);
+            _exit(1);
         }
         break;
     default:
+        /* --- the father keeps its ends only, and does not give them to
+           the other sons: a son sees the end of its input when the
+           father closes it, and the father when the son dies --- */
+        close( toFils[0] );
+        close( toPere[1] );
+        fcntl( toFils[1], F_SETFD, FD_CLOEXEC );
+        fcntl( toPere[0], F_SETFD, FD_CLOEXEC );
+
         ret = (PCom *) malloc( sizeof(PCom) );
         if( ! ret )
             return NULL;
@@ -5,13 +5,13 @@
     A bunch of useful selector functions. They generally have three forms:
 
     template <class It>
-    It select(It begin, It end, params, eoRng& gen = rng);
+    It select(It begin, It end, params, eoRng& gen = eo::threadRng());
 
     template <class EOT>
-    const EOT& select(const eoPop<EOT>& pop, params, eoRng& gen = rng);
+    const EOT& select(const eoPop<EOT>& pop, params, eoRng& gen = eo::threadRng());
 
     template <class EOT>
-    EOT& select(eoPop<EOT>& pop, params, eoRng& gen = rng);
+    EOT& select(eoPop<EOT>& pop, params, eoRng& gen = eo::threadRng());
 
     where select is one of: roulette_wheel, deterministic_tournament
     and stochastic_tournament (at the moment).
@@ -141,7 +141,7 @@ double sum_fitness(const eoPop<EOT>& _pop, std::pair<double, double>& _minmax)
 }
 
 template <class It>
-It roulette_wheel(It _begin, It _end, double total, eoRng& _gen = rng)
+It roulette_wheel(It _begin, It _end, double total, eoRng& _gen = eo::threadRng())
 {
 
     double roulette = _gen.uniform(total);
@@ -160,7 +160,7 @@ It roulette_wheel(It _begin, It _end, double total, eoRng& _gen = rng)
 }
 
 template <class EOT>
-const EOT& roulette_wheel(const eoPop<EOT>& _pop, double total, eoRng& _gen = rng)
+const EOT& roulette_wheel(const eoPop<EOT>& _pop, double total, eoRng& _gen = eo::threadRng())
 {
     double roulette = _gen.uniform(total);
 
@@ -178,7 +178,7 @@ const EOT& roulette_wheel(const eoPop<EOT>& _pop, double total, eoRng& _gen = rn
 }
 
 template <class EOT>
-EOT& roulette_wheel(eoPop<EOT>& _pop, double total, eoRng& _gen = rng)
+EOT& roulette_wheel(eoPop<EOT>& _pop, double total, eoRng& _gen = eo::threadRng())
 {
     float roulette = _gen.uniform(total);
 
@@ -196,7 +196,7 @@ EOT& roulette_wheel(eoPop<EOT>& _pop, double total, eoRng& _gen = rng)
 }
 
 template <class It>
-It deterministic_tournament(It _begin, It _end, unsigned _t_size, eoRng& _gen = rng)
+It deterministic_tournament(It _begin, It _end, unsigned _t_size, eoRng& _gen = eo::threadRng())
 {
     It best = _begin + _gen.random(_end - _begin);
 
@@ -214,19 +214,19 @@ It deterministic_tournament(It _begin, It _end, unsigned _t_size, eoRng& _gen =
 }
 
 template <class EOT>
-const EOT& deterministic_tournament(const eoPop<EOT>& _pop, unsigned _t_size, eoRng& _gen = rng)
+const EOT& deterministic_tournament(const eoPop<EOT>& _pop, unsigned _t_size, eoRng& _gen = eo::threadRng())
 {
     return *deterministic_tournament(_pop.begin(), _pop.end(), _t_size, _gen);
 }
 
 template <class EOT>
-EOT& deterministic_tournament(eoPop<EOT>& _pop, unsigned _t_size, eoRng& _gen = rng)
+EOT& deterministic_tournament(eoPop<EOT>& _pop, unsigned _t_size, eoRng& _gen = eo::threadRng())
 {
     return *deterministic_tournament(_pop.begin(), _pop.end(), _t_size, _gen);
 }
 
 template <class It>
-It inverse_deterministic_tournament(It _begin, It _end, unsigned _t_size, eoRng& _gen = rng)
+It inverse_deterministic_tournament(It _begin, It _end, unsigned _t_size, eoRng& _gen = eo::threadRng())
 {
     It worst = _begin + _gen.random(_end - _begin);
 
@@ -250,19 +250,19 @@ It inverse_deterministic_tournament(It _begin, It _end, unsigned _t_size, eoRng&
 }
 
 template <class EOT>
-const EOT& inverse_deterministic_tournament(const eoPop<EOT>& _pop, unsigned _t_size, eoRng& _gen = rng)
+const EOT& inverse_deterministic_tournament(const eoPop<EOT>& _pop, unsigned _t_size, eoRng& _gen = eo::threadRng())
 {
     return *inverse_deterministic_tournament<EOT>(_pop.begin(), _pop.end(), _t_size, _gen);
 }
 
 template <class EOT>
-EOT& inverse_deterministic_tournament(eoPop<EOT>& _pop, unsigned _t_size, eoRng& _gen = rng)
+EOT& inverse_deterministic_tournament(eoPop<EOT>& _pop, unsigned _t_size, eoRng& _gen = eo::threadRng())
 {
     return *inverse_deterministic_tournament(_pop.begin(), _pop.end(), _t_size, _gen);
 }
 
 template <class It>
-It stochastic_tournament(It _begin, It _end, double _t_rate, eoRng& _gen = rng)
+It stochastic_tournament(It _begin, It _end, double _t_rate, eoRng& _gen = eo::threadRng())
 {
   It i1 = _begin + _gen.random(_end - _begin);
   It i2 = _begin + _gen.random(_end - _begin);
@@ -287,19 +287,19 @@ It stochastic_tournament(It _begin, It _end, double _t_rate, eoRng& _gen = rng)
 }
 
 template <class EOT>
-const EOT& stochastic_tournament(const eoPop<EOT>& _pop, double _t_rate, eoRng& _gen = rng)
+const EOT& stochastic_tournament(const eoPop<EOT>& _pop, double _t_rate, eoRng& _gen = eo::threadRng())
 {
     return *stochastic_tournament(_pop.begin(), _pop.end(), _t_rate, _gen);
 }
 
 template <class EOT>
-EOT& stochastic_tournament(eoPop<EOT>& _pop, double _t_rate, eoRng& _gen = rng)
+EOT& stochastic_tournament(eoPop<EOT>& _pop, double _t_rate, eoRng& _gen = eo::threadRng())
 {
     return *stochastic_tournament(_pop.begin(), _pop.end(), _t_rate, _gen);
 }
 
 template <class It>
-It inverse_stochastic_tournament(It _begin, It _end, double _t_rate, eoRng& _gen = rng)
+It inverse_stochastic_tournament(It _begin, It _end, double _t_rate, eoRng& _gen = eo::threadRng())
 {
   It i1 = _begin + _gen.random(_end - _begin);
   It i2 = _begin + _gen.random(_end - _begin);
@@ -324,13 +324,13 @@ It inverse_stochastic_tournament(It _begin, It _end, double _t_rate, eoRng& _gen
 }
 
 template <class EOT>
-const EOT& inverse_stochastic_tournament(const eoPop<EOT>& _pop, double _t_rate, eoRng& _gen = rng)
+const EOT& inverse_stochastic_tournament(const eoPop<EOT>& _pop, double _t_rate, eoRng& _gen = eo::threadRng())
 {
     return *inverse_stochastic_tournament(_pop.begin(), _pop.end(), _t_rate, _gen);
 }
 
 template <class EOT>
-EOT& inverse_stochastic_tournament(eoPop<EOT>& _pop, double _t_rate, eoRng& _gen = rng)
+EOT& inverse_stochastic_tournament(eoPop<EOT>& _pop, double _t_rate, eoRng& _gen = eo::threadRng())
 {
     return *inverse_stochastic_tournament(_pop.begin(), _pop.end(), _t_rate, _gen);
 }
@@ -0,0 +1,198 @@
+/*
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation;
+    version 2 of the License.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+Contact: http://eodev.sourceforge.net
+*/
+
+/*
+ * This file shows an asynchronous steady-state algorithm, where the children are evaluated by the workers and
+ * inserted in the population as soon as they come back. The evaluation time depends on the worker (the first worker
+ * is ten times slower than the others), which would stall a generational algorithm at each generation.
+ */
+//-----------------------------------------------------------------------------
+
+#include <unistd.h>
+
+#include <eo>
+#include <es.h>
+#include "../real_value.h"
+
+#include <mpi/eoMpi.h>
+#include <mpi/eoAsyncSteadyState.h>
+
+#include <vector>
+using namespace std;
+
+//-----------------------------------------------------------------------------
+
+typedef eoReal< eoMinimizingFitness > EOT;
+
+/*
+ * Sphere function, whose evaluation time depends on the worker.
+ */
+class SlowEval : public eoEvalFunc< EOT >
+{
+    public:
+
+    void operator()( EOT & _eo )
+    {
+        if( _eo.invalid() )
+        {
+            usleep( eo::mpi::Node::comm().rank() == 1 ? 10000 : 1000 );
+            _eo.fitness( real_value( _eo ) );
+        }
+    }
+};
+
+/*
+ * Replacement which counts the inserted children in the evaluation counter of the master, so that an
+ * eoEvalContinue can stop the algorithm after a budget of evaluations.
+ */
+class CountingReplacement : public eoReplacement< EOT >
+{
+    public:
+
+    CountingReplacement( eoReplacement< EOT >& _replace, eoEvalFuncCounter< EOT >& _counter ) :
+        replace( _replace ), counter( _counter )
+    {
+        // empty
+    }
+
+    void operator()( eoPop< EOT >& _parents, eoPop< EOT >& _offspring )
+    {
+        counter.value() += _offspring.size();
+        replace( _parents, _offspring );
+    }
+
+    protected:
+    eoReplacement< EOT >& replace;
+    eoEvalFuncCounter< EOT >& counter;
+};
+
+const int BudgetTag = 42;
+
+int main(int ac, char** av)
+{
+    eo::mpi::Node::init( ac, av );
+    eo::log << eo::setlevel( eo::quiet );
+
+    eoParser parser(ac, av);
+
+    unsigned int popSize = parser.getORcreateParam((unsigned int)20, "popSize", "Population Size", 'P', "Evolution Engine").value();
+    unsigned int dimSize = parser.getORcreateParam((unsigned int)10, "dimSize", "Dimension Size", 'd', "Evolution Engine").value();
+    unsigned int maxEvals = parser.getORcreateParam((unsigned int)500, "maxEvals", "Number of children inserted", 'E', "Evolution Engine").value();
+
+    make_parallel(parser);
+    make_help(parser);
+
+    rng.reseed( 42 );
+
+    eoUniformGenerator< double > gen(-5, 5);
+    eoInitFixedLength< EOT > init( dimSize, gen );
+
+    SlowEval eval;
+
+    eoDetTournamentSelect< EOT > select( 2 );
+    eoSegmentCrossover< EOT > xover;
+    eoUniformMutation< EOT > mutation( 0.1 );
+    eoSequentialOp< EOT > op;
+    op.add( xover, 0.7 );
+    op.add( mutation, 1.0 );
+
+    eoSSGAWorseReplacement< EOT > replace;
+    eoGenContinue< EOT > continuator( maxEvals );
+
+    eo::mpi::DynamicAssignmentAlgorithm assign;
+    eoAsyncSteadyStateEA< EOT > algo( assign, eo::mpi::DEFAULT_MASTER, select, op, eval, replace, continuator );
+
+    int rank = eo::mpi::Node::comm().rank();
+    if( rank == eo::mpi::DEFAULT_MASTER )
+    {
+        eoPop< EOT > pop( popSize, init );
+        for( unsigned i = 0; i < pop.size(); ++i )
+        {
+            pop[i].fitness( real_value( pop[i] ) );
+        }
+        eoMinimizingFitness initialBest = pop.best_element().fitness();
+
+        algo( pop );
+
+        eo::log << eo::quiet << "Inserted " << algo.inserted() << " children, best fitness from " << initialBest
+            << " to " << pop.best_element().fitness() << std::endl;
+
+        if( pop.size() != popSize || algo.inserted() < maxEvals )
+        {
+            eo::log << eo::quiet << "Wrong number of individuals." << std::endl;
+            return 1;
+        }
+
+        if( ! ( pop.best_element().fitness() > initialBest ) )
+        {
+            eo::log << eo::quiet << "No improvement." << std::endl;
+            return 1;
+        }
+    } else
+    {
+        eoPop< EOT > pop; // not used by workers
+        algo( pop );
+    }
+
+    /*
+     * Second run, stopped by a budget of evaluations: the workers count the children they evaluate, and no child may
+     * be sent once the budget is reached. Only the children in flight at that time can exceed it.
+     */
+    eoEvalFuncCounter< EOT > counter( eval );
+    CountingReplacement countingReplace( replace, counter );
+    eoEvalContinue< EOT > budget( counter, maxEvals );
+    eo::mpi::DynamicAssignmentAlgorithm budgetAssign;
+    eoAsyncSteadyStateEA< EOT > budgetAlgo( budgetAssign, eo::mpi::DEFAULT_MASTER, select, op, counter, countingReplace, budget );
+
+    if( rank == eo::mpi::DEFAULT_MASTER )
+    {
+        eoPop< EOT > pop( popSize, init );
+        for( unsigned i = 0; i < pop.size(); ++i )
+        {
+            pop[i].fitness( real_value( pop[i] ) );
+        }
+
+        budgetAlgo( pop );
+
+        unsigned long evaluations = 0;
+        int size = eo::mpi::Node::comm().size();
+        for( int wrk = 1; wrk < size; ++wrk )
+        {
+            int n;
+            eo::mpi::Node::comm().recv( wrk, BudgetTag, n );
+            evaluations += n;
+        }
+
+        eo::log << eo::quiet << "Budget of " << maxEvals << " evaluations, " << evaluations << " done by the workers, "
+            << budgetAlgo.inserted() << " children inserted" << std::endl;
+
+        if( evaluations != budgetAlgo.inserted() || evaluations > maxEvals + size - 2 )
+        {
+            eo::log << eo::quiet << "Budget of evaluations exceeded." << std::endl;
+            return 1;
+        }
+    } else
+    {
+        eoPop< EOT > pop; // not used by workers
+        budgetAlgo( pop );
+        eo::mpi::Node::comm().send( eo::mpi::DEFAULT_MASTER, BudgetTag, (int) counter.value() );
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
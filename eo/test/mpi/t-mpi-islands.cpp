@@ -0,0 +1,118 @@
+/*
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation;
+    version 2 of the License.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+Contact: http://eodev.sourceforge.net
+*/
+
+/*
+ * This file shows an island model: each MPI rank runs its own eoEasyEA on the sphere function, and the islands send
+ * their best individuals to their neighbours every few generations. The islands run a different number of
+ * generations, so that some of them finish while their neighbours are still sending emigrants.
+ */
+//-----------------------------------------------------------------------------
+
+#include <eo>
+#include <es.h>
+#include "../real_value.h"
+
+#include <mpi/eoMpi.h>
+#include <mpi/eoIslandsEasyEA.h>
+
+#include <vector>
+using namespace std;
+
+//-----------------------------------------------------------------------------
+
+typedef eoReal< eoMinimizingFitness > EOT;
+
+bool sameNeighbours( std::vector<int> found, int* expected, unsigned size )
+{
+    std::sort( found.begin(), found.end() );
+    return found == std::vector<int>( expected, expected + size );
+}
+
+int main(int ac, char** av)
+{
+    eo::mpi::Node::init( ac, av );
+    eo::log << eo::setlevel( eo::quiet );
+
+    eoParser parser(ac, av);
+
+    unsigned int popSize = parser.getORcreateParam((unsigned int)20, "popSize", "Population Size", 'P', "Evolution Engine").value();
+    unsigned int dimSize = parser.getORcreateParam((unsigned int)10, "dimSize", "Dimension Size", 'd', "Evolution Engine").value();
+    unsigned int maxGen = parser.getORcreateParam((unsigned int)50, "maxGen", "Number of generations of the first island", 'G', "Evolution Engine").value();
+
+    make_parallel(parser);
+    make_help(parser);
+
+    int rank = eo::mpi::Node::comm().rank();
+
+    // topologies
+    eo::mpi::RingIslandTopology ring;
+    eo::mpi::TorusIslandTopology torus( 3 );
+    eo::mpi::RandomIslandTopology random( 2 );
+    int ringOf5[] = { 0 };
+    int torusOf6[] = { 1, 2, 3 };
+    int torusOf7[] = { 1, 3, 5 };
+    int lastOfTorusOf7[] = { 0, 3 };
+    if( ! sameNeighbours( ring( 4, 5 ), ringOf5, 1 )
+            || ! sameNeighbours( torus( 0, 6 ), torusOf6, 3 )
+            || ! sameNeighbours( torus( 4, 7 ), torusOf7, 3 )
+            || ! sameNeighbours( torus( 6, 7 ), lastOfTorusOf7, 2 )
+            || random( 2, 5 ).size() != 2 )
+    {
+        eo::log << eo::quiet << "Wrong topology." << std::endl;
+        return 1;
+    }
+
+    rng.reseed( 42 + rank );
+
+    eoUniformGenerator< double > gen(-5, 5);
+    eoInitFixedLength< EOT > init( dimSize, gen );
+
+    eoEvalFuncPtr< EOT, double, const std::vector< double >& > eval( real_value );
+
+    eoDetTournamentSelect< EOT > select( 2 );
+    eoSegmentCrossover< EOT > xover;
+    eoUniformMutation< EOT > mutation( 0.1 );
+    eoSequentialOp< EOT > op;
+    op.add( xover, 0.7 );
+    op.add( mutation, 1.0 );
+    eoGeneralBreeder< EOT > breed( select, op );
+
+    eoPlusReplacement< EOT > replace;
+    eoGenContinue< EOT > continuator( maxGen + 10 * rank );
+
+    eoEasyEA< EOT > ea( continuator, eval, breed, replace );
+    eoIslandsEasyEA< EOT > islands( ea, ring, 2, 3 );
+
+    eoPop< EOT > pop( popSize, init );
+    apply< EOT >( eval, pop );
+    eoMinimizingFitness initialBest = pop.best_element().fitness();
+
+    islands( pop );
+
+    eo::log << eo::quiet << "Island " << rank << ": best fitness from " << initialBest << " to "
+        << pop.best_element().fitness() << std::endl;
+
+    if( pop.size() != popSize || ! ( pop.best_element().fitness() > initialBest ) )
+    {
+        eo::log << eo::quiet << "Island " << rank << " did not evolve." << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,159 @@
+/*
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation;
+    version 2 of the License.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+Contact: http://eodev.sourceforge.net
+*/
+
+/*
+ * Sends tables of individuals back and forth between two processes: eoReal individuals go in binary, while
+ * eoEsStdev individuals, which derive from eoVector but also carry their standard deviations, must go through JSON
+ * without losing them.
+ *
+ * Needs at least 2 processes (mpirun -np 2 t-mpi-wireFormat).
+ */
+
+# include <mpi/eoMpi.h>
+# include <es.h>
+# include <es/eoEsStdev.h>
+
+# include <iostream>
+# include <vector>
+
+using namespace std;
+using namespace eo::mpi;
+
+class eoEsStdevSerializable : public eoEsStdev< eoMinimizingFitness >, public eoserial::Persistent
+{
+    public:
+
+        eoserial::Object* pack() const
+        {
+            eoserial::Object* obj = new eoserial::Object;
+            obj->add( "genes", eoserial::makeArray< vector<double>, eoserial::MakeAlgorithm >( *this ) );
+            obj->add( "stdevs", eoserial::makeArray< vector<double>, eoserial::MakeAlgorithm >( stdevs ) );
+
+            bool invalidFitness = invalid();
+            obj->add( "invalid", eoserial::make( invalidFitness ) );
+            if( !invalidFitness )
+            {
+                double fitnessVal = fitness();
+                obj->add( "fitness", eoserial::make( fitnessVal ) );
+            }
+            return obj;
+        }
+
+        void unpack( const eoserial::Object* obj )
+        {
+            this->clear();
+            eoserial::unpackArray< vector<double>, eoserial::Array::UnpackAlgorithm >( *obj, "genes", *this );
+            stdevs.clear();
+            eoserial::unpackArray< vector<double>, eoserial::Array::UnpackAlgorithm >( *obj, "stdevs", stdevs );
+
+            bool invalidFitness;
+            eoserial::unpack( *obj, "invalid", invalidFitness );
+            if( invalidFitness )
+            {
+                invalidate();
+            } else
+            {
+                double fitnessVal;
+                eoserial::unpack<double>( *obj, "fitness", fitnessVal );
+                fitness( fitnessVal );
+            }
+        }
+};
+
+typedef eoReal< eoMinimizingFitness > Real;
+typedef eoEsStdevSerializable Stdev;
+
+template< class EOT >
+bool same( const vector< EOT >& a, const vector< EOT >& b )
+{
+    for( unsigned i = 0; i < a.size(); ++i )
+    {
+        if( static_cast< const vector<double>& >( a[i] ) != static_cast< const vector<double>& >( b[i] )
+            || a[i].invalid() != b[i].invalid() || ( !a[i].invalid() && a[i].fitness() != b[i].fitness() ) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool sameStdevs( const vector< Stdev >& a, const vector< Stdev >& b )
+{
+    for( unsigned i = 0; i < a.size(); ++i )
+    {
+        if( a[i].stdevs != b[i].stdevs )
+        {
+            return false;
+        }
+    }
+    return same( a, b );
+}
+
+int main(int argc, char** argv)
+{
+    Node::init( argc, argv );
+    mpi::communicator& comm = Node::comm();
+
+    if( comm.size() < 2 )
+    {
+        cout << "t-mpi-wireFormat needs at least 2 processes, nothing tested" << endl;
+        return 0;
+    }
+
+    const int size = 10;
+    vector< Real > reals( size ), realsBack( size );
+    vector< Stdev > stdevs( size ), stdevsBack( size );
+    for( int i = 0; i < size; ++i )
+    {
+        reals[i].resize( i + 1, 0.5 * i );
+        stdevs[i].resize( i + 1, 0.25 * i );
+        stdevs[i].stdevs.assign( i + 1, 1.0 + i );
+        if( i % 3 != 0 )
+        {
+            reals[i].fitness( i );
+            stdevs[i].fitness( -i );
+        }
+    }
+
+    int result = 0;
+    if( comm.rank() == 0 )
+    {
+        comm.send( 1, 0, &reals[0], size );
+        comm.send( 1, 1, &stdevs[0], size );
+        comm.recv( 1, 0, &realsBack[0], size );
+        comm.recv( 1, 1, &stdevsBack[0], size );
+
+        if( !same( reals, realsBack ) )
+        {
+            cerr << "eoReal individuals changed on the way" << endl;
+            result = 1;
+        }
+        if( !sameStdevs( stdevs, stdevsBack ) )
+        {
+            cerr << "eoEsStdev individuals changed on the way, or lost their standard deviations" << endl;
+            result = 1;
+        }
+    } else if( comm.rank() == 1 )
+    {
+        comm.recv( 0, 0, &realsBack[0], size );
+        comm.recv( 0, 1, &stdevsBack[0], size );
+        comm.send( 0, 0, &realsBack[0], size );
+        comm.send( 0, 1, &stdevsBack[0], size );
+    }
+
+    return result;
+}
@@ -0,0 +1,121 @@
+//-----------------------------------------------------------------------------
+// t-eoBinaryState.cpp
+//-----------------------------------------------------------------------------
+
+// Saves a state holding a population of real vectors and the random number
+// generator in binary, synchronously and in the background, loads it back
+// into another state and compares, and compares the times taken by the text
+// and binary checkpoints.
+//
+// Usage: t-eoBinaryState --popSize=100000 --dimension=10
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+#include <eo>
+#include <es.h>
+
+using namespace std;
+
+typedef eoReal<eoMinimizingFitness> Indi;
+
+bool samePop(const eoPop<Indi>& _a, const eoPop<Indi>& _b)
+{
+    if (_a.size() != _b.size())
+        return false;
+    for (unsigned i = 0; i < _a.size(); ++i)
+    {
+        if (_a[i].invalid() != _b[i].invalid()
+            || static_cast<const vector<double>&>(_a[i]) != static_cast<const vector<double>&>(_b[i]))
+            return false;
+        if (!_a[i].invalid() && _a[i].fitness() != _b[i].fitness())
+            return false;
+    }
+    return true;
+}
+
+bool reload(const string& _file, const eoPop<Indi>& _pop)
+{
+    eoPop<Indi> pop;
+    eoState state;
+    state.registerObject(pop);
+    state.load(_file);
+
+    if (!samePop(pop, _pop))
+    {
+        cerr << "Wrong state loaded from " << _file << endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    eoParser parser(argc, argv);
+    unsigned popSize = parser.createParam(unsigned(10000), "popSize", "Population size", 'P').value();
+    unsigned dimension = parser.createParam(unsigned(10), "dimension", "Size of the genomes", 'd').value();
+    make_help(parser);
+
+    eoUniformGenerator<double> gen(-5, 5);
+    eoInitFixedLength<Indi> init(dimension, gen);
+    eoPop<Indi> pop(popSize, init);
+    for (unsigned i = 0; i < pop.size(); i += 2) // half of them are evaluated
+        pop[i].fitness(pop[i][0]);
+
+    eoState state("binary");
+    state.registerObject(pop);
+    state.registerObject(eo::rng);
+
+    // text, for the timing
+    clock_t start = clock();
+    state.save("t-eoBinaryState.txt");
+    double textTime = double(clock() - start) / CLOCKS_PER_SEC;
+
+    // binary, synchronous
+    state.formatBinary("binary");
+    start = clock();
+    state.save("t-eoBinaryState.bin");
+    double binaryTime = double(clock() - start) / CLOCKS_PER_SEC;
+    if (!reload("t-eoBinaryState.bin", pop))
+        return 1;
+
+    // an rng loaded back from a binary state draws the same numbers
+    double next = eo::rng.uniform();
+    eoState rngState;
+    rngState.registerObject(eo::rng);
+    rngState.load("t-eoBinaryState.bin");
+    if (eo::rng.uniform() != next)
+    {
+        cerr << "Wrong rng loaded" << endl;
+        return 1;
+    }
+
+    // binary, in the background: the population is changed while the file is being written
+    state.asynchronous();
+    start = clock();
+    state.save("t-eoBinaryState.bin");
+    double asyncTime = double(clock() - start) / CLOCKS_PER_SEC;
+    eoPop<Indi> saved = pop;
+    pop[0][0] += 1;
+    state.wait();
+    if (!reload("t-eoBinaryState.bin", saved))
+        return 1;
+
+    state.save("t-eoBinaryState.bin");
+    state.wait();
+    if (!reload("t-eoBinaryState.bin", pop))
+        return 1;
+
+    cout << "Checkpoint of " << popSize << " individuals: text " << textTime << "s, binary "
+         << binaryTime << "s, snapshot for the background " << asyncTime << "s" << endl;
+
+    remove("t-eoBinaryState.txt");
+    remove("t-eoBinaryState.bin");
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,87 @@
+//-----------------------------------------------------------------------------
+// t-eoCMAState.cpp
+//-----------------------------------------------------------------------------
+
+// Checks that sampling a batch from eo::CMAState gives the same vectors as
+// sampling them one by one, along a few generations on the sphere.
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <utils/eoRNG.h>
+#include <es/CMAState.h>
+#include <es/CMAParams.h>
+
+using namespace eo;
+using namespace std;
+
+double sphere(const vector<double>& x)
+{
+    double sum = 0.0;
+    for (unsigned i = 0; i < x.size(); ++i)
+        sum += x[i] * x[i];
+    return sum;
+}
+
+struct CompareSphere
+{
+    bool operator()(const vector<double>* a, const vector<double>* b) const
+    {
+        return sphere(*a) < sphere(*b);
+    }
+};
+
+int main()
+{
+    const unsigned n = 50;
+
+    CMAParams params;
+    params.defaults(n, 1000);
+
+    CMAState state(params, vector<double>(n, 1.0));
+
+    vector<vector<double> > single(params.lambda), batched(params.lambda);
+    vector<vector<double>* > batch(params.lambda);
+    for (unsigned k = 0; k < params.lambda; ++k)
+        batch[k] = &batched[k];
+
+    for (unsigned gen = 0; gen < 20; ++gen)
+    {
+        rng.reseed(42 + gen);
+        for (unsigned k = 0; k < params.lambda; ++k)
+            state.sample(single[k]);
+
+        rng.reseed(42 + gen);
+        state.sample(batch);
+
+        for (unsigned k = 0; k < params.lambda; ++k)
+        {
+            if (batched[k].size() != n)
+            {
+                cerr << "Wrong size of batch sample" << endl;
+                return 1;
+            }
+            for (unsigned i = 0; i < n; ++i)
+                if (fabs(batched[k][i] - single[k][i]) > 1e-12 * (1 + fabs(single[k][i])))
+                {
+                    cerr << "Batch and single samples differ at generation " << gen << endl;
+                    return 1;
+                }
+        }
+
+        // select the mu best, and learn from them
+        vector<const vector<double>* > sorted(batch.begin(), batch.end());
+        sort(sorted.begin(), sorted.end(), CompareSphere());
+        vector<const vector<double>* > mu(sorted.begin(), sorted.begin() + params.mu);
+        state.reestimate(mu, sphere(*mu[0]), sphere(*mu.back()));
+        if (!state.updateEigenSystem(10))
+        {
+            cerr << "No good eigensystem found" << endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+//-----------------------------------------------------------------------------
+// t-eoEvalCounter.cpp
+//-----------------------------------------------------------------------------
+
+// Checks that the evaluation counters stay exact when the population is
+// evaluated by a parallel apply, and that a budget of evaluations stops the
+// loop in all the threads and throws its exception out of apply.
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <iostream>
+#include <eo>
+#include <es.h>
+#include <eoEvalFuncCounterBounder.h>
+#include <eoEvalCounterThrowException.h>
+
+#include "real_value.h"
+
+using namespace std;
+
+typedef eoReal<double> Indi;
+
+unsigned evaluated(const eoPop<Indi>& _pop)
+{
+    unsigned n = 0;
+    for (unsigned i = 0; i < _pop.size(); ++i)
+        if (!_pop[i].invalid())
+            ++n;
+    return n;
+}
+
+template <class Exception>
+bool checkBudget(eoEvalFuncCounter<Indi>& _counter, eoPop<Indi>& _pop, unsigned long _budget)
+{
+    _pop.invalidate();
+    try
+    {
+        apply<Indi>(_counter, _pop);
+    }
+    catch (Exception&)
+    {
+        // the counter stops on the budget, the last evaluation is not done
+        if (_counter.value() != _budget || evaluated(_pop) != _budget - 1)
+        {
+            cerr << "Wrong number of evaluations: " << _counter.value() << " counted, "
+                 << evaluated(_pop) << " done for a budget of " << _budget << endl;
+            return false;
+        }
+        return true;
+    }
+    cerr << "The budget of evaluations was not enforced" << endl;
+    return false;
+}
+
+int main(int argc, char* argv[])
+{
+    // evaluations in parallel, unless told otherwise
+    vector<char*> args(argv, argv + argc);
+    char parallel[] = "--parallelize-loop=1";
+    args.insert(args.begin() + 1, parallel);
+
+    eoParser parser(args.size(), &args[0]);
+    make_parallel(parser);
+    make_help(parser);
+
+    const unsigned popSize = 5000;
+
+    eoUniformGenerator<double> gen(-1, 1);
+    eoInitFixedLength<Indi> init(20, gen);
+    eoPop<Indi> pop(popSize, init);
+
+    eoEvalFuncPtr<Indi, double, const vector<double>&> eval(real_value);
+
+    eoEvalFuncCounter<Indi> counter(eval);
+    for (unsigned i = 1; i <= 10; ++i)
+    {
+        pop.invalidate();
+        apply<Indi>(counter, pop);
+        if (counter.value() != i * popSize || evaluated(pop) != popSize)
+        {
+            cerr << "Wrong number of evaluations: " << counter.value() << " instead of " << i * popSize << endl;
+            return 1;
+        }
+    }
+
+    eoEvalFuncCounterBounder<Indi> bounder(eval, 1234);
+    if (!checkBudget<eoEvalFuncCounterBounderException>(bounder, pop, 1234))
+        return 1;
+
+    eoEvalCounterThrowException<Indi> thrower(eval, 2345);
+    if (!checkBudget<eoMaxEvalException>(thrower, pop, 2345))
+        return 1;
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,98 @@
+//-----------------------------------------------------------------------------
+// t-eoEvalFuncCache.cpp
+//-----------------------------------------------------------------------------
+
+// Checks that eoEvalFuncCache gives the right fitnesses, only calls the
+// wrapped evaluator for the genomes it does not know, and keeps working
+// when it is full or used by the threads of a parallel apply.
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <iostream>
+#include <set>
+#include <eo>
+#include <ga.h>
+
+#include "binary_value.h"
+
+using namespace std;
+
+typedef eoBit<double> Chrom;
+
+bool check(eoEvalFuncCache<Chrom>& _cache, eoPop<Chrom>& _pop, unsigned long _evaluations,
+           const eoEvalFuncCounter<Chrom>& _counter)
+{
+    _pop.invalidate();
+    apply<Chrom>(_cache, _pop);
+
+    for (unsigned i = 0; i < _pop.size(); ++i)
+        if (_pop[i].invalid() || _pop[i].fitness() != binary_value(_pop[i]))
+        {
+            cerr << "Wrong fitness given by the cache" << endl;
+            return false;
+        }
+
+    if (_cache.hits() + _cache.misses() != _evaluations || _cache.misses() != _counter.value())
+    {
+        cerr << "Wrong numbers of hits and misses: " << _cache.hits() << " and " << _cache.misses() << endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    vector<char*> args(argv, argv + argc);
+    char parallel[] = "--parallelize-loop=1";
+    args.insert(args.begin() + 1, parallel);
+
+    eoParser parser(args.size(), &args[0]);
+    make_parallel(parser);
+    make_help(parser);
+
+    // 2000 individuals, with only 256 different genomes
+    eoUniformGenerator<bool> uGen;
+    eoInitFixedLength<Chrom> init(8, uGen);
+    eoPop<Chrom> pop(2000, init);
+
+    set<vector<bool> > genomes;
+    for (unsigned i = 0; i < pop.size(); ++i)
+        genomes.insert(pop[i]);
+
+    eoEvalFuncPtr<Chrom> eval(binary_value);
+
+    // large enough: each genome is evaluated once (or by a few threads at the same time),
+    // then never again
+    eoEvalFuncCounter<Chrom> counter(eval);
+    eoEvalFuncCache<Chrom> cache(counter, 4096);
+    if (!check(cache, pop, pop.size(), counter))
+        return 1;
+    unsigned long evaluations = counter.value();
+    if (!check(cache, pop, 2 * pop.size(), counter))
+        return 1;
+    if (evaluations < genomes.size() || counter.value() != evaluations)
+    {
+        cerr << counter.value() << " evaluations for " << genomes.size() << " genomes" << endl;
+        return 1;
+    }
+
+    eoEvalCacheStat<Chrom> stat(cache);
+    stat(pop);
+    if (stat.value().first != cache.hits() || stat.value().second != cache.misses())
+    {
+        cerr << "Wrong statistics" << endl;
+        return 1;
+    }
+
+    // too small: genomes are replaced, the fitnesses are still right
+    eoEvalFuncCounter<Chrom> smallCounter(eval);
+    eoEvalFuncCache<Chrom> smallCache(smallCounter, 16);
+    if (!check(smallCache, pop, pop.size(), smallCounter) || smallCache.hits() == 0)
+        return 1;
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,180 @@
+//-----------------------------------------------------------------------------
+// t-eoExternalPopEval.cpp
+//-----------------------------------------------------------------------------
+
+// Evaluates populations with a pool of processes running this same
+// program with --worker, some of which crash or hang on purpose, and times
+// the pool against a process started for each evaluation.
+//
+// Usage: t-eoExternalPopEval --evaluations=500
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <cstring>
+#include <iostream>
+#include <sys/time.h>
+#include <eo>
+#include <es.h>
+#include <eoExternalPopEval.h>
+
+using namespace std;
+
+typedef eoReal<double> Chrom;
+
+double sphere(const vector<double>& _x)
+{
+    double sum = 0;
+    for (unsigned i = 0; i < _x.size(); ++i)
+        sum += _x[i] * _x[i];
+    return sum;
+}
+
+// the worker crashes on the individuals starting with 13, and hangs on those starting with 42
+class WorkerEval : public eoEvalFunc<Chrom>
+{
+public:
+    WorkerEval(unsigned _lifetime) : lifetime(_lifetime), count(0) {}
+
+    void operator()(Chrom& _eo)
+    {
+        if (_eo[0] == 13)
+            kill(getpid(), SIGKILL);
+        if (_eo[0] == 42)
+            sleep(100);
+        if (lifetime && ++count > lifetime)
+            exit(0);
+        _eo.fitness(sphere(_eo));
+    }
+
+private:
+    unsigned lifetime;
+    unsigned count;
+};
+
+double seconds()
+{
+    struct timeval t;
+    gettimeofday(&t, 0);
+    return t.tv_sec + 1e-6 * t.tv_usec;
+}
+
+void fill(eoPop<Chrom>& _pop, unsigned _size)
+{
+    eoUniformGenerator<double> gen(-1, 1);
+    eoInitFixedLength<Chrom> init(5, gen);
+    _pop = eoPop<Chrom>(_size, init);
+}
+
+bool check(const eoPop<Chrom>& _pop, const string& _what)
+{
+    for (unsigned i = 0; i < _pop.size(); ++i)
+        if (_pop[i].invalid() || _pop[i].fitness() != sphere(_pop[i]))
+        {
+            cerr << _what << ": wrong fitness for individual " << i << endl;
+            return false;
+        }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && strncmp(argv[1], "--worker", 8) == 0)
+    {
+        ios::sync_with_stdio(false);
+        // --worker=n stops after n evaluations
+        WorkerEval eval(argv[1][8] == '=' ? atoi(argv[1] + 9) : 0);
+        eoExternalPopEval<Chrom>::serve(eval);
+        return 0;
+    }
+
+    eoParser parser(argc, argv);
+    unsigned evaluations = parser.createParam(unsigned(500), "evaluations", "Number of evaluations for the timing", 'e').value();
+    make_help(parser);
+
+    vector<string> command(1, argv[0]);
+    command.push_back("--worker");
+
+    eoPop<Chrom> pop, parents;
+    fill(pop, 50);
+
+    eoExternalPopEval<Chrom> eval(command, 3, 0.5);
+    eval(parents, pop);
+    if (!check(pop, "pool"))
+        return 1;
+
+    // only the invalid individuals are sent
+    pop[7].invalidate();
+    eval(parents, pop);
+    if (!check(pop, "one individual") || eval.starts() != 3)
+        return 1;
+
+    // a crash, without penalty
+    pop[3][0] = 13;
+    pop[3].invalidate();
+    try
+    {
+        eval(parents, pop);
+        cerr << "A crash went unnoticed" << endl;
+        return 1;
+    }
+    catch (std::runtime_error&)
+    {
+    }
+
+    // a crash and a hang, with a penalty: the others are evaluated all the same
+    eval.penalty(-1);
+    pop[5][0] = 42;
+    for (unsigned i = 0; i < pop.size(); ++i)
+        pop[i].invalidate();
+    eval(parents, pop);
+    if (pop[3].fitness() != -1 || pop[5].fitness() != -1)
+    {
+        cerr << "No penalty for the failed individuals" << endl;
+        return 1;
+    }
+    pop[3][0] = pop[5][0] = 0;
+    pop[3].fitness(sphere(pop[3]));
+    pop[5].fitness(sphere(pop[5]));
+    if (!check(pop, "crash and hang"))
+        return 1;
+
+    // workers that stop now and then are started again
+    command[1] = "--worker=7";
+    eoExternalPopEval<Chrom> mortal(command, 2, 0, 4, 10);
+    fill(pop, 100);
+    mortal(parents, pop);
+    if (!check(pop, "restarts") || mortal.starts() < 100 / 7)
+        return 1;
+
+    // timing: a pool against a process per evaluation
+    command[1] = "--worker";
+    fill(pop, evaluations);
+    eoExternalPopEval<Chrom> pool(command, 2);
+    double start = seconds();
+    pool(parents, pop);
+    double poolTime = seconds() - start;
+
+    for (unsigned i = 0; i < pop.size(); ++i)
+        pop[i].invalidate();
+    start = seconds();
+    for (unsigned i = 0; i < pop.size(); ++i)
+    {
+        eoPop<Chrom> one;
+        one.push_back(pop[i]);
+        eoExternalPopEval<Chrom> single(command, 1);
+        single(parents, one);
+        pop[i].fitness(one[0].fitness());
+    }
+    double forkTime = seconds() - start;
+    if (!check(pop, "process per evaluation"))
+        return 1;
+
+    cout << evaluations << " evaluations: " << poolTime << "s with a pool of 2 processes, "
+         << forkTime << "s with a process per evaluation" << endl;
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,265 @@
+//-----------------------------------------------------------------------------
+// t-eoFlatParseTree.cpp
+//-----------------------------------------------------------------------------
+
+// Checks that the trees stored in an array (eoFlatParseTree) are the same as
+// the eoParseTrees they are converted from, read from or printed to, also
+// after the same subtrees have been exchanged and the trees pruned, that
+// their operators and their initialization in parallel give well formed
+// trees, and times the subtree crossover of both representations.
+//
+// Usage: t-eoFlatParseTree --popSize=1000 --generations=20
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include <gp/eoParseTree.h>
+#include <gp/eoFlatParseTree.h>
+#include <gp/eoFlatParseTreeDepthInit.h>
+#include <gp/eoFlatParseTreeOp.h>
+#include <eo>
+
+using namespace std;
+
+class FlatNode
+{
+public :
+    enum Operator {X = 'x', Plus = '+', Min = '-', Mult = '*', PDiv = '/', Neg = '~'};
+
+    FlatNode() : op(X) {}
+    FlatNode(Operator _op) : op(_op) {}
+
+    int arity() const { return op == X ? 0 : op == Neg ? 1 : 2; }
+
+    void randomize() {}
+
+    // evaluation on one case, node by node, for the eoParseTrees
+    template <class Children>
+    void operator()(double& result, Children args, double var) const
+    {
+        double r[2] = {var, 0.0};
+        for (int a = 0; a < arity(); ++a)
+            args[a].apply(r[a], var);
+        result = compute(r[0], r[1]);
+    }
+
+    // evaluation on a batch of cases, for the compiled trees
+    void operator()(double* result, const double* const* args, size_t n, const vector<double>& vars) const
+    {
+        for (size_t k = 0; k < n; ++k)
+            result[k] = compute(arity() > 0 ? args[0][k] : vars[k], arity() > 1 ? args[1][k] : 0.0);
+    }
+
+    char getOp() const { return op; }
+
+    bool operator==(const FlatNode& _other) const { return op == _other.op; }
+
+private :
+
+    double compute(double r1, double r2) const
+    {
+        switch (op)
+        {
+        case Plus : return r1 + r2;
+        case Min  : return r1 - r2;
+        case Mult : return r1 * r2;
+        case PDiv : return r2 == 0.0 ? 1.0 : r1 / r2;
+        case Neg  : return -r1;
+        default   : return r1;
+        }
+    }
+
+    Operator op;
+};
+
+ostream& operator<<(ostream& os, const FlatNode& node)
+{
+    return os << node.getOp();
+}
+
+istream& operator>>(istream& is, FlatNode& node)
+{
+    char op;
+    is >> op;
+    node = FlatNode(static_cast<FlatNode::Operator>(op));
+    return is;
+}
+
+typedef eoParseTree<eoMinimizingFitness, FlatNode> Tree;
+typedef eoFlatParseTree<eoMinimizingFitness, FlatNode> Flat;
+
+template <class T>
+string print(const T& _tree)
+{
+    ostringstream os;
+    os << _tree;
+    return os.str();
+}
+
+bool same(const Tree& _tree, const Flat& _flat, const string& _what)
+{
+    if (print(_tree) != print(_flat) || _tree.size() != _flat.size() || _tree.depth() != _flat.depth())
+    {
+        cerr << _what << ": " << _flat << " instead of " << _tree << endl;
+        return false;
+    }
+    return true;
+}
+
+// the sizes of the subtrees are the ones of the same nodes built again, and the
+// compiled tree gives the values of the eoParseTree
+bool wellFormed(const Flat& _flat, const vector<double>& _cases)
+{
+    flat_tree<FlatNode> again;
+    again.assign(_flat.begin(), _flat.end());
+    if (again != _flat)
+    {
+        cerr << "Wrong subtree sizes in " << _flat << endl;
+        return false;
+    }
+
+    Tree tree(parse_tree<FlatNode>(_flat.rbegin(), _flat.rend()));
+    vector<double> values(_cases.size());
+    _flat.compiled().apply(&values[0], _cases.size(), _cases);
+    for (unsigned k = 0; k < _cases.size(); ++k)
+    {
+        double value;
+        tree.apply(value, _cases[k]);
+        if (value != values[k])
+        {
+            cerr << "Compiled value " << values[k] << " instead of " << value << " for " << _flat << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// the index in the eoParseTree of the node i of a flat tree
+unsigned treeIndex(const Flat& _flat, unsigned _i)
+{
+    return _flat.size() - 1 - _i;
+}
+
+int main(int argc, char* argv[])
+{
+    eoParser parser(argc, argv);
+    unsigned popSize = parser.createParam(unsigned(1000), "popSize", "Number of trees for the timing", 'P').value();
+    unsigned generations = parser.createParam(unsigned(20), "generations", "Number of crossovers of each tree for the timing", 'G').value();
+    make_help(parser);
+
+    FlatNode nodes[6] = {FlatNode::X, FlatNode::Plus, FlatNode::Min, FlatNode::Mult, FlatNode::PDiv, FlatNode::Neg};
+    vector<FlatNode> init(nodes, nodes + 6);
+    eoParseTreeDepthInit<eoMinimizingFitness, FlatNode> initializer(8, init);
+
+    vector<double> cases(20);
+    for (unsigned k = 0; k < cases.size(); ++k)
+        cases[k] = eo::rng.uniform(-2, 2);
+
+    // conversions, reading and printing
+    eoPop<Tree> trees(100, initializer);
+    eoPop<Flat> flats;
+    for (unsigned i = 0; i < trees.size(); ++i)
+    {
+        flats.push_back(Flat(trees[i]));
+        if (!same(trees[i], flats[i], "conversion") || !wellFormed(flats[i], cases))
+            return 1;
+
+        trees[i].fitness(i);
+        istringstream treeText(print(trees[i]));
+        flats[i].readFrom(treeText);
+        istringstream flatText(print(flats[i]));
+        Tree read(flatText);
+        if (!same(trees[i], flats[i], "reading") || !same(read, flats[i], "printing"))
+            return 1;
+    }
+
+    // the same subtrees replaced and exchanged, then the same pruning
+    for (unsigned i = 0; i + 1 < trees.size(); i += 2)
+    {
+        unsigned a = eo::rng.random(flats[i].size());
+        unsigned b = eo::rng.random(flats[i + 1].size());
+        trees[i][treeIndex(flats[i], a)] = trees[i + 1][treeIndex(flats[i + 1], b)];
+        flats[i].replace(a, flats[i + 1], b);
+        if (!same(trees[i], flats[i], "replace"))
+            return 1;
+
+        a = eo::rng.random(flats[i].size());
+        b = eo::rng.random(flats[i + 1].size());
+        Tree::Subtree tmp = trees[i][treeIndex(flats[i], a)];
+        trees[i][treeIndex(flats[i], a)] = trees[i + 1][treeIndex(flats[i + 1], b)];
+        trees[i + 1][treeIndex(flats[i + 1], b)] = tmp;
+        flats[i].swap_subtrees(a, flats[i + 1], b);
+        if (!same(trees[i], flats[i], "exchange") || !same(trees[i + 1], flats[i + 1], "exchange"))
+            return 1;
+
+        unsigned length = 1 + eo::rng.random(flats[i].size());
+        trees[i].pruneTree(length);
+        flats[i].pruneTree(length);
+        if (!same(trees[i], flats[i], "pruning") || flats[i].size() > length || !wellFormed(flats[i], cases))
+            return 1;
+    }
+
+    // the operators of the flat trees
+    eoFlatParseTreeDepthInit<eoMinimizingFitness, FlatNode> flatInit(8, init);
+    eoFlatParseTreeDepthInit<eoMinimizingFitness, FlatNode> ramped(6, init, true, true);
+    eoFlatSubtreeXOver<eoMinimizingFitness, FlatNode> xover(50);
+    eoFlatBranchMutation<eoMinimizingFitness, FlatNode> branch(flatInit, 50);
+    eoFlatPointMutation<eoMinimizingFitness, FlatNode> point(init);
+    eoFlatHoistMutation<eoMinimizingFitness, FlatNode> hoist;
+    eoPop<Flat> pop(100, ramped);
+    for (unsigned i = 0; i + 1 < pop.size(); i += 2)
+    {
+        xover(pop[i], pop[i + 1]);
+        branch(pop[i]);
+        point(pop[i + 1]);
+        if (i % 10 == 0)
+            hoist(pop[i]);
+        pop[i].invalidate();
+        pop[i + 1].invalidate();
+        if (pop[i].size() > 50 || pop[i + 1].size() > 50 || !wellFormed(pop[i], cases) || !wellFormed(pop[i + 1], cases))
+            return 1;
+    }
+
+    // timing of the crossover
+    eoPop<Tree> treePop(popSize, initializer);
+    eoPop<Flat> flatPop;
+    for (unsigned i = 0; i < treePop.size(); ++i)
+        flatPop.push_back(Flat(treePop[i]));
+
+    eoSubtreeXOver<eoMinimizingFitness, FlatNode> treeXover(100);
+    clock_t start = clock();
+    for (unsigned g = 0; g < generations; ++g)
+        for (unsigned i = 0; i + 1 < treePop.size(); i += 2)
+            treeXover(treePop[eo::rng.random(popSize)], treePop[eo::rng.random(popSize)]);
+    double treeTime = double(clock() - start) / CLOCKS_PER_SEC;
+
+    eoFlatSubtreeXOver<eoMinimizingFitness, FlatNode> flatXover(100);
+    start = clock();
+    for (unsigned g = 0; g < generations; ++g)
+        for (unsigned i = 0; i + 1 < flatPop.size(); i += 2)
+            flatXover(flatPop[eo::rng.random(popSize)], flatPop[eo::rng.random(popSize)]);
+    double flatTime = double(clock() - start) / CLOCKS_PER_SEC;
+
+    cout << generations * (popSize / 2) << " subtree crossovers: " << treeTime << "s with eoParseTree, "
+         << flatTime << "s with eoFlatParseTree" << endl;
+
+    // the trees built by several threads are well formed
+    char* args[] = { argv[0], (char*) "--parallelize-loop=1", (char*) "--parallelize-dynamic=0" };
+    eoParser parallelParser(3, args);
+    make_parallel(parallelParser);
+
+    eoPop<Flat> parallel;
+    parallel.resize(popSize);
+    apply<Flat>(flatInit, parallel);
+    for (unsigned i = 0; i < parallel.size(); ++i)
+        if (parallel[i].empty() || !wellFormed(parallel[i], cases))
+            return 1;
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
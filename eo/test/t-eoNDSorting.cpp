@@ -0,0 +1,115 @@
+//-----------------------------------------------------------------------------
+// t-eoNDSorting.cpp
+//-----------------------------------------------------------------------------
+
+// Checks that the efficient non-dominated sort (ENS-BS) of eoNDSorting gives
+// the same fronts as the algorithm of Deb, and compares their running times.
+//
+// Usage: t-eoNDSorting --popSize=2000 --nObjectives=3
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <ctime>
+#include <iostream>
+#include <vector>
+#include <eo>
+
+using namespace std;
+
+/** A minimal multi-objective fitness: all objectives are minimized */
+class MOFitness : public vector<double>
+{
+public :
+    typedef MOFitness fitness_traits;
+
+    static unsigned nObj;
+
+    static unsigned nObjectives() { return nObj; }
+    static bool maximizing(unsigned) { return false; }
+    static double tol() { return 1e-10; }
+
+    MOFitness() : vector<double>(nObj, 0.0) {}
+
+    bool dominates(const MOFitness& _other) const
+    {
+        bool dom = false;
+        for (unsigned i = 0; i < size(); ++i)
+        {
+            if (fabs((*this)[i] - _other[i]) <= tol())
+                continue;
+            if ((*this)[i] > _other[i])
+                return false;
+            dom = true;
+        }
+        return dom;
+    }
+};
+
+unsigned MOFitness::nObj = 3;
+
+ostream& operator<<(ostream& _os, const MOFitness& _fit)
+{
+    for (unsigned i = 0; i < _fit.size(); ++i)
+        _os << _fit[i] << ' ';
+    return _os;
+}
+
+istream& operator>>(istream& _is, MOFitness& _fit)
+{
+    for (unsigned i = 0; i < _fit.size(); ++i)
+        _is >> _fit[i];
+    return _is;
+}
+
+typedef EO<MOFitness> Indi;
+
+double worths(eoNDSorting<Indi>& _sorting, const eoPop<Indi>& _pop, vector<double>& _worths)
+{
+    clock_t start = clock();
+    _sorting(_pop);
+    clock_t end = clock();
+
+    _worths = _sorting.value();
+    return double(end - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char* argv[])
+{
+    eoParser parser(argc, argv);
+    unsigned popSize = parser.createParam(unsigned(500), "popSize", "Population size", 'P').value();
+    MOFitness::nObj = parser.createParam(unsigned(3), "nObjectives", "Number of objectives", 'M').value();
+
+    rng.reseed(42);
+
+    // objectives on a coarse grid, so that there are ties and clones
+    eoPop<Indi> pop;
+    pop.resize(popSize);
+    for (unsigned i = 0; i < popSize; ++i)
+    {
+        MOFitness fit;
+        for (unsigned o = 0; o < fit.size(); ++o)
+            fit[o] = rng.random(100);
+        pop[i].fitness(fit);
+    }
+
+    // no niching: the worths are the ranks of the fronts
+    eoNDSorting_I<Indi> deb(0.0, false, false);
+    eoNDSorting_I<Indi> ens(0.0, false, true);
+
+    vector<double> debWorths, ensWorths;
+    double debTime = worths(deb, pop, debWorths);
+    double ensTime = worths(ens, pop, ensWorths);
+
+    cout << "N=" << popSize << " M=" << MOFitness::nObj
+         << " deb: " << debTime << "s ens: " << ensTime << "s" << endl;
+
+    if (debWorths != ensWorths)
+    {
+        cerr << "ENS and Deb's algorithm give different fronts" << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,266 @@
+//-----------------------------------------------------------------------------
+// t-eoNodePool.cpp
+//-----------------------------------------------------------------------------
+
+// Initializes and breeds parse trees in several threads, which allocate
+// their nodes from their own pools, checks that the trees are well formed,
+// that the nodes freed by the other threads are used again and that all of
+// them are given back, as counted by eoNodePoolStat, that the threads that
+// end leave their pools to the next ones, and times the breeding in sequence
+// and in parallel.
+//
+// Usage: t-eoNodePool --popSize=2000 --generations=10
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <iostream>
+#include <gp/eoParseTree.h>
+#include <gp/eoNodePoolStat.h>
+#include <eo>
+#include <utils/eoParallel.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#if __cplusplus >= 201103L
+#include <thread>
+#endif
+
+using namespace std;
+
+class PoolNode
+{
+public :
+    enum Operator {X = 'x', Plus = '+', Min = '-', Mult = '*', Neg = '~'};
+
+    PoolNode() : op(X) {}
+    PoolNode(Operator _op) : op(_op) {}
+
+    int arity() const { return op == X ? 0 : op == Neg ? 1 : 2; }
+
+    void randomize() {}
+
+    template <class Children>
+    void operator()(double& result, Children args, double var) const
+    {
+        double r[2] = {var, 0.0};
+        for (int a = 0; a < arity(); ++a)
+            args[a].apply(r[a], var);
+        result = compute(r[0], r[1]);
+    }
+
+    void operator()(double* result, const double* const* args, size_t n, const vector<double>& vars) const
+    {
+        for (size_t k = 0; k < n; ++k)
+            result[k] = compute(arity() > 0 ? args[0][k] : vars[k], arity() > 1 ? args[1][k] : 0.0);
+    }
+
+    char getOp() const { return op; }
+
+private :
+
+    double compute(double r1, double r2) const
+    {
+        switch (op)
+        {
+        case Plus : return r1 + r2;
+        case Min  : return r1 - r2;
+        case Mult : return r1 * r2;
+        case Neg  : return -r1;
+        default   : return r1;
+        }
+    }
+
+    Operator op;
+};
+
+ostream& operator<<(ostream& os, const PoolNode& node)
+{
+    return os << node.getOp();
+}
+
+istream& operator>>(istream& is, PoolNode& node)
+{
+    char op;
+    is >> op;
+    node = PoolNode(static_cast<PoolNode::Operator>(op));
+    return is;
+}
+
+typedef eoParseTree<double, PoolNode> Tree;
+
+// the sizes kept in the subtrees are right, and the tree gives the same values compiled
+bool wellFormed(const Tree& _tree, const vector<double>& _cases)
+{
+    vector<PoolNode> nodes(_tree.ebegin(), _tree.eend());
+    Tree again(parse_tree<PoolNode>(nodes.begin(), nodes.end()));
+    if (again.size() != _tree.size() || again.depth() != _tree.depth())
+    {
+        cerr << "Wrong size or depth for " << _tree << endl;
+        return false;
+    }
+
+    vector<double> values(_cases.size());
+    _tree.compiled().apply(&values[0], _cases.size(), _cases);
+    for (unsigned k = 0; k < _cases.size(); ++k)
+    {
+        double value;
+        _tree.apply(value, _cases[k]);
+        if (value != values[k])
+        {
+            cerr << "Value " << value << " instead of " << values[k] << " for " << _tree << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// breeds the population for some generations, the offspring replacing the parents
+double evolve(eoPop<Tree>& _pop, eoGenOp<Tree>& _op, unsigned _generations, eoNodePoolStat<Tree>& _chunks)
+{
+    // the breeder keeps the offspring of each thread, it is gone with them
+    eoRandomSelect<Tree> select;
+    eoParallelGeneralBreeder<Tree> breeder(select, _op, eoHowMany(1.0));
+
+    double start = 0;
+#ifdef _OPENMP
+    start = omp_get_wtime();
+#endif
+    for (unsigned g = 0; g < _generations; ++g)
+    {
+        eoPop<Tree> offspring;
+        breeder(_pop, offspring);
+        _pop.swap(offspring);
+        if (g == 1)
+            _chunks(_pop);
+    }
+#ifdef _OPENMP
+    return omp_get_wtime() - start;
+#else
+    return start;
+#endif
+}
+
+#if defined(_OPENMP) && __cplusplus >= 201103L
+// builds and destroys some trees
+void shortLived(eoParseTreeDepthInit<double, PoolNode>* _initializer)
+{
+    eoPop<Tree> trees(50, *_initializer);
+}
+#endif
+
+int main(int argc, char* argv[])
+{
+    eoParser parser(argc, argv);
+    unsigned popSize = parser.createParam(unsigned(2000), "popSize", "Number of trees", 'P').value();
+    unsigned generations = parser.createParam(unsigned(10), "generations", "Number of generations", 'G').value();
+    make_help(parser);
+
+    PoolNode nodes[5] = {PoolNode::X, PoolNode::Plus, PoolNode::Min, PoolNode::Mult, PoolNode::Neg};
+    vector<PoolNode> init(nodes, nodes + 5);
+    eoParseTreeDepthInit<double, PoolNode> initializer(7, init);
+
+    vector<double> cases(10);
+    for (unsigned k = 0; k < cases.size(); ++k)
+        cases[k] = eo::rng.uniform(-2, 2);
+
+    eoNodePoolStat<Tree> live;
+    eoNodePoolStat<Tree> peak(eoNodePoolStat<Tree>::Peak);
+    eoNodePoolStat<Tree> chunks(eoNodePoolStat<Tree>::Chunks);
+    eoNodePoolStat<Tree> firstChunks(eoNodePoolStat<Tree>::Chunks);
+
+    eoPop<Tree> pop;
+    live(pop);
+    double before = live.value();
+
+    eoSubtreeXOver<double, PoolNode> xover(100);
+    eoBranchMutation<double, PoolNode> mutation(initializer, 100);
+    eoSequentialOp<Tree> op;
+    op.add(xover, 0.8);
+    op.add(mutation, 0.2);
+
+    // in sequence
+    pop.resize(popSize);
+    apply<Tree>(initializer, pop);
+    double sequentialTime = evolve(pop, op, generations, firstChunks);
+    live(pop);
+    if (live.value() <= before)
+    {
+        cerr << "No live blocks counted" << endl;
+        return 1;
+    }
+    pop.clear();
+
+    // the same in parallel
+    char* args[] = { argv[0], (char*) "--parallelize-loop=1", (char*) "--parallelize-dynamic=0" };
+    eoParser parallelParser(3, args);
+    make_parallel(parallelParser);
+
+    pop.resize(popSize);
+    apply<Tree>(initializer, pop);
+    double parallelTime = evolve(pop, op, generations, firstChunks);
+
+    for (unsigned i = 0; i < pop.size(); ++i)
+        if (!wellFormed(pop[i], cases))
+            return 1;
+
+    // the blocks freed by the master thread went back to their pools
+    chunks(pop);
+    if (chunks.value() > 2 * firstChunks.value())
+    {
+        cerr << chunks.value() << " chunks after " << generations << " generations, "
+             << firstChunks.value() << " after 2" << endl;
+        return 1;
+    }
+
+    peak(pop);
+    pop.clear();
+    pop.release_spare();
+    live(pop);
+    if (live.value() != before)
+    {
+        cerr << live.value() - before << " blocks not given back" << endl;
+        return 1;
+    }
+
+#if defined(_OPENMP) && __cplusplus >= 201103L
+    // threads started one after the other take over the pools of the ended ones
+    std::thread first(shortLived, &initializer);
+    first.join();
+    chunks(pop);
+    double oneThread = chunks.value();
+    unsigned started = 2 * gp_parse_tree::MemPool::max_threads;
+    for (unsigned t = 0; t < started; ++t)
+    {
+        std::thread next(shortLived, &initializer);
+        next.join();
+    }
+    chunks(pop);
+    if (chunks.value() - oneThread >= started)
+    {
+        cerr << chunks.value() - oneThread << " chunks carved by " << started << " threads, which could reuse the pools of the ended ones" << endl;
+        return 1;
+    }
+    live(pop);
+    if (live.value() != before)
+    {
+        cerr << live.value() - before << " blocks not given back by the threads" << endl;
+        return 1;
+    }
+#endif
+
+    unsigned threads = 1;
+#ifdef _OPENMP
+    threads = omp_get_max_threads();
+#endif
+    cout << generations << " generations of " << popSize << " trees: " << sequentialTime << "s in sequence, "
+         << parallelTime << "s with " << threads << " threads (" << chunks.value() << " chunks, peak of "
+         << peak.value() << " blocks)" << endl;
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
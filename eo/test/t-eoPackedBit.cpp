@@ -0,0 +1,123 @@
+//-----------------------------------------------------------------------------
+// t-eoPackedBit.cpp
+//-----------------------------------------------------------------------------
+
+// Checks that eoPackedBit reads and prints like eoBit, and that its word-level
+// operators behave like the bit-level ones of eoBitOp.h.
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <eo>
+#include <ga.h>
+
+using namespace std;
+
+typedef eoBit<double> Chrom;
+typedef eoPackedBit<double> Packed;
+
+static int fail(const string& _msg)
+{
+    cerr << _msg << endl;
+    return 1;
+}
+
+int main()
+{
+    const unsigned size = 150; // not a multiple of 64
+    rng.reseed(42);
+
+    // an eoBit and the same eoPackedBit
+    eoUniformGenerator<bool> uGen;
+    eoInitFixedLength<Chrom> init(size, uGen);
+    Chrom bit;
+    init(bit);
+    bit.fitness(1.5);
+
+    Packed packed;
+    {
+        stringstream ss;
+        ss << bit;
+        ss >> packed;
+    }
+    if (packed.size() != size)
+        return fail("Wrong size after reading an eoBit");
+    {
+        stringstream sb, sp;
+        sb << bit;
+        sp << packed;
+        if (sb.str() != sp.str())
+            return fail("eoPackedBit is not printed as eoBit: " + sp.str());
+
+        Chrom back;
+        sp >> back;
+        if (static_cast<vector<bool>&>(back) != static_cast<vector<bool>&>(bit))
+            return fail("eoBit cannot read an eoPackedBit");
+    }
+    if (packed.count() != unsigned(count(bit.begin(), bit.end(), true)))
+        return fail("Wrong count");
+
+    // Hamming distance
+    eoPackedBitInit<Packed> packedInit(size);
+    eoHammingDistance<Packed> hamming;
+    for (unsigned k = 0; k < 20; ++k)
+    {
+        Packed a, b;
+        packedInit(a);
+        packedInit(b);
+        unsigned naive = 0;
+        for (unsigned i = 0; i < size; ++i)
+            naive += (a[i] != b[i]);
+        if (hamming(a, b) != naive)
+            return fail("Wrong Hamming distance");
+    }
+
+    // crossovers only exchange bits: the bits of both parents at each
+    // position are kept, and the unused bits stay to zero
+    eoPackedUBitXover<Packed> ux;
+    eoPackedUBitXover<Packed> ux3(0.3);
+    eoPacked1PtBitXover<Packed> x1;
+    eoPackedNPtsBitXover<Packed> xn(3);
+    eoQuadOp<Packed>* xovers[] = { &ux, &ux3, &x1, &xn };
+    for (unsigned x = 0; x < 4; ++x)
+        for (unsigned k = 0; k < 20; ++k)
+        {
+            Packed a, b;
+            packedInit(a);
+            packedInit(b);
+            Packed a0 = a, b0 = b;
+            (*xovers[x])(a, b);
+            for (unsigned i = 0; i < size; ++i)
+                if (a[i] + b[i] != a0[i] + b0[i])
+                    return fail("Crossover " + xovers[x]->className() + " does not conserve the bits");
+            if (a.words().back() >> (size % Packed::wordSize) || b.words().back() >> (size % Packed::wordSize))
+                return fail("Crossover " + xovers[x]->className() + " sets unused bits");
+        }
+
+    // mutation flips the expected number of bits
+    const double rate = 0.05;
+    const unsigned trials = 2000;
+    eoPackedBitMutation<Packed> mutation(rate);
+    Packed p(size);
+    unsigned flipped = 0;
+    for (unsigned k = 0; k < trials; ++k)
+    {
+        Packed q = p;
+        mutation(q);
+        flipped += hamming(p, q);
+    }
+    double expected = rate * size * trials;
+    if (fabs(flipped - expected) > 5 * sqrt(expected * (1 - rate)))
+        return fail("Wrong mutation rate");
+
+    eoPackedBitMutation<Packed> full(1.0);
+    full(p);
+    if (p.count() != size)
+        return fail("Mutation with rate 1 must flip all bits");
+
+    return 0;
+}
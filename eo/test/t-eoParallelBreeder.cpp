@@ -0,0 +1,124 @@
+//-----------------------------------------------------------------------------
+// t-eoParallelBreeder.cpp
+//-----------------------------------------------------------------------------
+
+// Checks that eoParallelGeneralBreeder produces the requested number of
+// offspring and is deterministic for a given seed and number of threads,
+// with the parallel loops enabled and at least 2 threads, and that an
+// exception thrown by the operator in a thread reaches the caller.
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <iostream>
+#include <eo>
+#include <ga.h>
+#include <utils/eoParallel.h>
+
+#include "binary_value.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
+
+typedef eoBit<double> Chrom;
+
+// throws once it has been called so many times
+class FailingOp : public eoMonOp<Chrom>
+{
+public:
+    FailingOp(unsigned _calls) : calls(_calls) {}
+
+    bool operator()(Chrom&)
+    {
+        unsigned left;
+#ifdef _OPENMP
+#pragma omp atomic capture
+#endif
+        left = --calls;
+        if (left == 0)
+            throw std::runtime_error("operator failed");
+        return false;
+    }
+
+private:
+    unsigned calls;
+};
+
+static void breed(eoBreed<Chrom>& _breed, const eoPop<Chrom>& _parents, eoPop<Chrom>& _offspring)
+{
+    rng.reseed(42);
+    eo::rngPool.reseed(42);
+    _breed(_parents, _offspring);
+}
+
+int main(int, char* argv[])
+{
+    // the parallel path is tested whatever the options, with a static schedule
+    char* args[] = { argv[0], (char*) "--parallelize-loop=1", (char*) "--parallelize-dynamic=0" };
+    eoParser parser(3, args);
+    make_parallel(parser);
+#ifdef _OPENMP
+    if (omp_get_max_threads() < 2)
+        omp_set_num_threads(4);
+#endif
+
+    const unsigned popSize = 100;
+    const unsigned chromSize = 64;
+
+    eoEvalFuncPtr<Chrom> eval(binary_value);
+    eoUniformGenerator<bool> uGen;
+    eoInitFixedLength<Chrom> init(chromSize, uGen);
+
+    rng.reseed(1);
+    eoPop<Chrom> parents(popSize, init);
+    apply<Chrom>(eval, parents);
+
+    eoDetTournamentSelect<Chrom> select(2);
+    eo1PtBitXover<Chrom> xover;
+    eoBitMutation<Chrom> mutation(1.0 / chromSize);
+
+    eoSequentialOp<Chrom> op;
+    op.add(xover, 0.8);
+    op.add(mutation, 1.0);
+
+    // an odd number of offspring, not a multiple of the number of threads
+    eoParallelGeneralBreeder<Chrom> breeder(select, op, eoHowMany(157u));
+
+    eoPop<Chrom> off1, off2;
+    breed(breeder, parents, off1);
+    breed(breeder, parents, off2);
+
+    if (off1.size() != 157) {
+        cerr << "Wrong number of offspring: " << off1.size() << endl;
+        return 1;
+    }
+
+    for (unsigned i = 0; i < off1.size(); ++i)
+        if (static_cast<const vector<bool>&>(off1[i]) != static_cast<const vector<bool>&>(off2[i])) {
+            cerr << "Breeding is not deterministic" << endl;
+            return 1;
+        }
+
+#if __cplusplus >= 201103L
+    FailingOp failing(50);
+    eoSequentialOp<Chrom> failingOp;
+    failingOp.add(failing, 1.0);
+    eoParallelGeneralBreeder<Chrom> failingBreeder(select, failingOp, eoHowMany(157u));
+    try
+    {
+        eoPop<Chrom> off3;
+        breed(failingBreeder, parents, off3);
+        cerr << "The exception of the operator was lost" << endl;
+        return 1;
+    }
+    catch (std::runtime_error&)
+    {
+    }
+#endif
+
+    return 0;
+}
@@ -0,0 +1,193 @@
+//-----------------------------------------------------------------------------
+// t-eoParseTreeCompiled.cpp
+//-----------------------------------------------------------------------------
+
+// Evaluates random trees on a set of cases, node by node through apply() and
+// compiled into a postfix_program, checks that both give the same values,
+// also after the trees have been changed by the variation operators, and
+// compares the times taken.
+//
+// Usage: t-eoParseTreeCompiled --popSize=200 --nbCases=100
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <ctime>
+#include <iostream>
+#include <gp/eoParseTree.h>
+#include <eo>
+
+using namespace std;
+
+class CompiledNode
+{
+public :
+    enum Operator {X = 'x', Plus = '+', Min = '-', Mult = '*', PDiv = '/'};
+
+    CompiledNode() : op(X) {}
+    CompiledNode(Operator _op) : op(_op) {}
+
+    int arity() const { return op == X ? 0 : 2; }
+
+    void randomize() {}
+
+    // evaluation on one case, node by node
+    template <class Children>
+    void operator()(double& result, Children args, double var) const
+    {
+        if (op == X)
+        {
+            result = var;
+            return;
+        }
+
+        double r1, r2;
+        args[0].apply(r1, var);
+        args[1].apply(r2, var);
+        result = compute(r1, r2);
+    }
+
+    // evaluation on a batch of cases, for the compiled trees
+    void operator()(double* result, const double* const* args, size_t n, const vector<double>& vars) const
+    {
+        if (op == X)
+        {
+            copy(vars.begin(), vars.begin() + n, result);
+            return;
+        }
+
+        for (size_t k = 0; k < n; ++k)
+            result[k] = compute(args[0][k], args[1][k]);
+    }
+
+    char getOp() const { return op; }
+
+private :
+
+    double compute(double r1, double r2) const
+    {
+        switch (op)
+        {
+        case Plus : return r1 + r2;
+        case Min  : return r1 - r2;
+        case Mult : return r1 * r2;
+        case PDiv : return r2 == 0.0 ? 1.0 : r1 / r2;
+        default   : return 0.0;
+        }
+    }
+
+    Operator op;
+};
+
+ostream& operator<<(ostream& os, const CompiledNode& node)
+{
+    return os << node.getOp();
+}
+
+istream& operator>>(istream& is, CompiledNode& node)
+{
+    node = CompiledNode(static_cast<CompiledNode::Operator>(is.get()));
+    return is;
+}
+
+typedef eoParseTree<eoMinimizingFitness, CompiledNode> Tree;
+
+bool sameValues(const Tree& _tree, const vector<double>& _cases)
+{
+    vector<double> compiled(_cases.size());
+    _tree.compiled().apply(&compiled[0], _cases.size(), _cases);
+
+    for (unsigned k = 0; k < _cases.size(); ++k)
+    {
+        double value;
+        _tree.apply(value, _cases[k]);
+        if (value != compiled[k])
+        {
+            cerr << "Compiled value " << compiled[k] << " instead of " << value << " for " << _tree << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    eoParser parser(argc, argv);
+    unsigned popSize = parser.createParam(unsigned(200), "popSize", "Number of trees", 'P').value();
+    unsigned nbCases = parser.createParam(unsigned(100), "nbCases", "Number of fitness cases", 'n').value();
+    make_help(parser);
+
+    CompiledNode nodes[5] = {CompiledNode::X, CompiledNode::Plus, CompiledNode::Min, CompiledNode::Mult, CompiledNode::PDiv};
+    vector<CompiledNode> init(nodes, nodes + 5);
+    eoGpDepthInitializer<eoMinimizingFitness, CompiledNode> initializer(8, init);
+
+    vector<double> cases(nbCases);
+    for (unsigned k = 0; k < nbCases; ++k)
+        cases[k] = eo::rng.uniform(-2, 2);
+
+    eoPop<Tree> pop(popSize, initializer);
+    for (unsigned i = 0; i < pop.size(); ++i)
+        if (!sameValues(pop[i], cases))
+            return 1;
+
+    // a valid tree keeps its program, which a copy does not share
+    pop[0].fitness(0);
+    const postfix_program<CompiledNode>* program = &pop[0].compiled();
+    if (&pop[0].compiled() != program || program->size() != pop[0].size())
+    {
+        cerr << "Compiled program not kept" << endl;
+        return 1;
+    }
+    Tree copy = pop[0];
+    if (&copy.compiled() == program || !sameValues(copy, cases))
+        return 1;
+
+    // the operators change the trees, which are then compiled again
+    eoSubtreeXOver<eoMinimizingFitness, CompiledNode> xover(100);
+    eoBranchMutation<eoMinimizingFitness, CompiledNode> mutation(initializer, 100);
+    for (unsigned i = 0; i + 1 < pop.size(); i += 2)
+    {
+        pop[i].compiled();
+        pop[i + 1].compiled();
+        if (xover(pop[i], pop[i + 1]))
+        {
+            pop[i].invalidate();
+            pop[i + 1].invalidate();
+        }
+        if (mutation(pop[i]))
+            pop[i].invalidate();
+        if (!sameValues(pop[i], cases) || !sameValues(pop[i + 1], cases))
+            return 1;
+    }
+
+    // timings, the compilation included
+    vector<double> values(nbCases);
+    double sum = 0;
+    clock_t start = clock();
+    for (unsigned i = 0; i < pop.size(); ++i)
+        for (unsigned k = 0; k < nbCases; ++k)
+        {
+            pop[i].apply(values[k], cases[k]);
+            sum += values[k];
+        }
+    double treeTime = double(clock() - start) / CLOCKS_PER_SEC;
+
+    double compiledSum = 0;
+    start = clock();
+    for (unsigned i = 0; i < pop.size(); ++i)
+    {
+        pop[i].invalidate();
+        pop[i].compiled().apply(&values[0], nbCases, cases);
+        for (unsigned k = 0; k < nbCases; ++k)
+            compiledSum += values[k];
+    }
+    double compiledTime = double(clock() - start) / CLOCKS_PER_SEC;
+
+    cout << "Evaluation of " << popSize << " trees on " << nbCases << " cases: " << treeTime
+         << "s node by node, " << compiledTime << "s compiled (sums " << sum << " and " << compiledSum << ")" << endl;
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,143 @@
+//-----------------------------------------------------------------------------
+// t-eoPopRecycle.cpp
+//-----------------------------------------------------------------------------
+
+// Checks that a population recycles the storage of the individuals it
+// drops: once the offspring have reached their size, breeding and
+// replacing a generation of real vectors does not allocate any memory.
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <eo>
+#include <es.h>
+
+using namespace std;
+
+// counts the allocations of the whole program
+static unsigned long allocations = 0;
+
+void* operator new(size_t _size)
+{
+    ++allocations;
+    void* p = malloc(_size ? _size : 1);
+    if (!p)
+        throw bad_alloc();
+    return p;
+}
+
+void operator delete(void* _p) throw()
+{
+    free(_p);
+}
+
+void operator delete(void* _p, size_t) throw()
+{
+    free(_p);
+}
+
+typedef eoReal<double> Chrom;
+
+double sphere(const vector<double>& _x)
+{
+    double sum = 0;
+    for (unsigned i = 0; i < _x.size(); ++i)
+        sum += _x[i] * _x[i];
+    return sum;
+}
+
+int main()
+{
+    const unsigned popSize = 20, dim = 1000;
+
+    eoUniformGenerator<double> gen(-1, 1);
+    eoInitFixedLength<Chrom> init(dim, gen);
+    eoPop<Chrom> pop(popSize, init);
+
+    eoEvalFuncPtr<Chrom, double, const vector<double>&> eval(sphere);
+    apply<Chrom>(eval, pop);
+
+    eoDetTournamentSelect<Chrom> select(2);
+    eoUniformMutation<Chrom> mutation(0.1);
+    eoMonGenOp<Chrom> op(mutation);
+    eoGeneralBreeder<Chrom> breeder(select, op);
+    eoGenerationalReplacement<Chrom> replace;
+
+    eoPop<Chrom> offspring;
+    for (unsigned gen = 0; gen < 10; ++gen)
+    {
+#if __cplusplus >= 201103L
+        unsigned long before = allocations;
+#endif
+
+        offspring.recycle();
+        breeder(pop, offspring);
+        for (unsigned i = 0; i < offspring.size(); ++i)
+            if (offspring[i].invalid())
+                offspring[i].fitness(sphere(offspring[i]));
+        replace(pop, offspring);
+
+        if (pop.size() != popSize || pop[0].size() != dim)
+        {
+            cerr << "Wrong population after generation " << gen << endl;
+            return 1;
+        }
+
+#if __cplusplus >= 201103L
+        // the first two generations give their storage to the offspring and the parents
+        if (gen >= 2 && allocations != before)
+        {
+            cerr << allocations - before << " allocations in generation " << gen << endl;
+            return 1;
+        }
+#endif
+    }
+
+    // the individuals removed by resize are recycled, and not copied along with the population
+    Chrom best = pop.best_element();
+    pop.resize(popSize / 2);
+    eoPop<Chrom> copy = pop;
+    if (copy.spare_size() != 0 || copy.size() != popSize / 2)
+    {
+        cerr << "Spare individuals copied" << endl;
+        return 1;
+    }
+
+    // growing with a value copies it into the recycled individuals
+#if __cplusplus >= 201103L
+    unsigned long before = allocations;
+#endif
+    pop.resize(popSize, best);
+    if (pop.size() != popSize || !(pop.back() == best))
+    {
+        cerr << "Wrong individuals added by resize" << endl;
+        return 1;
+    }
+#if __cplusplus >= 201103L
+    if (allocations != before)
+    {
+        cerr << allocations - before << " allocations in resize" << endl;
+        return 1;
+    }
+#endif
+    pop.resize(popSize / 2);
+
+    pop.push_back(best);
+    if (!(pop.back() == best) || pop.back().size() != dim)
+    {
+        cerr << "Wrong individual pushed back" << endl;
+        return 1;
+    }
+
+    pop.release_spare();
+    if (pop.spare_size() != 0)
+        return 1;
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,78 @@
+//-----------------------------------------------------------------------------
+// t-eoRNGPool.cpp
+//-----------------------------------------------------------------------------
+
+// Checks that the per-thread streams of eo::rngPool are reproducible for a
+// given master seed, independent from each other, and that sequential code
+// keeps on using the global eo::rng.
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <iostream>
+#include <vector>
+#include <eo>
+#include <utils/eoRNG.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
+
+static vector<uint32_t> draw(eoRng& gen, size_t n)
+{
+    vector<uint32_t> v(n);
+    for (size_t i = 0; i < n; ++i)
+        v[i] = gen.rand();
+    return v;
+}
+
+int main()
+{
+    const size_t num(100);
+
+    if (&eo::threadRng() != &eo::rng) {
+        cerr << "Sequential code should use the global generator" << endl;
+        return 1;
+    }
+
+    eo::rngPool.reserve(4);
+    if (eo::rngPool.size() < 4 || &eo::rngPool[0] != &eo::rng) {
+        cerr << "Pool not reserved as expected" << endl;
+        return 1;
+    }
+
+    eo::rngPool.reseed(42);
+    vector<uint32_t> s1 = draw(eo::rngPool[1], num);
+    vector<uint32_t> s2 = draw(eo::rngPool[2], num);
+
+    eo::rngPool.reseed(42);
+    if (draw(eo::rngPool[1], num) != s1 || draw(eo::rngPool[2], num) != s2) {
+        cerr << "Streams are not reproducible" << endl;
+        return 1;
+    }
+
+    if (s1 == s2) {
+        cerr << "Streams of different threads are identical" << endl;
+        return 1;
+    }
+
+#ifdef _OPENMP
+    eo::rngPool.reserve(omp_get_max_threads());
+    vector<eoRng*> used(omp_get_max_threads(), (eoRng*)0);
+#pragma omp parallel
+    {
+        used[omp_get_thread_num()] = &eo::threadRng();
+    }
+    for (size_t i = 0; i < used.size(); ++i)
+        for (size_t j = i+1; j < used.size(); ++j)
+            if (used[i] != 0 && used[i] == used[j]) {
+                cerr << "Threads " << i << " and " << j << " share a generator" << endl;
+                return 1;
+            }
+#endif // _OPENMP
+
+    return 0;
+}
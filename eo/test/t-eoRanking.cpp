@@ -0,0 +1,112 @@
+//-----------------------------------------------------------------------------
+// t-eoRanking.cpp
+//-----------------------------------------------------------------------------
+
+// Checks the worths of eoRanking against the ranking formula, with ties that
+// are ranked in the order of the population, checks that the worths are only
+// recomputed when a fitness changes, and times the ranking of a large population.
+//
+// Usage: t-eoRanking --popSize=100000
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <cmath>
+#include <ctime>
+#include <iostream>
+#include <vector>
+#include <eo>
+
+using namespace std;
+
+typedef EO<double> Indi;
+
+bool checkWorths(eoRanking<Indi>& _ranking, const eoPop<Indi>& _pop,
+                 const vector<unsigned>& _expectedRank, double _pressure, double _exponent)
+{
+    _ranking(_pop);
+    unsigned pSize = _pop.size();
+    for (unsigned i = 0; i < pSize; ++i)
+    {
+        unsigned r = _expectedRank[i];
+        double expected;
+        if (_exponent == 1.0)
+            expected = (2*_pressure-2)/(pSize*(pSize-1.0))*(pSize-r) + (2-_pressure)/pSize;
+        else
+            expected = (2*_pressure-2)/pSize*pow(double(pSize-r)/pSize, _exponent) + (2-_pressure)/pSize;
+        if (fabs(_ranking.value()[i] - expected) > 1e-12)
+        {
+            cerr << "Wrong worth for individual " << i << ": " << _ranking.value()[i]
+                 << " instead of " << expected << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    eoParser parser(argc, argv);
+    unsigned popSize = parser.createParam(unsigned(100000), "popSize", "Size of the timed population", 'P').value();
+    make_help(parser);
+
+    // fitnesses 3 1 3 2 5 : ranks 1 4 2 3 0, the first 3 comes before the second one
+    double fitnesses[] = { 3, 1, 3, 2, 5 };
+    unsigned ranks[] = { 1, 4, 2, 3, 0 };
+    eoPop<Indi> pop;
+    for (unsigned i = 0; i < 5; ++i)
+    {
+        Indi indi;
+        indi.fitness(fitnesses[i]);
+        pop.push_back(indi);
+    }
+    vector<unsigned> expectedRank(ranks, ranks + 5);
+
+    eoRanking<Indi> linear(1.5);
+    eoRanking<Indi> exponential(1.8, 2.0);
+    if (!checkWorths(linear, pop, expectedRank, 1.5, 1.0)
+        || !checkWorths(exponential, pop, expectedRank, 1.8, 2.0))
+        return 1;
+
+    // same fitnesses: the cached worths are kept, even if they were tampered with
+    linear.value()[0] = -1;
+    linear(pop);
+    if (linear.value()[0] != -1)
+    {
+        cerr << "Worths recomputed with unchanged fitnesses" << endl;
+        return 1;
+    }
+
+    // one new fitness: 3 1 3 6 5
+    pop[3].fitness(6);
+    unsigned newRanks[] = { 2, 4, 3, 0, 1 };
+    if (!checkWorths(linear, pop, vector<unsigned>(newRanks, newRanks + 5), 1.5, 1.0))
+        return 1;
+
+    // timing on a large population, with many ties
+    eoPop<Indi> bigPop;
+    bigPop.resize(popSize);
+    for (unsigned i = 0; i < popSize; ++i)
+        bigPop[i].fitness(double(eo::rng.random(popSize / 10 + 1)));
+
+    clock_t start = clock();
+    eoRanking<Indi> bigRanking;
+    bigRanking(bigPop);
+    double time = double(clock() - start) / CLOCKS_PER_SEC;
+
+    vector<unsigned> bigRank;
+    bigPop.sort(bigRank);
+    for (unsigned i = 1; i < popSize; ++i)
+        if (!(bigRanking.value()[bigRank[i]] < bigRanking.value()[bigRank[i-1]]))
+        {
+            cerr << "Worths are not decreasing with the rank" << endl;
+            return 1;
+        }
+
+    cout << "Ranking of " << popSize << " individuals: " << time << "s" << endl;
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,194 @@
+//-----------------------------------------------------------------------------
+// t-eoReplacementMoves.cpp
+//-----------------------------------------------------------------------------
+
+// Checks that the replacements keep the right individuals, without copying
+// any of them when they can be moved (C++11), and times a plus replacement
+// on large genomes.
+//
+// Usage: t-eoReplacementMoves --size=100000
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <ctime>
+#include <iostream>
+#include <set>
+#include <eo>
+#include <eoReduceMergeReduce.h>
+
+using namespace std;
+
+static unsigned long copies = 0;
+
+// all the genes of an individual are its fitness, which is unique in the population
+class Counted : public eoVector<double, double>
+{
+public:
+    Counted(unsigned _size = 0, double _value = 0) : eoVector<double, double>(_size, _value) {}
+
+    Counted(const Counted& _other) : eoVector<double, double>(_other) { ++copies; }
+
+    Counted& operator=(const Counted& _other)
+    {
+        eoVector<double, double>::operator=(_other);
+        ++copies;
+        return *this;
+    }
+
+#if __cplusplus >= 201103L
+    Counted(Counted&&) = default;
+    Counted& operator=(Counted&&) = default;
+#endif
+};
+
+double nextValue = 0;
+
+void fill(eoPop<Counted>& _pop, unsigned _popSize, unsigned _size)
+{
+    _pop.resize(_popSize);
+    for (unsigned i = 0; i < _popSize; ++i)
+    {
+        double value = rng.uniform() + (nextValue += 1);
+        _pop[i] = Counted(_size, value);
+        _pop[i].fitness(value);
+    }
+}
+
+// the population has the right size and holds distinct, whole individuals
+bool check(const eoPop<Counted>& _pop, unsigned _popSize, unsigned _size, const string& _name)
+{
+    set<double> values;
+    for (unsigned i = 0; i < _pop.size(); ++i)
+    {
+        const Counted& eo = _pop[i];
+        if (eo.size() != _size || eo.fitness() != eo[0] || eo[_size - 1] != eo[0] || !values.insert(eo[0]).second)
+        {
+            cerr << _name << ": individual " << i << " damaged or duplicated" << endl;
+            return false;
+        }
+    }
+    if (_pop.size() != _popSize)
+    {
+        cerr << _name << ": wrong population size " << _pop.size() << endl;
+        return false;
+    }
+    return true;
+}
+
+// the best _popSize of the given fitnesses
+vector<double> best(vector<double> _values, unsigned _popSize)
+{
+    sort(_values.begin(), _values.end(), greater<double>());
+    _values.resize(_popSize);
+    return _values;
+}
+
+vector<double> fitnesses(const eoPop<Counted>& _pop)
+{
+    vector<double> values;
+    for (unsigned i = 0; i < _pop.size(); ++i)
+        values.push_back(_pop[i].fitness());
+    sort(values.begin(), values.end(), greater<double>());
+    return values;
+}
+
+bool test(eoReplacement<Counted>& _replace, const string& _name, unsigned _offSize, int _expected)
+{
+    const unsigned popSize = 20, size = 10;
+
+    eoPop<Counted> parents, offspring;
+    for (unsigned gen = 0; gen < 3; ++gen)
+    {
+        fill(parents, popSize, size);
+        fill(offspring, _offSize, size);
+
+        vector<double> all = fitnesses(parents);
+        vector<double> off = fitnesses(offspring);
+        if (_expected == 1)      // plus: the best of both
+            all.insert(all.end(), off.begin(), off.end());
+        else if (_expected == 2) // comma: the best offspring
+            all = off;
+
+        copies = 0;
+        _replace(parents, offspring);
+
+        if (!check(parents, popSize, size, _name))
+            return false;
+        // the moved-from individuals, with their stale fitnesses, are not left in the offspring
+        if (!offspring.empty())
+        {
+            cerr << _name << ": " << offspring.size() << " individuals left in the offspring" << endl;
+            return false;
+        }
+        if (_expected && fitnesses(parents) != best(all, popSize))
+        {
+            cerr << _name << ": wrong survivors" << endl;
+            return false;
+        }
+#if __cplusplus >= 201103L
+        if (copies != 0)
+        {
+            cerr << _name << ": " << copies << " individuals copied" << endl;
+            return false;
+        }
+#endif
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    eoParser parser(argc, argv);
+    unsigned size = parser.createParam(unsigned(100000), "size", "Size of the genomes for the timing", 's').value();
+    make_help(parser);
+
+    eoPlusReplacement<Counted> plus;
+    eoCommaReplacement<Counted> comma;
+    eoEPReplacement<Counted> ep(6);
+    eoSSGAWorseReplacement<Counted> ssgaWorse;
+    eoSSGAStochTournamentReplacement<Counted> ssgaStoch(0.8);
+    eoDeterministicSaDReplacement<Counted> sad(0.2, 0.1, 0.1, 0.1);
+    eoTruncate<Counted> truncate;
+    eoElitism<Counted> elitism(0.5);
+    eoMergeReduce<Counted> elitist(elitism, truncate);
+    eoLinearTruncate<Counted> linearTruncate;
+    eoEPReduce<Counted> epReduce(4);
+    eoReduceMergeReduce<Counted> strong(eoHowMany(0.1), true, eoHowMany(0.5), truncate,
+                                        eoHowMany(0.8), epReduce, linearTruncate);
+    eoReduceMergeReduce<Counted> weak(eoHowMany(0.1), false, eoHowMany(0.5), truncate,
+                                      eoHowMany(0.8), epReduce, truncate);
+
+    if (!test(plus, "eoPlusReplacement", 30, 1) ||
+        !test(comma, "eoCommaReplacement", 30, 2) ||
+        !test(ep, "eoEPReplacement", 30, 0) ||
+        !test(elitist, "eoMergeReduce (eoElitism)", 30, 0) ||
+        !test(ssgaWorse, "eoSSGAWorseReplacement", 5, 0) ||
+        !test(ssgaStoch, "eoSSGAStochTournamentReplacement", 5, 0) ||
+        !test(sad, "eoDeterministicSaDReplacement", 30, 0) ||
+        !test(strong, "eoReduceMergeReduce (strong elitism)", 30, 0) ||
+        !test(weak, "eoReduceMergeReduce (weak elitism)", 30, 0))
+        return 1;
+
+    // timing of a (mu+lambda) replacement on large genomes
+    eoPop<Counted> parents, offspring;
+    clock_t time = 0;
+    unsigned long totalCopies = 0;
+    for (unsigned gen = 0; gen < 20; ++gen)
+    {
+        fill(parents, 20, size);
+        fill(offspring, 40, size);
+        copies = 0;
+        clock_t start = clock();
+        plus(parents, offspring);
+        time += clock() - start;
+        totalCopies += copies;
+    }
+    cout << "eoPlusReplacement of 20+40 genomes of " << size << " genes: " << double(time) / CLOCKS_PER_SEC / 20
+         << "s per generation, " << totalCopies / 20 << " copies" << endl;
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,158 @@
+//-----------------------------------------------------------------------------
+// t-eoStatSweep.cpp
+//-----------------------------------------------------------------------------
+
+// Checks that the stats computed by a checkpoint in a single sweep of the
+// population have the same values as when they are computed naively, in
+// sequence and in parallel, for maximized and minimized fitnesses, and
+// times a checkpoint holding the usual stats.
+//
+// Usage: t-eoStatSweep --size=1000000
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <cmath>
+#include <ctime>
+#include <iostream>
+#include <eo>
+#include <es.h>
+
+using namespace std;
+
+bool close(double _a, double _b)
+{
+    return fabs(_a - _b) <= 1e-9 * (1.0 + fabs(_b));
+}
+
+bool check(bool _ok, const string& _what)
+{
+    if (!_ok)
+        cerr << "Wrong " << _what << endl;
+    return _ok;
+}
+
+template <class EOT>
+void fill(eoPop<EOT>& _pop, unsigned _size)
+{
+    _pop.resize(_size);
+    for (unsigned i = 0; i < _size; ++i)
+    {
+        _pop[i].resize(1, 0.0);
+        _pop[i].fitness(rng.random(_size / 2) - 0.5 * rng.uniform()); // with a few ties
+    }
+}
+
+template <class EOT>
+bool test(unsigned _size)
+{
+    eoPop<EOT> pop;
+    fill(pop, _size);
+
+    eoGenContinue<EOT> cont(10);
+    eoCheckPoint<EOT> checkpoint(cont);
+    eoAverageStat<EOT> average;
+    eoSecondMomentStats<EOT> moments;
+    eoStdevStat<EOT> stdev;
+    eoBestFitnessStat<EOT> best;
+    eoBestIndividualStat<EOT> bestIndividual;
+    eoNthElementFitnessStat<EOT> third(2);
+    eoInterquartileRangeStat<EOT> iqr(0.0);
+    checkpoint.add(average);
+    checkpoint.add(moments);
+    checkpoint.add(stdev);
+    checkpoint.add(best);
+    checkpoint.add(bestIndividual);
+    checkpoint.add(third);
+    checkpoint.add(iqr);
+
+    checkpoint(pop);
+
+    // naive values
+    double sum = 0, squares = 0;
+    for (unsigned i = 0; i < pop.size(); ++i)
+    {
+        sum += pop[i].fitness();
+        squares += pop[i].fitness() * pop[i].fitness();
+    }
+    double n = pop.size();
+    double sd = sqrt((squares - sum * sum / n) / (n - 1.0));
+
+    vector<const EOT*> sorted;
+    pop.sort(sorted);
+    double Q1 = sorted[n - 1 - unsigned(0.25 * n)]->fitness();
+    double Q3 = sorted[n - 1 - unsigned(0.75 * n)]->fitness();
+
+    bool ok = check(close(average.value(), sum / n), "average")
+        && check(close(moments.value().first, sum / n) && close(moments.value().second, sd), "second moments")
+        && check(close(stdev.value(), sd), "stdev")
+        && check(best.value() == pop.best_element().fitness(), "best fitness")
+        && check(bestIndividual.value().fitness() == pop.best_element().fitness(), "best individual")
+        && check(third.value() == sorted[2]->fitness(), "third fitness")
+        && check(close(iqr.value(), fabs(Q3 - Q1)), "interquartile range");
+
+    // the stats called on their own agree
+    eoAverageStat<EOT> alone;
+    alone(pop);
+    eoNthElementFitnessStat<EOT> thirdSorted(2);
+    thirdSorted(sorted);
+    return ok && check(alone.value() == average.value(), "average on its own")
+        && check(thirdSorted.value() == third.value(), "nth element on a sorted population");
+}
+
+int main(int argc, char* argv[])
+{
+    eoParser parser(argc, argv);
+    unsigned size = parser.createParam(unsigned(1000000), "size", "Size of the population for the timing", 's').value();
+    make_help(parser);
+
+    if (!test<eoReal<double> >(1001) || !test<eoReal<eoMinimizingFitness> >(1001))
+        return 1;
+
+    // a population of one
+    eoPop<eoReal<double> > single;
+    fill(single, 1);
+    eoBestFitnessStat<eoReal<double> > best;
+    eoInterquartileRangeStat<eoReal<double> > iqr(0.0);
+    best(single);
+    iqr(single);
+    if (best.value() != single[0].fitness() || iqr.value() != 0)
+        return 1;
+
+    // timing of a checkpoint with the usual stats
+    typedef eoReal<eoMinimizingFitness> EOT;
+    eoPop<EOT> pop;
+    fill(pop, size);
+
+    eoGenContinue<EOT> cont(10);
+    eoCheckPoint<EOT> checkpoint(cont);
+    eoAverageStat<EOT> average;
+    eoSecondMomentStats<EOT> moments;
+    eoBestFitnessStat<EOT> bestFitness;
+    eoNthElementFitnessStat<EOT> median(size / 2);
+    eoInterquartileRangeStat<EOT> range(0.0);
+    checkpoint.add(average);
+    checkpoint.add(moments);
+    checkpoint.add(bestFitness);
+    checkpoint.add(median);
+    checkpoint.add(range);
+
+    clock_t start = clock();
+    for (unsigned gen = 0; gen < 5; ++gen)
+        checkpoint(pop);
+    cout << "checkpoint with 5 stats on " << size << " individuals: "
+         << double(clock() - start) / CLOCKS_PER_SEC / 5 << "s per generation" << endl;
+
+    // the same stats, computed by several threads
+    char* args[] = { argv[0], (char*) "--parallelize-loop=1", (char*) "--parallelize-dynamic=0" };
+    eoParser parallelParser(3, args);
+    make_parallel(parallelParser);
+
+    if (!test<eoReal<double> >(1001) || !test<eoReal<eoMinimizingFitness> >(1001))
+        return 1;
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------